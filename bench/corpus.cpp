@@ -0,0 +1,372 @@
+#include "corpus.h"
+
+#include <charconv>
+
+namespace {
+
+constexpr std::string_view words[] = {
+    "value", "count", "index", "buffer", "node",   "result", "item",  "total", "name",
+    "left",  "right", "state", "offset", "length", "cursor", "token", "scope", "entry",
+    "size",  "limit", "delta", "flag",   "sum",    "data",   "key",   "width", "height"};
+constexpr std::string_view unicode_words[] = {"größe", "π", "naïve", "δx", "über", "名前"};
+constexpr std::string_view types[] = {"i8",  "i16", "i32", "i64",  "i128", "u8",  "u16",
+                                      "u32", "u64", "u128", "f64", "f128", "ch",  "bool"};
+constexpr std::string_view operators[] = {"+",  "-",  "*",  "/", "%",  "==", "!=", "<",
+                                          "<=", ">",  ">=", "&&", "||", "<<", ">>", "&"};
+constexpr std::string_view assignments[] = {"=", "+=", "-=", "*=", "/=", "%="};
+constexpr std::string_view string_parts[] = {
+    "Hello, World!", "value is {}", "line\\n", "tab\\tseparated", "quote \\\"x\\\"",
+    "日本語のテキスト", "Ünïcödé", "emoji 😀", "path\\\\to\\\\file", "{} of {}"};
+constexpr std::string_view comments[] = {
+    "TODO: handle the overflow case", "Fast path for the common case",
+    "Équivalent à une boucle", "keep in sync with the table above",
+    "see the docs for details", "never negative here"};
+
+} // namespace
+
+void Corpus::indent(std::string &out) { out.append(4 * depth, ' '); }
+
+void Corpus::identifier(std::string &out) {
+    if (chance(3)) {
+        out += unicode_words[pick(std::size(unicode_words))];
+        return;
+    }
+    out += words[pick(std::size(words))];
+    if (chance(40)) {
+        out += '_';
+        out += words[pick(std::size(words))];
+    }
+    if (chance(20)) out += std::to_string(pick(100));
+}
+
+void Corpus::type(std::string &out) {
+    if (chance(10)) {
+        out += "[ch, ";
+        out += chance(50) ? "~" : std::to_string(1 + pick(64));
+        out += ']';
+    } else {
+        if (chance(10)) out += '&';
+        out += types[pick(std::size(types))];
+    }
+}
+
+void Corpus::literal(std::string &out) {
+    char digits[64];
+    switch (pick(10)) {
+        case 0: {
+            out += "0x";
+            auto res = std::to_chars(digits, digits + sizeof(digits), rng() >> pick(64), 16);
+            out.append(digits, res.ptr);
+            break;
+        }
+        case 1: {
+            out += "0b";
+            auto res = std::to_chars(digits, digits + sizeof(digits), pick(1 << 16), 2);
+            out.append(digits, res.ptr);
+            break;
+        }
+        case 2: {
+            out += "0o";
+            auto res = std::to_chars(digits, digits + sizeof(digits), pick(1 << 20), 8);
+            out.append(digits, res.ptr);
+            break;
+        }
+        case 3:
+            out += std::to_string(pick(100000));
+            out += '.';
+            out += std::to_string(pick(1000));
+            break;
+        case 4:
+            out += '"';
+            out += string_parts[pick(std::size(string_parts))];
+            out += '"';
+            break;
+        case 5:
+            if (chance(20)) {
+                out += "'\\n'";
+            } else if (chance(10)) {
+                out += "'é'";
+            } else {
+                out += '\'';
+                out += static_cast<char>('a' + pick(26));
+                out += '\'';
+            }
+            break;
+        case 6:
+            out += chance(50) ? "true" : "false";
+            break;
+        default:
+            out += std::to_string(pick(chance(80) ? 100 : 1000000000));
+            break;
+    }
+}
+
+void Corpus::expression(std::string &out, uint32_t budget) {
+    if (budget == 0 || chance(35)) {
+        if (chance(50)) {
+            literal(out);
+        } else {
+            identifier(out);
+            if (chance(15)) {
+                out += '.';
+                identifier(out);
+            }
+        }
+        return;
+    }
+    switch (pick(4)) {
+        case 0: // call
+            if (chance(30)) {
+                identifier(out);
+                out += "::";
+            }
+            identifier(out);
+            out += '(';
+            for (uint64_t i = 0, n = pick(4); i < n; i++) {
+                if (i) out += ", ";
+                expression(out, budget - 1);
+            }
+            out += ')';
+            break;
+        case 1: // parenthesized
+            out += '(';
+            expression(out, budget - 1);
+            out += ')';
+            break;
+        default: // binary
+            expression(out, budget - 1);
+            out += ' ';
+            out += operators[pick(std::size(operators))];
+            out += ' ';
+            expression(out, budget - 1);
+            break;
+    }
+}
+
+void Corpus::comment(std::string &out) {
+    indent(out);
+    if (chance(75)) {
+        out += "// ";
+        out += comments[pick(std::size(comments))];
+        out += '\n';
+        return;
+    }
+    out += "/*\n";
+    for (uint64_t i = 0, n = 1 + pick(4); i < n; i++) {
+        indent(out);
+        out += " * ";
+        out += comments[pick(std::size(comments))];
+        out += '\n';
+    }
+    indent(out);
+    out += " */\n";
+}
+
+void Corpus::statement(std::string &out) {
+    if (chance(8)) comment(out);
+    indent(out);
+
+    uint64_t kind = depth > 4 ? pick(3) : pick(10);
+    switch (kind) {
+        case 0: // let
+            out += chance(20) ? "const " : "let ";
+            identifier(out);
+            out += ": ";
+            type(out);
+            out += " = ";
+            expression(out);
+            out += ';';
+            break;
+        case 1: // assignment
+            identifier(out);
+            out += ' ';
+            out += assignments[pick(std::size(assignments))];
+            out += ' ';
+            expression(out);
+            out += ';';
+            break;
+        case 2: // call
+            out += chance(30) ? "println" : "update";
+            out += "(\"";
+            out += string_parts[pick(std::size(string_parts))];
+            out += "\", ";
+            expression(out, 2);
+            out += ");";
+            break;
+        case 3:
+        case 4: // if / elif / else
+            out += "if ";
+            expression(out, 2);
+            out += ' ';
+            block(out);
+            if (chance(30)) {
+                out += " elif ";
+                expression(out, 2);
+                out += ' ';
+                block(out);
+            }
+            if (chance(50)) {
+                out += " else ";
+                block(out);
+            }
+            break;
+        case 5: { // match
+            out += "match ";
+            identifier(out);
+            out += " {\n";
+            depth++;
+            for (uint64_t i = 0, n = 2 + pick(5); i < n; i++) {
+                indent(out);
+                out += "is ";
+                if (chance(30)) out += chance(50) ? ">= " : "< ";
+                literal(out);
+                out += ": ";
+                expression(out, 2);
+                out += ";\n";
+            }
+            indent(out);
+            out += "fallback: ";
+            expression(out, 1);
+            out += ";\n";
+            depth--;
+            indent(out);
+            out += '}';
+            break;
+        }
+        case 6: // for
+            out += "for ";
+            identifier(out);
+            out += " in rng::range(0, ";
+            literal(out);
+            out += ") ";
+            block(out);
+            break;
+        case 7: // while
+            out += "while ";
+            expression(out, 2);
+            out += ' ';
+            block(out);
+            break;
+        case 8: // loop
+            out += "loop ";
+            block(out);
+            break;
+        default: // return
+            out += chance(50) ? "rtn " : "brk ";
+            expression(out, 2);
+            out += ';';
+            break;
+    }
+    out += '\n';
+}
+
+void Corpus::block(std::string &out) {
+    out += "{\n";
+    depth++;
+    for (uint64_t i = 0, n = 1 + pick(depth > 2 ? 3 : 6); i < n; i++) statement(out);
+    depth--;
+    indent(out);
+    out += '}';
+}
+
+void Corpus::obj(std::string &out) {
+    out += "obj ";
+    identifier(out);
+    out += " {\n";
+    depth++;
+    for (uint64_t i = 0, n = 1 + pick(6); i < n; i++) {
+        indent(out);
+        out += chance(20) ? "const " : "let ";
+        identifier(out);
+        out += ": ";
+        type(out);
+        out += ";\n";
+    }
+    if (chance(50)) {
+        out += '\n';
+        indent(out);
+        func(out);
+    }
+    depth--;
+    out += "}\n";
+}
+
+void Corpus::func(std::string &out) {
+    out += "func ";
+    identifier(out);
+    out += '(';
+    for (uint64_t i = 0, n = pick(4); i < n; i++) {
+        if (i) out += ", ";
+        identifier(out);
+        out += ": ";
+        type(out);
+    }
+    out += ')';
+    if (chance(70)) {
+        out += " -> ";
+        type(out);
+    }
+    out += ' ';
+    block(out);
+    out += '\n';
+}
+
+void Corpus::item(std::string &out) {
+    switch (pick(10)) {
+        case 0:
+            out += "use dove::{std!, ";
+            identifier(out);
+            out += "};\n";
+            break;
+        case 1:
+            comment(out);
+            break;
+        case 2:
+        case 3:
+            obj(out);
+            break;
+        default:
+            func(out);
+            break;
+    }
+    out += '\n';
+}
+
+std::string Corpus::generate(size_t bytes) {
+    std::string out;
+    out.reserve(bytes + 4096);
+    while (out.size() < bytes) item(out);
+    return out;
+}
+
+bool Corpus::write(std::FILE *file, size_t bytes) {
+    std::string chunk;
+    size_t written = 0;
+    while (written < bytes) {
+        chunk.clear();
+        while (chunk.size() < (1 << 20) && written + chunk.size() < bytes) item(chunk);
+        if (std::fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size()) return false;
+        written += chunk.size();
+    }
+    return std::fflush(file) == 0;
+}
+
+std::optional<size_t> parse_size(std::string_view str) {
+    size_t value = 0;
+    auto res = std::from_chars(str.data(), str.data() + str.length(), value);
+    if (res.ec != std::errc{} || res.ptr == str.data()) return std::nullopt;
+
+    std::string_view suffix(res.ptr, str.data() + str.length());
+    if (suffix.empty()) return value;
+    if (suffix.length() != 1) return std::nullopt;
+    switch (suffix[0] | 0x20) {
+        case 'k':
+            return value << 10;
+        case 'm':
+            return value << 20;
+        case 'g':
+            return value << 30;
+        default:
+            return std::nullopt;
+    }
+}
\ No newline at end of file
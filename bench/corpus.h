@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+/**
+ * Corpus
+ *
+ * Seeded generator of synthetic but realistic Dove source: `use` lines, objs with fields,
+ * funcs with lets, ifs, matches, loops and calls, literals in every radix, strings with
+ * escapes and Unicode, Unicode identifiers, and line and block comments. The same seed
+ * gives the same bytes on every host (no std distributions, whose output is unspecified).
+ */
+class Corpus {
+private:
+    std::mt19937_64 rng;
+    uint32_t depth = 0;
+
+    uint64_t pick(uint64_t n) { return rng() % n; }
+    bool chance(uint32_t percent) { return pick(100) < percent; }
+
+    void indent(std::string &out);
+    void identifier(std::string &out);
+    void type(std::string &out);
+    void literal(std::string &out);
+    void expression(std::string &out, uint32_t budget = 3);
+    void comment(std::string &out);
+    void statement(std::string &out);
+    void block(std::string &out);
+    void obj(std::string &out);
+    void func(std::string &out);
+
+public:
+    explicit Corpus(uint64_t seed) : rng(seed) {}
+
+    // Append one top-level item
+    void item(std::string &out);
+    // At least `bytes` bytes of whole items
+    std::string generate(size_t bytes);
+    // Same output as generate(), written in pieces so the corpus never has to fit in memory
+    bool write(std::FILE *file, size_t bytes);
+};
+
+// "64", "512K", "64M", "2G"; std::nullopt if malformed
+std::optional<size_t> parse_size(std::string_view str);
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "corpus.h"
+
+#include <charconv>
+#include <cstdio>
+#include <print>
+#include <string_view>
+
+// gen_corpus <size> [seed] > corpus.dv
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        std::println(stderr, "usage: gen_corpus <size>[K|M|G] [seed]");
+        return 2;
+    }
+
+    auto size = parse_size(argv[1]);
+    uint64_t seed = 1;
+    if (argc == 3) {
+        std::string_view str(argv[2]);
+        auto res = std::from_chars(str.data(), str.data() + str.length(), seed);
+        if (res.ec != std::errc{} || res.ptr != str.data() + str.length()) size.reset();
+    }
+    if (!size) {
+        std::println(stderr, "gen_corpus: invalid size or seed");
+        return 2;
+    }
+
+    Corpus corpus(seed);
+    if (!corpus.write(stdout, *size)) {
+        std::println(stderr, "gen_corpus: write failed");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
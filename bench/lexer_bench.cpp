@@ -0,0 +1,365 @@
+#include "corpus.h"
+#include "dove/dove.h"
+#include "dove/utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <print>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Every allocation of the process goes through here, so each mode can report its own
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+void *counted_alloc(size_t size, size_t align) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    void *ptr = align > alignof(std::max_align_t)
+                    ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                    : std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+} // namespace
+
+void *operator new(size_t size) { return counted_alloc(size, 0); }
+void *operator new[](size_t size) { return counted_alloc(size, 0); }
+void *operator new(size_t size, std::align_val_t align) {
+    return counted_alloc(size, static_cast<size_t>(align));
+}
+void *operator new[](size_t size, std::align_val_t align) {
+    return counted_alloc(size, static_cast<size_t>(align));
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Whether the JSON ends with the metrics of an instrumented run
+#ifdef DOVE_METRICS
+constexpr bool with_metrics = true;
+#else
+constexpr bool with_metrics = false;
+#endif
+
+struct Options {
+    size_t size = 64 << 20;
+    uint64_t seed = 1;
+    std::string file;
+    std::string trace; // Chrome trace of one parallel run (METRICS=1 builds)
+    uint32_t repeat = 5;
+    uint32_t scaling = 0; // run the parallel modes again on 1..scaling threads
+    std::vector<std::string> modes = {"lexer",    "tokens",   "stream",     "stream_chunked",
+                                      "pipeline", "parallel", "cache_warm", "parser",
+                                      "parallel_parser"};
+};
+
+struct Result {
+    std::string mode;
+    size_t threads = 0; // pool size of a scaling run
+    double seconds = 0; // median of the runs
+    size_t tokens = 0;
+    uint64_t allocations = 0; // per run
+    uint64_t allocated_bytes = 0;
+    long peak_rss_kb = 0; // of the whole process while the mode ran, corpus included
+};
+
+// Reset the high-water mark so VmHWM covers only what runs next (Linux 4.0+)
+void reset_peak_rss() { std::ofstream("/proc/self/clear_refs") << "5"; }
+
+long peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmHWM:")) return std::strtol(line.c_str() + 6, nullptr, 10);
+    }
+    return -1;
+}
+
+// One run of a mode over `source`; returns the number of tokens
+using Runner = std::function<size_t(std::string_view source)>;
+
+size_t drain(Dove::TokenStream &stream) {
+    size_t count = 0;
+    for ([[maybe_unused]] const Dove::Token &token : stream) count++;
+    if (stream.get_error()) std::println(stderr, "{}", stream.get_error()->format());
+    return count;
+}
+
+Result measure(const std::string &mode, const Runner &run, std::string_view source,
+               uint32_t repeat) {
+    run(source); // warm-up: page in the source, fill caches
+
+    reset_peak_rss();
+    std::vector<double> seconds;
+    Result result{.mode = mode};
+    for (uint32_t i = 0; i < repeat; i++) {
+        uint64_t allocs = allocations.load();
+        uint64_t bytes = allocated_bytes.load();
+        auto start = std::chrono::steady_clock::now();
+        result.tokens = run(source);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        seconds.push_back(std::chrono::duration<double>(elapsed).count());
+        result.allocations = allocations.load() - allocs;
+        result.allocated_bytes = allocated_bytes.load() - bytes;
+    }
+    std::sort(seconds.begin(), seconds.end());
+    result.seconds = seconds[seconds.size() / 2];
+    result.peak_rss_kb = peak_rss_kb();
+    return result;
+}
+
+bool parse_options(int argc, char **argv, Options *options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view flag(argv[i]);
+        std::string_view value(argv[i + 1]);
+        if (flag == "--size") {
+            auto size = parse_size(value);
+            if (!size) return false;
+            options->size = *size;
+        } else if (flag == "--seed" || flag == "--repeat" || flag == "--scaling") {
+            uint64_t number = 0;
+            auto res = std::from_chars(value.data(), value.data() + value.length(), number);
+            if (res.ec != std::errc{} || res.ptr != value.data() + value.length()) return false;
+            if (flag == "--seed") {
+                options->seed = number;
+            } else if (flag == "--scaling") {
+                options->scaling = static_cast<uint32_t>(number);
+            } else {
+                options->repeat = static_cast<uint32_t>(std::max<uint64_t>(number, 1));
+            }
+        } else if (flag == "--file") {
+            options->file = value;
+        } else if (flag == "--trace") {
+            options->trace = value;
+        } else if (flag == "--modes") {
+            options->modes.clear();
+            for (auto part : std::views::split(value, ',')) {
+                options->modes.emplace_back(part.begin(), part.end());
+            }
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1;
+}
+
+} // namespace
+
+// lexer_bench [--size 64M] [--seed 1] [--file path] [--repeat 5] [--modes lexer,stream,...]
+//             [--trace path] [--scaling n]
+//
+// --scaling n runs the selected parallel modes again on pools of 1..n threads, for scaling
+// curves on multi-core hosts.
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, &options)) {
+        std::println(stderr, "usage: lexer_bench [--size <n>[K|M|G]] [--seed <n>] "
+                             "[--file <path>] [--repeat <n>] [--modes <a,b,...>] "
+                             "[--trace <path>] [--scaling <n>]");
+        return 2;
+    }
+
+    Dove::SourceManager sources;
+    std::string generated;
+    std::string_view source;
+    if (!options.file.empty()) {
+        auto id = sources.load(options.file);
+        if (!id) {
+            std::println(stderr, "lexer_bench: cannot read {}", options.file);
+            return 1;
+        }
+        source = sources.get_text(*id);
+    } else {
+        generated = Corpus(options.seed).generate(options.size);
+        source = generated;
+    }
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Dove::ThreadPool pool(threads);
+    std::string cache_dir = std::format("/tmp/dove-bench-{}", getpid());
+    Dove::TokenCache cache(cache_dir);
+
+    // The parallel modes on a given pool, shared by the mode table and the scaling runs
+    auto parallel = [](Dove::ThreadPool &on) -> Runner {
+        return [&on](std::string_view src) {
+            Dove::Lexer lexer = Dove::Lexer::parallel(src, on);
+            auto res = lexer.get_token_buffer();
+            return res ? res.value()->size() : 0;
+        };
+    };
+    auto parallel_parser = [](Dove::ThreadPool &on) -> Runner {
+        return [&on](std::string_view src) {
+            // Both stages on the pool
+            Dove::Lexer lexer = Dove::Lexer::parallel(src, on);
+            auto res = lexer.get_token_buffer();
+            if (!res) return size_t{0};
+            Dove::Parser parser = Dove::Parser::parallel(*res.value(), on);
+            if (!parser.get_diagnostics().empty()) {
+                std::println(stderr, "{}", parser.get_diagnostics()[0].format());
+            }
+            return res.value()->size();
+        };
+    };
+    const std::pair<std::string, Runner (*)(Dove::ThreadPool &)> scaling_modes[] = {
+        {"parallel", parallel},
+        {"parallel_parser", parallel_parser},
+    };
+
+    const std::vector<std::pair<std::string, Runner>> runners = {
+        {"lexer",
+         [](std::string_view src) {
+             Dove::Lexer lexer(src);
+             auto res = lexer.get_token_buffer();
+             return res ? res.value()->size() : 0;
+         }},
+        {"tokens",
+         [](std::string_view src) {
+             Dove::Lexer lexer(src);
+             auto res = lexer.get_tokens();
+             return res ? res.value()->size() : 0;
+         }},
+        {"stream",
+         [](std::string_view src) {
+             Dove::TokenStream stream = Dove::Lexer::stream(src);
+             return drain(stream);
+         }},
+        {"stream_chunked",
+         [](std::string_view src) {
+             size_t pos = 0;
+             Dove::TokenStream stream([&](char *buffer, size_t capacity) {
+                 size_t n = std::min(capacity, src.size() - pos);
+                 std::memcpy(buffer, src.data() + pos, n);
+                 pos += n;
+                 return n;
+             });
+             return drain(stream);
+         }},
+        {"pipeline",
+         [](std::string_view src) {
+             // Lexed on another thread while this one takes the blocks
+             Dove::TokenPipeline pipeline(src);
+             size_t count = 0;
+             while (const Dove::TokenBlock *block = pipeline.next_block()) {
+                 for ([[maybe_unused]] const Dove::Token &token : block->get_tokens()) count++;
+             }
+             return count;
+         }},
+        {"parallel", parallel(pool)},
+        {"cache_warm",
+         [&](std::string_view src) {
+             // The warm-up run stores the entry, so the timed runs only replay it
+             Dove::TokenStream stream = Dove::Lexer::stream(src, cache);
+             return drain(stream);
+         }},
+        {"parser",
+         [](std::string_view src) {
+             // Lexing and parsing, the front end up to the Ast
+             Dove::Lexer lexer(src);
+             auto res = lexer.get_token_buffer();
+             if (!res) return size_t{0};
+             Dove::Parser parser(*res.value());
+             if (!parser.get_diagnostics().empty()) {
+                 std::println(stderr, "{}", parser.get_diagnostics()[0].format());
+             }
+             return res.value()->size();
+         }},
+        {"parallel_parser", parallel_parser(pool)},
+    };
+
+    std::vector<Result> results;
+    for (const std::string &mode : options.modes) {
+        auto it = std::find_if(runners.begin(), runners.end(),
+                               [&](const auto &runner) { return runner.first == mode; });
+        if (it == runners.end()) {
+            std::println(stderr, "lexer_bench: unknown mode {}", mode);
+            return 2;
+        }
+        results.push_back(measure(mode, it->second, source, options.repeat));
+    }
+
+    std::vector<Result> scaling;
+    for (const auto &[mode, make_runner] : scaling_modes) {
+        if (std::find(options.modes.begin(), options.modes.end(), mode) == options.modes.end()) {
+            continue;
+        }
+        for (unsigned count = 1; count <= options.scaling; count++) {
+            Dove::ThreadPool scaled(count);
+            scaling.push_back(measure(mode, make_runner(scaled), source, options.repeat));
+            scaling.back().threads = count;
+        }
+    }
+    std::system(std::format("rm -rf {}", cache_dir).c_str());
+
+#ifdef DOVE_METRICS
+    // Instrumented runs are slower, so the metrics come from an extra run outside the timings
+    Dove::Lexer instrumented = Dove::Lexer::parallel(source, pool);
+    const Dove::Metrics &metrics = instrumented.get_metrics();
+    if (!options.trace.empty()) {
+        const Dove::Metrics *phases[] = {&metrics};
+        std::ofstream(options.trace) << Dove::Metrics::to_chrome_trace(phases);
+    }
+#else
+    if (!options.trace.empty()) {
+        std::println(stderr, "lexer_bench: built without METRICS=1, no trace written");
+    }
+#endif
+
+    std::println("{{");
+    std::println("  \"corpus\": {{\"bytes\": {}, \"seed\": {}, \"file\": \"{}\"}},", source.size(),
+                 options.file.empty() ? options.seed : 0, options.file);
+    std::println("  \"threads\": {},", threads);
+    std::println("  \"repeat\": {},", options.repeat);
+    std::println("  \"modes\": [");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        std::println("    {{\"mode\": \"{}\", \"seconds\": {:.6f}, \"mb_per_s\": {:.1f}, "
+                     "\"tokens\": {}, \"tokens_per_s\": {:.0f}, \"ns_per_token\": {:.2f}, "
+                     "\"allocations\": {}, \"allocated_bytes\": {}, \"peak_rss_kb\": {}}}{}",
+                     r.mode, r.seconds, source.size() / r.seconds / 1e6, r.tokens,
+                     r.tokens / r.seconds, r.seconds * 1e9 / std::max<size_t>(r.tokens, 1),
+                     r.allocations, r.allocated_bytes, r.peak_rss_kb,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::println("  ]{}", !scaling.empty() || with_metrics ? "," : "");
+    if (!scaling.empty()) {
+        // Speedup against the 1-thread run of the same mode
+        std::println("  \"scaling\": [");
+        double base = 0;
+        for (size_t i = 0; i < scaling.size(); i++) {
+            const Result &r = scaling[i];
+            if (r.threads == 1) base = r.seconds;
+            std::println("    {{\"mode\": \"{}\", \"threads\": {}, \"seconds\": {:.6f}, "
+                         "\"mb_per_s\": {:.1f}, \"speedup\": {:.2f}}}{}",
+                         r.mode, r.threads, r.seconds, source.size() / r.seconds / 1e6,
+                         base / r.seconds, i + 1 < scaling.size() ? "," : "");
+        }
+        std::println("  ]{}", with_metrics ? "," : "");
+    }
+#ifdef DOVE_METRICS
+    std::println("  \"metrics\": {}", metrics.to_json());
+#endif
+    std::println("}}");
+    return 0;
+}
\ No newline at end of file
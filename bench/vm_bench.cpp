@@ -0,0 +1,151 @@
+#include "dove/dove.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    uint64_t iterations = 10'000'000;
+    uint32_t repeat = 5;
+};
+
+// Small numeric programs, with `$N` standing for the iteration count
+struct Program {
+    const char *name;
+    const char *source;
+};
+
+const Program programs[] = {
+    // The README's Counter, without printing
+    {"counter", "obj Counter {\n"
+                "  let value: u8;\n"
+                "  const max: u8 = 100;\n"
+                "  const min: u8 = 0;\n"
+                "  func increment() -> bool {\n"
+                "    if value < max { value += 1; true } else { false }\n"
+                "  }\n"
+                "  func decrement() -> bool {\n"
+                "    if value > min { value -= 1; true } else { false }\n"
+                "  }\n"
+                "}\n"
+                "func main() -> u8 {\n"
+                "  let counter: Counter = { value = 0 };\n"
+                "  for _ in rng::range(0, $N) {\n"
+                "    const action: bool = rand::rand_bool();\n"
+                "    match action {\n"
+                "      is true: counter.increment();\n"
+                "      is false: counter.decrement();\n"
+                "    }\n"
+                "  }\n"
+                "  counter.value\n"
+                "}\n"},
+    {"sum", "func main() -> u64 {\n"
+            "  let total: u64 = 0;\n"
+            "  let i: u64 = 0;\n"
+            "  while i < $N { total += i * i % 7; i += 1; }\n"
+            "  total\n"
+            "}\n"},
+    // The same loop counted and through the iterator protocol
+    {"range", "func main() -> u64 {\n"
+              "  let total: u64 = 0;\n"
+              "  let n: u64 = $N;\n"
+              "  for i in rng::range(0, n) { total += i; }\n"
+              "  total\n"
+              "}\n"},
+    {"iterator", "func main() -> u64 {\n"
+                 "  let total: u64 = 0;\n"
+                 "  let n: u64 = $N;\n"
+                 "  let numbers = rng::range(0, n);\n"
+                 "  for i in numbers { total += i; }\n"
+                 "  total\n"
+                 "}\n"},
+    // Calls: an iteration is about one call of `fib`
+    {"fib", "func fib(n: i64) -> i64 { if n < 2 { rtn n; } fib(n - 1) + fib(n - 2) }\n"
+            "func main() -> i64 {\n"
+            "  let calls: i64 = 0; let n: i64 = 1;\n"
+            "  while calls < $N { calls += fib(n) * 2 - 1; n += 1; }\n"
+            "  n\n"
+            "}\n"},
+};
+
+bool parse_options(int argc, char **argv, Options *options) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view flag = argv[i];
+        std::string_view value = argv[i + 1];
+        uint64_t number = 0;
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+        if (ec != std::errc() || end != value.data() + value.size()) return false;
+        if (flag == "--iterations") {
+            options->iterations = number;
+        } else if (flag == "--repeat") {
+            options->repeat = std::max<uint32_t>(1, static_cast<uint32_t>(number));
+        } else {
+            return false;
+        }
+    }
+    return argc % 2 == 1;
+}
+
+} // namespace
+
+// vm_bench [--iterations 10000000] [--repeat 5]
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, &options)) {
+        std::println(stderr, "usage: vm_bench [--iterations <n>] [--repeat <n>]");
+        return 2;
+    }
+
+    std::println("{{");
+    std::println("  \"iterations\": {},", options.iterations);
+    std::println("  \"repeat\": {},", options.repeat);
+    std::println("  \"programs\": [");
+    for (size_t idx = 0; idx < std::size(programs); idx++) {
+        std::string source = programs[idx].source;
+        for (size_t at; (at = source.find("$N")) != std::string::npos;) {
+            source.replace(at, 2, std::to_string(options.iterations));
+        }
+        Dove::Lexer lexer(source);
+        Dove::Parser parser(*lexer.get_token_buffer().value());
+        Dove::Ast ast = parser.take_ast();
+        Dove::Compiler compiler(ast, lexer.get_interner());
+        auto program = compiler.get_program();
+        if (!program) {
+            std::println(stderr, "vm_bench: {}: {}", programs[idx].name,
+                         program.error().format());
+            return 1;
+        }
+
+        Dove::Vm vm;
+        std::vector<double> seconds;
+        uint64_t result = 0;
+        for (uint32_t i = 0; i < options.repeat; i++) {
+            vm.seed(1);
+            auto start = std::chrono::steady_clock::now();
+            auto value = vm.run(**program);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (!value) {
+                std::println(stderr, "vm_bench: {}: {}", programs[idx].name,
+                             value.error().format());
+                return 1;
+            }
+            result = value->u;
+            seconds.push_back(std::chrono::duration<double>(elapsed).count());
+        }
+        std::sort(seconds.begin(), seconds.end());
+        double median = seconds[seconds.size() / 2];
+        std::println("    {{\"program\": \"{}\", \"seconds\": {:.6f}, "
+                     "\"ns_per_iteration\": {:.2f}, \"result\": {}}}{}",
+                     programs[idx].name, median, median * 1e9 / options.iterations, result,
+                     idx + 1 < std::size(programs) ? "," : "");
+    }
+    std::println("  ]");
+    std::println("}}");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "token.h"
+#include "token_buffer.h"
+#include "utils/arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Dove {
+
+// Index of a node in its Ast. Node 0 is the module, which is nobody's child, so as a child
+// 0 means "none".
+using NodeId = uint32_t;
+
+/**
+ * Node kinds
+ *
+ * X(NodeKind, lhs, rhs) — what the two operand fields of a node hold: Node (a child, 0 if
+ * absent), List (an index into the extra array, where a count is followed by that many
+ * NodeIds), Pair (an index into the extra array, of two NodeIds) or None. A node's token is
+ * the token it was parsed from, named after each entry; "name" is the identifier right
+ * after that token.
+ */
+#define DOVE_NODE_KINDS(X)                                                                     \
+    /* Items */                                                                                \
+    X(Module, List, None)         /* items                                                 */ \
+    X(Use, Node, None)            /* `use`: path                                           */ \
+    X(UseName, None, None)        /* identifier; Node::glob for `std!`                     */ \
+    X(UsePath, Node, Node)        /* `::`: prefix, rest                                    */ \
+    X(UseGroup, List, None)       /* `{`: paths                                            */ \
+    X(Obj, List, None)            /* `obj` name: fields and methods                        */ \
+    X(Func, List, Pair)           /* `func` name: params, {return type, body}              */ \
+    X(Param, Node, None)          /* name: type                                            */ \
+    X(Let, Node, Node)            /* `let` name: type, initializer                         */ \
+    X(Const, Node, Node)          /* `const` name: type, initializer                       */ \
+    /* Types */                                                                                \
+    X(TypeName, None, None)       /* primitive type or identifier                          */ \
+    X(TypeArray, Node, Node)      /* `[`: element type, length (0 for `~`)                 */ \
+    X(TypeRef, Node, None)        /* `&`: type                                             */ \
+    X(TypeConst, Node, None)      /* `const`: type                                         */ \
+    /* Statements and control flow */                                                         \
+    X(Block, List, Node)          /* `{`: statements, value (the last expression)          */ \
+    X(Rtn, Node, None)            /* `rtn`: value                                          */ \
+    X(Brk, Node, None)            /* `brk`: value (a lone identifier may name a loop)      */ \
+    X(Loop, Node, None)           /* `loop`, label if Node::labeled: body                  */ \
+    X(While, Node, Node)          /* `while`: condition, body                              */ \
+    X(For, Node, Node)            /* `for` binding: iterable, body                         */ \
+    X(If, Node, Pair)             /* `if` or `elif`: condition, {then, else}               */ \
+    X(Match, Node, List)          /* `match`: value, arms                                  */ \
+    X(MatchArm, Node, Node)       /* `is` or `fallback`: pattern (0 for fallback), value   */ \
+    /* Expressions */                                                                          \
+    X(Identifier, None, None)     /* identifier                                            */ \
+    X(Integer, None, None)        /* integer literal, any radix                            */ \
+    X(Float, None, None)          /* floating point literal                                */ \
+    X(String, None, None)         /* string literal                                        */ \
+    X(Character, None, None)      /* character literal                                     */ \
+    X(Bool, None, None)           /* `true` or `false`                                     */ \
+    X(Path, Node, None)           /* `::` name: prefix                                     */ \
+    X(Unary, Node, None)          /* operator (Node::op): operand                          */ \
+    X(Binary, Node, Node)         /* operator (Node::op): operands                         */ \
+    X(Assign, Node, Node)         /* `=` or compound operator (Node::op): target, value    */ \
+    X(Call, Node, List)           /* `(`: callee, arguments                                */ \
+    X(Member, Node, None)         /* `.` name: object                                      */ \
+    X(Index, Node, Node)          /* `[`: array, index                                     */
+
+enum class NodeKind : uint8_t {
+#define DOVE_NODE_ENUM_ENTRY(name, lhs, rhs) name,
+    DOVE_NODE_KINDS(DOVE_NODE_ENUM_ENTRY)
+#undef DOVE_NODE_ENUM_ENTRY
+};
+
+// What an operand field holds (see DOVE_NODE_KINDS)
+enum class Operand : uint8_t { None, Node, List, Pair };
+
+constexpr Operand lhs_operand(NodeKind kind) {
+#define DOVE_NODE_LHS(name, lhs, rhs) Operand::lhs,
+    constexpr Operand operands[] = {DOVE_NODE_KINDS(DOVE_NODE_LHS)};
+#undef DOVE_NODE_LHS
+    return operands[static_cast<size_t>(kind)];
+}
+
+constexpr Operand rhs_operand(NodeKind kind) {
+#define DOVE_NODE_RHS(name, lhs, rhs) Operand::rhs,
+    constexpr Operand operands[] = {DOVE_NODE_KINDS(DOVE_NODE_RHS)};
+#undef DOVE_NODE_RHS
+    return operands[static_cast<size_t>(kind)];
+}
+
+/**
+ * Node
+ *
+ * 16 bytes: kind, flags, operator, the token it was parsed from and two operands whose
+ * meaning depends on the kind (see DOVE_NODE_KINDS).
+ */
+struct Node {
+    static constexpr uint8_t labeled = 1; // Loop: the identifier after the token is a label
+    static constexpr uint8_t glob = 2;    // UseName: followed by `!`
+
+    NodeKind kind;
+    uint8_t flags;
+    TokenType op; // Unary, Binary, Assign and MatchArm (`is 1` is `is == 1`)
+    uint32_t token;
+    uint32_t lhs;
+    uint32_t rhs;
+};
+static_assert(sizeof(Node) == 16);
+
+/**
+ * Ast
+ *
+ * A parsed compilation unit as two flat arrays: the nodes, each after its children (except
+ * the module, which is node 0), and the extra array holding child lists and pairs. Nodes
+ * refer to each other and to their tokens by 32-bit index, and both arrays live in the Ast's
+ * arena, so a whole tree is freed at once. Identifier, literal and operator data stays in the
+ * TokenBuffer it was parsed from, which must outlive the Ast.
+ */
+class Ast {
+private:
+    friend class Parser;
+
+    Arena arena;
+    const TokenBuffer *tokens = nullptr;
+    Node *nodes = nullptr;
+    uint32_t *extra = nullptr;
+    uint32_t node_count = 0;
+    uint32_t extra_count = 0;
+    uint32_t extra_capacity = 0;
+
+    void dump(std::string &out, NodeId id, size_t depth) const;
+
+public:
+    static constexpr NodeId root = 0;
+
+    Ast() = default;
+    Ast(Ast &&) = default;
+    Ast &operator=(Ast &&) = default;
+
+    size_t size() const { return node_count; }
+    const Node &operator[](NodeId id) const { return nodes[id]; }
+
+    // The nodes of a List operand
+    std::span<const NodeId> list(uint32_t at) const { return {extra + at + 1, extra[at]}; }
+    // The nodes of a Pair operand
+    NodeId first(uint32_t at) const { return extra[at]; }
+    NodeId second(uint32_t at) const { return extra[at + 1]; }
+
+    const TokenBuffer &get_tokens() const { return *tokens; }
+    // The spelling of a node's token, and of the identifier after it (see DOVE_NODE_KINDS)
+    std::string_view str(NodeId id) const { return tokens->str(nodes[id].token); }
+    std::string_view name(NodeId id) const { return tokens->str(nodes[id].token + 1); }
+
+    // Bytes held by the arena
+    size_t memory_usage() const { return arena.bytes_reserved(); }
+
+    // One node per line, children indented under their parent
+    std::string dump() const;
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "token_buffer.h"
+#include "type.h"
+#include "utils/number.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * Value
+ *
+ * A register, global or object field: 16 bytes, so `i128` and `u128` need no boxing. Types
+ * of up to 64 bits live in `i`, `u` or `f`, sign- or zero-extended to 64 bits, and leave the
+ * upper half unspecified. Bools are 0 or 1, a `ch` is its byte, and objects and iterators
+ * point into the VM's heap.
+ */
+union Value {
+    uint64_t u;
+    int64_t i;
+    double f;
+    u128 wide;
+    void *ptr;
+};
+static_assert(sizeof(Value) == 16);
+
+/**
+ * Operand formats
+ *
+ * What the a, b, c and x fields of an instruction hold: registers (a, b, c), a count (c), a
+ * field index (b or c), an index into a table of the program or function (x), a 16-bit
+ * immediate (b and c) or an immediate in x, and a jump, relative to the next instruction
+ * (x).
+ */
+enum class Format : uint8_t {
+    None,
+    A,   // a
+    AB,  // a, b
+    ABC, // a, b, c
+    ABF, // a, b, field c
+    AFC, // a, field b, c
+    AK,  // a, index x
+    ABI, // a, b, immediate x
+    AJ,  // a, jump x
+    ABJ, // a, b, jump x
+    AIJ, // a, immediate (b, c), jump x
+    J,   // jump x
+    ACK, // a .. a + c, index x
+    AT,  // a, jump table x
+};
+
+// Typed families. Integer families follow TypeKind order, so the opcode for a type is the
+// family's first opcode plus the TypeKind.
+#define DOVE_INTEGER_OPS(X, op, format)                                                       \
+    X(op##I8, format) X(op##I16, format) X(op##I32, format) X(op##I64, format)                 \
+    X(op##I128, format) X(op##U8, format) X(op##U16, format) X(op##U32, format)                \
+    X(op##U64, format) X(op##U128, format)
+#define DOVE_NUMBER_OPS(X, op, format) DOVE_INTEGER_OPS(X, op, format) X(op##F64, format)
+#define DOVE_SIGNED_OPS(X, op, format)                                                        \
+    X(op##I8, format) X(op##I16, format) X(op##I32, format) X(op##I64, format)                 \
+    X(op##I128, format) X(op##F64, format)
+// Comparisons only depend on the representation: I64 and U64 compare every signed and
+// unsigned type of up to 64 bits (and `ch`), W64 and W128 are equality of the raw bits
+#define DOVE_ORDER_OPS(X, op, format)                                                         \
+    X(op##I64, format) X(op##U64, format) X(op##I128, format) X(op##U128, format)              \
+    X(op##F64, format)
+#define DOVE_EQUALITY_OPS(X, op, format) X(op##W64, format) X(op##W128, format) X(op##F64, format)
+
+/**
+ * Opcodes
+ *
+ * X(Opcode, Format). Arithmetic wraps around at the width of its type; integer division
+ * and remainder by zero stop the program. Conditional jumps are taken when their condition
+ * holds; the compare-and-branch ones are superinstructions for a comparison followed by a
+ * jump, and AddImm is one for `+=` and `-=` of a constant.
+ */
+#define DOVE_OPCODES(X)                                                                        \
+    /* Registers and globals */                                                                \
+    X(Move, AB)      /* a = b                                                               */ \
+    X(LoadInt, AK)   /* a = x, sign-extended to 128 bits                                    */ \
+    X(LoadConst, AK) /* a = constant x of the function                                      */ \
+    X(GetGlobal, AK) /* a = global x                                                        */ \
+    X(SetGlobal, AK) /* global x = a                                                        */ \
+    /* Arithmetic: a = b op c */                                                               \
+    DOVE_NUMBER_OPS(X, Add, ABC)                                                               \
+    DOVE_NUMBER_OPS(X, Sub, ABC)                                                               \
+    DOVE_NUMBER_OPS(X, Mul, ABC)                                                               \
+    DOVE_NUMBER_OPS(X, Div, ABC)                                                               \
+    DOVE_NUMBER_OPS(X, Mod, ABC)                                                               \
+    DOVE_INTEGER_OPS(X, Shl, ABC)                                                              \
+    DOVE_INTEGER_OPS(X, Shr, ABC)                                                              \
+    X(BitAnd64, ABC)                                                                           \
+    X(BitAnd128, ABC)                                                                          \
+    X(BitOr64, ABC)                                                                            \
+    X(BitOr128, ABC)                                                                           \
+    DOVE_INTEGER_OPS(X, AddImm, ABI) /* a = b + x                                           */ \
+    /* Unary: a = op b */                                                                      \
+    DOVE_SIGNED_OPS(X, Neg, AB)                                                                \
+    X(Not, AB)                                                                                 \
+    /* Comparisons: a = b op c */                                                              \
+    DOVE_ORDER_OPS(X, Lt, ABC)                                                                 \
+    DOVE_ORDER_OPS(X, Le, ABC)                                                                 \
+    DOVE_EQUALITY_OPS(X, Eq, ABC)                                                              \
+    DOVE_EQUALITY_OPS(X, Ne, ABC)                                                              \
+    /* Jumps */                                                                                \
+    X(Jump, J)                                                                                 \
+    X(JumpIf, AJ)                                                                              \
+    X(JumpIfNot, AJ)                                                                           \
+    DOVE_ORDER_OPS(X, JumpLt, ABJ)                                                             \
+    DOVE_ORDER_OPS(X, JumpLe, ABJ)                                                             \
+    DOVE_EQUALITY_OPS(X, JumpEq, ABJ)                                                          \
+    DOVE_EQUALITY_OPS(X, JumpNe, ABJ)                                                          \
+    X(JumpNotLtF64, ABJ) /* NaN compares false both ways                                    */ \
+    X(JumpNotLeF64, ABJ)                                                                       \
+    X(JumpLtImmI64, AIJ)                                                                       \
+    X(JumpLtImmU64, AIJ)                                                                       \
+    X(JumpLeImmI64, AIJ)                                                                       \
+    X(JumpLeImmU64, AIJ)                                                                       \
+    X(JumpGtImmI64, AIJ)                                                                       \
+    X(JumpGtImmU64, AIJ)                                                                       \
+    X(JumpGeImmI64, AIJ)                                                                       \
+    X(JumpGeImmU64, AIJ)                                                                       \
+    X(JumpEqImm, AIJ)                                                                          \
+    X(JumpNeImm, AIJ)                                                                          \
+    X(JumpTable, AT) /* jump to the target of a in table x of the function                  */ \
+    /* Calls: arguments in a .. a + c, the result in a */                                     \
+    X(Call, ACK)   /* function x                                                            */ \
+    X(Native, ACK) /* native function x (DOVE_NATIVES)                                      */ \
+    X(Print, ACK)  /* format x of the program                                               */ \
+    X(Return, A)                                                                               \
+    X(ReturnUnit, None)                                                                        \
+    /* Objects */                                                                              \
+    X(New, AK)      /* a = new object of layout x, its fields zeroed                        */ \
+    X(Copy, AB)     /* a = deep copy of object b                                            */ \
+    X(GetField, ABF) /* a = b.c                                                             */ \
+    X(SetField, AFC) /* a.b = c                                                             */ \
+    /* Iterators: a = iterator over [b, c) by order family; the next value of a into b, or */ \
+    /* jump once there is none */                                                              \
+    X(RangeI64, ABC)                                                                           \
+    X(RangeU64, ABC)                                                                           \
+    X(RangeI128, ABC)                                                                          \
+    X(RangeU128, ABC)                                                                          \
+    X(IterNext, ABJ)                                                                           \
+    /* Counted loops: a += 1, then jump while a < b. The loop is entered with a < b, so a */  \
+    /* never passes b and cannot wrap around. */                                               \
+    X(ForLoopI64, ABJ)                                                                         \
+    X(ForLoopU64, ABJ)                                                                         \
+    X(ForLoopI128, ABJ)                                                                        \
+    X(ForLoopU128, ABJ)
+
+enum class Opcode : uint8_t {
+#define DOVE_OPCODE_ENUM_ENTRY(name, format) name,
+    DOVE_OPCODES(DOVE_OPCODE_ENUM_ENTRY)
+#undef DOVE_OPCODE_ENUM_ENTRY
+};
+
+#define DOVE_OPCODE_COUNT_ENTRY(name, format) +1
+constexpr size_t opcode_count = 0 DOVE_OPCODES(DOVE_OPCODE_COUNT_ENTRY);
+#undef DOVE_OPCODE_COUNT_ENTRY
+static_assert(opcode_count <= 256);
+
+// The opcode of a typed family for `kind`, from the family's first opcode
+constexpr Opcode typed(Opcode first, TypeKind kind) {
+    return static_cast<Opcode>(static_cast<uint8_t>(first) + static_cast<uint8_t>(kind));
+}
+// Signed families (DOVE_SIGNED_OPS) have no unsigned entries
+constexpr Opcode typed_signed(Opcode first, TypeKind kind) {
+    uint8_t offset = kind == TypeKind::F64 ? 5 : static_cast<uint8_t>(kind);
+    return static_cast<Opcode>(static_cast<uint8_t>(first) + offset);
+}
+// Order families (DOVE_ORDER_OPS) by representation
+constexpr Opcode typed_order(Opcode first, Type type) {
+    uint8_t offset = type.kind == TypeKind::F64    ? 4
+                     : type.kind == TypeKind::I128 ? 2
+                     : type.kind == TypeKind::U128 ? 3
+                     : type.is_signed()            ? 0
+                                                   : 1;
+    return static_cast<Opcode>(static_cast<uint8_t>(first) + offset);
+}
+// Equality families (DOVE_EQUALITY_OPS) by representation
+constexpr Opcode typed_equality(Opcode first, Type type) {
+    uint8_t offset = type.kind == TypeKind::F64 ? 2 : type.is_wide() ? 1 : 0;
+    return static_cast<Opcode>(static_cast<uint8_t>(first) + offset);
+}
+
+std::string_view opcode_name(Opcode op);
+Format opcode_format(Opcode op);
+
+/**
+ * Natives
+ *
+ * X(Native, module, name, result TypeKind) — functions of the runtime, called as
+ * `module::name()`.
+ */
+#define DOVE_NATIVES(X) X(RandBool, "rand", "rand_bool", Bool)
+
+enum class Native : uint8_t {
+#define DOVE_NATIVE_ENUM_ENTRY(name, module, function, result) name,
+    DOVE_NATIVES(DOVE_NATIVE_ENUM_ENTRY)
+#undef DOVE_NATIVE_ENUM_ENTRY
+};
+
+/**
+ * Instruction
+ *
+ * 8 bytes: the opcode, three 8-bit operands and a 32-bit one (see Format).
+ */
+struct Instruction {
+    Opcode op;
+    uint8_t a;
+    uint8_t b;
+    uint8_t c;
+    int32_t x;
+
+    int16_t immediate() const { return static_cast<int16_t>(b | c << 8); }
+};
+static_assert(sizeof(Instruction) == 8);
+
+// The targets of a JumpTable, as instruction indices: one for each value from `low` on, and
+// one for every other value. `low` is the 64-bit pattern of the lowest case (a u64 past 2^63
+// is negative here); values are indexed by their offset from it modulo 2^64
+struct JumpTable {
+    int64_t low = 0;
+    std::vector<uint32_t> targets;
+    uint32_t fallback = 0;
+};
+
+/**
+ * Function
+ *
+ * Bytecode and what it needs besides the registers: constants too wide for LoadInt, and
+ * the token each instruction was compiled from, for runtime errors. The parameters are the
+ * first registers of the frame.
+ */
+struct Function {
+    std::string name;
+    std::vector<Instruction> code;
+    std::vector<uint32_t> tokens;
+    std::vector<Value> constants;
+    std::vector<JumpTable> tables;
+    // Shown by Program::dump() before the instruction they point at (how a match compiled)
+    std::vector<std::pair<uint32_t, std::string>> notes;
+    uint32_t params = 0;
+    uint32_t registers = 0;
+};
+
+// A `println` or `print` format string cut at its `{}`s, and the types of the arguments
+struct PrintFormat {
+    std::vector<std::string> pieces; // one more than there are arguments
+    std::vector<TypeKind> types;
+    bool newline;
+};
+
+/**
+ * Program
+ *
+ * The output of the Compiler. Running it runs `entry`, which initializes the globals and
+ * calls `main`. Objects are built from layouts: for each field, the layout of the object
+ * it holds or -1 for a scalar.
+ */
+struct Program {
+    std::vector<Function> functions;
+    std::vector<std::vector<int32_t>> layouts;
+    std::vector<PrintFormat> formats;
+    uint32_t globals = 0;
+    uint32_t entry = 0;
+    const TokenBuffer *tokens = nullptr;
+
+    // One instruction per line, function by function
+    std::string dump() const;
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "ast.h"
+#include "bytecode.h"
+#include "diagnostics.h"
+#include "error.h"
+#include "interner.h"
+#include "token.h"
+#include "type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * Compiler
+ *
+ * Turns an Ast into a Program for the Vm. Every value has a static type, so each operation
+ * picks its typed opcode here and the VM never checks a type. Registers are handed out like
+ * a stack: a function's parameters come first (after the object, for methods), then its
+ * locals in scope order and the temporaries of the expression being compiled on top. A call
+ * passes its arguments in the registers at the top, which become the bottom of the callee's
+ * frame.
+ *
+ * Conditions never materialize a bool when they can branch directly: comparisons compile
+ * to compare-and-branch superinstructions, against a 16-bit immediate when one side is a
+ * small literal, and `&&`, `||` and `!` to jumps between them. A match of constants is one
+ * branch on a bool, a jump table when its cases are dense and a binary decision tree when
+ * not; Program::dump() notes which. `while` tests its condition at
+ * the bottom, so an iteration takes one branch, and `for` over `rng::range(a, b)` is a counted
+ * loop: one ForLoop per iteration and no iterator.
+ *
+ * Globals (top-level `let` and `const`, and object constants) are initialized in source
+ * order by the entry function, which then calls `main`; an initializer that reads a global
+ * initialized after it is an error.
+ *
+ * Expressions of literals and constants are evaluated here, with the VM's wrapping
+ * arithmetic, and an integer result that does not fit its type is an error. A constant
+ * whose initializer is one of them (a top-level, object or local `const`) takes no global
+ * or register: its value is loaded, or compared as an immediate, wherever it is named.
+ * Global constants are folded before any code is compiled, each when it is first named, so
+ * they may name constants declared after them; a constant that names itself, however
+ * indirectly, is an error.
+ */
+class Compiler {
+private:
+    static constexpr uint32_t none = UINT32_MAX;
+
+    // What a top-level name refers to, by SymbolId
+    struct Binding {
+        enum Kind : uint8_t { Free, Function, Object, Global } kind = Free;
+        uint32_t index = 0;
+    };
+
+    struct Field {
+        SymbolId name;
+        NodeId node;
+        Type type;
+    };
+    struct Object {
+        NodeId node;
+        std::vector<Field> fields;
+        std::vector<std::pair<SymbolId, uint32_t>> methods; // function index
+        std::vector<std::pair<SymbolId, uint32_t>> consts;  // global index
+    };
+    struct Callable {
+        NodeId node;
+        uint32_t object; // none for functions
+        std::vector<Type> params;
+        Type result;
+    };
+    struct Global {
+        NodeId node;
+        uint32_t object; // none at the top level
+        Type type;       // Never until known, if it is inferred
+        bool constant;
+        // Folded: a constant of known `value`, never stored. Folding while its own
+        // initializer is folded, which catches a constant that names itself.
+        enum Fold : uint8_t { Pending, Folding, Folded, Failed } fold = Pending;
+        Value value{};
+    };
+    struct Local {
+        SymbolId name;
+        uint8_t reg; // unused if folded
+        Type type;
+        bool constant;
+        bool folded = false;
+        Value value{};
+    };
+    struct Loop {
+        SymbolId label;
+        Type type;        // of the `brk` values so far (Never for none yet)
+        uint8_t reg;      // where they go
+        bool value;       // whether the loop's value is used
+        bool breakable;   // `loop` (a `brk` may have a value), not `while` or `for`
+        bool broken;      // a `brk` leaves it
+        std::vector<uint32_t> breaks;
+    };
+
+    // A value known at compile time. An integer operation whose result does not fit its type
+    // wraps around, as it would at run time, and is reported if the value is used.
+    struct Constant {
+        Type type;
+        Value value{};
+        NodeId overflow = Ast::root; // the first such operation
+        Type overflow_type{};
+    };
+
+    // A fold() that failed, with the type it expected
+    struct Unfolded {
+        Type expected;
+        bool failed = false;
+    };
+
+    // An arm of a match comparing to a constant
+    struct Case {
+        i128 value;
+        uint32_t arm;
+    };
+    static constexpr size_t dense_cases = 4; // fewest cases for a jump table
+    static constexpr size_t tree_leaf = 3;   // most cases a decision tree tests one by one
+
+    // Where a value should go: nowhere (evaluated for its effects), any register (a local's
+    // own or a new temporary at the top) or a given register
+    struct Dest {
+        enum Kind : uint8_t { Discard, Any, Fixed } kind;
+        uint8_t reg = 0;
+    };
+    struct Result {
+        Type type;
+        uint8_t reg = 0;
+    };
+    // Something that can be assigned to
+    struct Place {
+        enum Kind : uint8_t { None, Local, Field, Global } kind = None;
+        Type type;
+        uint8_t reg = 0;    // the local, or the object of the field
+        uint32_t index = 0; // field or global
+        bool constant = false;
+    };
+
+    const Ast &ast;
+    const TokenBuffer &tokens;
+    const Interner &interner;
+    Program program;
+    Diagnostics diagnostics;
+
+    std::vector<Binding> names;
+    std::vector<Object> objects; // same index as program.layouts
+    std::vector<Callable> callables; // same index as program.functions
+    std::vector<Global> globals;
+    // By NodeId, so an expression that does not fold is walked once rather than again by
+    // each enclosing expression that tries
+    std::vector<Unfolded> unfolded;
+
+    // Names the compiler knows (Interner::none if the source never uses them)
+    SymbolId main_symbol;
+    SymbolId println_symbol;
+    SymbolId print_symbol;
+    SymbolId rng_symbol;
+    SymbolId range_symbol;
+    SymbolId underscore_symbol;
+
+    // The function being compiled
+    Function *function = nullptr;
+    Type result;                   // its return type
+    uint32_t scope_object = none;  // whose fields, methods and constants are in scope
+    bool in_method = false;        // the object is in register 0
+    std::vector<Local> locals;
+    size_t visible_locals = 0;     // locals below this are hidden (object initializers)
+    std::vector<Loop> loops;
+    uint32_t top = 0;              // first free register
+    uint32_t initialized = none;   // globals from this one on are not initialized yet
+    bool registers_reported = false;
+
+    // Declarations
+    void declare();
+    void declare_object(uint32_t index);
+    uint32_t declare_function(NodeId id, uint32_t object);
+    void check_layouts();
+    Type type_of(NodeId id);
+    SymbolId symbol(uint32_t token) const { return tokens.value(token); }
+
+    // Functions
+    void begin_function(uint32_t index, uint32_t object, bool method);
+    // Folds the constants among the globals, whatever order they name each other in
+    void fold_globals();
+    void fold_global(uint32_t index);
+    void compile_entry();
+    void compile_function(uint32_t index);
+
+    // Code
+    uint32_t emit(Opcode op, uint32_t a, uint32_t b, uint32_t c, int32_t x, uint32_t token);
+    uint32_t here() const { return static_cast<uint32_t>(function->code.size()); }
+    // Point jump `at` to `target` (to the next instruction by default)
+    void patch(uint32_t at, uint32_t target);
+    void patch(uint32_t at) { patch(at, here()); }
+    void patch_all(const std::vector<uint32_t> &jumps) {
+        for (uint32_t at : jumps) patch(at);
+    }
+    uint8_t alloc(NodeId at);
+    uint8_t target(Dest dest, NodeId at) { return dest.kind == Dest::Fixed ? dest.reg : alloc(at); }
+    void load(uint8_t reg, Type type, Value value, uint32_t token);
+    void load_default(uint8_t reg, Type type, NodeId at);
+
+    // Names
+    const Local *find_local(SymbolId name) const;
+    uint32_t find_field(uint32_t object, SymbolId name) const;
+    uint32_t find_method(uint32_t object, SymbolId name) const;
+    uint32_t find_global(SymbolId name) const;
+    // The global of `Object::constant`, if `id` is a path to one
+    uint32_t find_constant(NodeId id) const;
+    // The value of the constant `id` names, if it folds
+    bool known(NodeId id, Constant *out);
+    Place place(NodeId id);
+    void store(const Place &place, uint8_t reg, uint32_t token);
+
+    // Types
+    bool check(Type expected, Type found, NodeId at);
+    // The value of an integer, `ch` or bool expression of `type`, if it folds and fits;
+    // nothing is reported
+    bool constant(NodeId id, Type type, i128 *out);
+    bool is_literal(NodeId id) const;
+    // The value of `id` if it is made of literals and folded constants only, typed as
+    // expression() would type it; false for anything else, such as a division by zero
+    bool fold(NodeId id, Type expected, Constant *out);
+    bool evaluate(NodeId id, Type expected, Constant *out); // fold(), uncached
+    void report_overflow(const Constant &value);
+
+    // Statements and expressions
+    Type statement(NodeId id);
+    void let(NodeId id);
+    Result expression(NodeId id, Type expected, Dest dest);
+    // expression(), copying objects read from a variable or field (objects are values)
+    Result value(NodeId id, Type expected, Dest dest);
+    Result literal(NodeId id, Type expected, Dest dest, bool negate);
+    Result name(NodeId id, Dest dest);
+    Result load_constant(NodeId id, const Constant &value, Dest dest);
+    Result unary(NodeId id, Type expected, Dest dest);
+    Result binary(NodeId id, Type expected, Dest dest);
+    // `lhs op rhs` with an arithmetic or bitwise operator, into a register picked from
+    // `dest` once the right operand is compiled
+    uint8_t arithmetic(TokenType op, Type type, uint8_t lhs, NodeId rhs, Dest dest, NodeId at);
+    void assign(NodeId id);
+    Result call(NodeId id, Dest dest);
+    Result call_function(uint32_t index, NodeId id, uint8_t self, bool has_self);
+    Result print(NodeId id, bool newline);
+    // `rng::range(a, b)`, as an iterator or, in `for`, as the bounds of a counted loop
+    bool is_range(NodeId id) const;
+    Type bounds(NodeId id, uint8_t from, uint8_t to);
+    Result range(NodeId id, Dest dest);
+    Result member(NodeId id, Dest dest);
+    Result block(NodeId id, Type expected, Dest dest);
+    // A new object from `{ field = value, ... }`, or the default one for anything else
+    Result object(NodeId id, uint32_t object);
+    Result if_expression(NodeId id, Type expected, Dest dest);
+    Result match(NodeId id, Type expected, Dest dest);
+    // Whether sorted, distinct cases fill enough of their range for a jump table
+    bool is_dense(const std::vector<Case> &cases, Type type) const;
+    // Jumps to the arm of the case the subject equals, or to `otherwise`; the `last` tree
+    // falls through instead
+    void decide(Result subject, std::span<const Case> cases, uint32_t otherwise, bool last,
+                std::vector<std::vector<uint32_t>> &jumps, NodeId at);
+    Result loop(NodeId id, Type expected, Dest dest);
+    void while_loop(NodeId id);
+    void for_loop(NodeId id);
+    void rtn(NodeId id);
+    void brk(NodeId id);
+
+    // Conditions: jump to the instructions added to `jumps` if the condition is `when`, fall
+    // through if not
+    void condition(NodeId id, bool when, std::vector<uint32_t> &jumps);
+    // Compare `lhs` (already compiled) with the expression `rhs`
+    void compare(TokenType op, Result lhs, NodeId rhs, bool when, std::vector<uint32_t> &jumps,
+                 NodeId at);
+    // Jump if `a relation b`, or `reg relation value` (as an immediate if it fits)
+    uint32_t jump_registers(TokenType relation, Type type, uint8_t a, uint8_t b, uint32_t token);
+    uint32_t jump_constant(TokenType relation, Type type, uint8_t reg, i128 value, NodeId at);
+
+    void report(Message message, NodeId at, uint32_t arg0 = 0, uint32_t arg1 = 0);
+
+public:
+    // `ast` must be free of parser errors and `interner` the one its tokens were lexed with
+    Compiler(const Ast &ast, const Interner &interner);
+
+    // Every error found, in the order they were found
+    const Diagnostics &get_diagnostics() const { return diagnostics; }
+    // The program, or the first diagnostic if there is one
+    std::expected<const Program *, CompilerError> get_program() const;
+    Program take_program() { return std::move(program); }
+};
+
+} // namespace Dove
\ No newline at end of file
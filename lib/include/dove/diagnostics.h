@@ -0,0 +1,111 @@
+#pragma once
+
+#include "error.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Dove {
+
+// Message templates; each has a fixed error code and up to two unformatted arguments
+enum class Message : uint8_t {
+    InvalidUtf8Byte,        // byte
+    UnexpectedCodePoint,    // code point
+    UnexpectedByte,         // byte
+    StringNotTerminated,    //
+    EmptyCharacter,         //
+    ExpectedCharNotString,  //
+    CharacterNotTerminated, //
+    UnknownEscape,          // byte after the backslash
+    FloatOutOfRange,        //
+    IntegerOverflow,        //
+    MissingDigits,          // radix
+    InvalidDigit,           // digit, radix
+
+    // Parser; a found token is a TokenType, or token_type_count for the end of the file
+    ExpectedToken,      // expected TokenType, found token
+    ExpectedExpression, // found token
+    ExpectedType,       // found token
+    ExpectedItem,       // found token
+    ExpectedMember,     // found token
+    InvalidAssignment,  //
+
+    // Compiler; a type is a TypeKind
+    UnknownName,        //
+    UnknownMember,      //
+    TypeMismatch,       // expected type, found type
+    InvalidOperand,     // operator TokenType, type
+    NotCallable,        //
+    AssignToConstant,   //
+    BreakOutsideLoop,   //
+    ArgumentCount,      // expected count, found count
+    FormatArguments,    // placeholders, arguments
+    OutOfRange,         // type
+    MissingFallback,    //
+    MissingMain,        //
+    Unsupported,        //
+    TooManyRegisters,   //
+
+    // Runtime
+    DivisionByZero, //
+    StackOverflow,  //
+};
+
+/**
+ * Diagnostic
+ *
+ * One error as a 24-byte record: the message template, where it is and the arguments of the
+ * message. Nothing is formatted until format() or to_error() is called.
+ */
+struct Diagnostic {
+    uint32_t offset; // byte in the source
+    uint32_t line;
+    uint32_t column;
+    uint32_t args[2];
+    Message message;
+
+    ErrorType type() const;
+    CompilerError to_error() const;
+    std::string format() const { return to_error().format(); }
+};
+static_assert(sizeof(Diagnostic) == 24);
+
+/**
+ * Diagnostics
+ *
+ * Errors in the order they were found. Recording one is a push of a Diagnostic, so a
+ * phase can keep going after an error and report all of them at the end; a run without
+ * errors never touches the (empty) vector.
+ */
+class Diagnostics {
+private:
+    std::vector<Diagnostic> records;
+
+public:
+    void report(Message message, uint32_t offset, uint32_t line, uint32_t column,
+                uint32_t arg0 = 0, uint32_t arg1 = 0) {
+        records.push_back(Diagnostic{offset, line, column, {arg0, arg1}, message});
+    }
+    void report(const Diagnostic &diagnostic) { records.push_back(diagnostic); }
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+    const Diagnostic &operator[](size_t idx) const { return records[idx]; }
+    Diagnostic &operator[](size_t idx) { return records[idx]; }
+    std::vector<Diagnostic>::const_iterator begin() const { return records.begin(); }
+    std::vector<Diagnostic>::const_iterator end() const { return records.end(); }
+
+    // Drop the records from `count` on
+    void truncate(size_t count) { records.resize(count); }
+    void clear() { records.clear(); }
+    void append(const Diagnostics &other) {
+        records.insert(records.end(), other.records.begin(), other.records.end());
+    }
+
+    // Every record formatted, one per line
+    std::string format() const;
+};
+
+} // namespace Dove
@@ -1,9 +1,25 @@
 #pragma once
 
 // Dove Core
+#include "ast.h"
+#include "bytecode.h"
+#include "compiler.h"
+#include "diagnostics.h"
+#include "embedded.h"
 #include "error.h"
+#include "interner.h"
 #include "lexer.h"
+#include "metrics.h"
+#include "parser.h"
+#include "source_manager.h"
 #include "token.h"
+#include "token_batch.h"
+#include "token_buffer.h"
+#include "token_cache.h"
+#include "token_pipeline.h"
+#include "token_stream.h"
+#include "type.h"
+#include "vm.h"
 
 // Dove Utilities
 // #include "utils/unicode.h"
\ No newline at end of file
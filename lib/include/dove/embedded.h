@@ -0,0 +1,238 @@
+#pragma once
+
+#include "diagnostics.h"
+#include "interner.h"
+#include "lexer_rules.h"
+#include "lexer_tables.h"
+#include "token.h"
+#include "token_buffer.h"
+#include "utils/number.h"
+#include "utils/unicode.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * FixedString
+ *
+ * A string literal as a template argument: `EmbeddedLexer::lex<"let x = 1;">()`. The
+ * terminating NUL is kept, so it is the lexer's end sentinel.
+ */
+template <size_t N> struct FixedString {
+    char data[N] = {};
+
+    consteval FixedString(const char (&str)[N]) {
+        for (size_t i = 0; i < N; i++) data[i] = str[i];
+    }
+    constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+};
+
+/**
+ * EmbeddedTokens
+ *
+ * The tokens of a script lexed at compile time, in arrays of exactly the size needed. As in
+ * a TokenBuffer, number tokens index the literal tables and identifier and string tokens
+ * hold SymbolIds, numbered in first-seen order like the Lexer's interner. Token spellings
+ * point into the script's template argument, so they are valid for the whole program.
+ */
+template <size_t Tokens, size_t Integers, size_t Floats, size_t Symbols, size_t NameBytes>
+struct EmbeddedTokens {
+    std::array<Token, Tokens> tokens{};
+    std::array<u128, Integers> integers{};
+    std::array<double, Floats> floats{};
+    std::array<uint32_t, Symbols + 1> name_offsets{};
+    std::array<char, NameBytes> name_bytes{};
+
+    constexpr size_t size() const { return Tokens; }
+    constexpr const Token &operator[](size_t idx) const { return tokens[idx]; }
+    constexpr auto begin() const { return tokens.begin(); }
+    constexpr auto end() const { return tokens.end(); }
+
+    constexpr size_t symbol_count() const { return Symbols; }
+    constexpr std::string_view name(SymbolId id) const {
+        return std::string_view(name_bytes.data() + name_offsets[id],
+                                name_offsets[id + 1] - name_offsets[id]);
+    }
+    constexpr u128 integer(const Token &token) const { return integers[token.value]; }
+    constexpr double floating(const Token &token) const { return floats[token.value]; }
+};
+
+// Instantiated with the first error of an embedded script, so the compiler's message names
+// its line, column and message
+template <uint32_t Line, uint32_t Column, Message What> struct EmbeddedLexerError {
+    static_assert(Line == 0, "Dove: lexer error in an embedded script (the template "
+                             "arguments of EmbeddedLexerError are its line, column and "
+                             "message)");
+};
+
+/**
+ * EmbeddedLexer
+ *
+ * The Lexer's rules (LexerRules) with scalar scans and vector storage, for Dove scripts
+ * embedded as string literals: lex<"...">() lexes a script during compilation into
+ * EmbeddedTokens, and an error in it is a compile error. It gives the same tokens, symbol
+ * ids, literal values and diagnostics as the Lexer; its results live only as long as the
+ * constant evaluation, so it is meant for small sources (the Lexer is the one for files).
+ *
+ * One limit: floating point literals of more than 15 digits need the Lexer's runtime
+ * fallback and do not compile in an embedded script.
+ */
+class EmbeddedLexer : private LexerRules<EmbeddedLexer> {
+private:
+    friend class LexerRules<EmbeddedLexer>;
+
+    std::vector<Token> tokens;
+    std::vector<u128> integers;
+    std::vector<double> floats;
+    std::vector<uint32_t> name_offsets{0};
+    std::vector<char> name_bytes;
+    std::vector<Diagnostic> diagnostics;
+
+    struct Counts {
+        size_t tokens, integers, floats, symbols, name_bytes;
+        Diagnostic first_error;
+        bool failed;
+    };
+
+    static constexpr Counts count(std::string_view source) {
+        EmbeddedLexer lexer(source);
+        return Counts{lexer.tokens.size(),
+                      lexer.integers.size(),
+                      lexer.floats.size(),
+                      lexer.symbol_count(),
+                      lexer.name_bytes.size(),
+                      lexer.diagnostics.empty() ? Diagnostic{} : lexer.diagnostics[0],
+                      !lexer.diagnostics.empty()};
+    }
+
+    // Scans, a byte at a time
+    static constexpr bool is_word(uint8_t ch) {
+        return static_cast<uint8_t>((ch | 0x20) - 'a') < 26u ||
+               static_cast<uint8_t>(ch - '0') < 10u || ch == '_';
+    }
+    constexpr void scan_whitespace() {
+        while (peek() == ' ' || peek() == '\t' || peek() == '\r') advance();
+    }
+    constexpr void scan_identifier() {
+        while (is_word(peek())) advance();
+    }
+    constexpr void scan_digits() {
+        while (static_cast<uint8_t>(peek() - '0') < 10u) advance();
+    }
+    constexpr void scan_quoted(uint8_t quote) {
+        while (peek() != quote && peek() != '\\' && peek() != '\n' && peek() != '\0') advance();
+    }
+    constexpr uint32_t first_invalid(uint32_t from, uint32_t to) const {
+        for (uint32_t offset = from; offset < to;) {
+            uint32_t codepoint;
+            uint8_t len = Unicode::read_unicode(source, offset, &codepoint);
+            if (len == 0) return offset;
+            offset += len;
+        }
+        return to;
+    }
+    static constexpr TokenType match_token_type(std::string_view str) {
+        return keyword_type(str);
+    }
+
+    constexpr void new_line() {
+        line++;
+        line_start = cursor;
+    }
+    constexpr uint32_t column_at(uint32_t offset) const {
+        uint32_t column = offset - line_start + 1;
+        for (uint32_t idx = line_start; idx < offset; idx++) {
+            column -= (static_cast<uint8_t>(source[idx]) & 0xC0) == 0x80;
+        }
+        return column;
+    }
+
+    // Storage
+    constexpr void push(TokenType type, uint32_t offset, uint32_t length, uint32_t value = 0) {
+        tokens.push_back(Token{.type = type,
+                               .value = value,
+                               .str = source.substr(offset, length),
+                               .line = line,
+                               .column = column_at(offset) - TokenBuffer::delimiter_width(type)});
+    }
+    constexpr SymbolId intern(std::string_view str) {
+        for (SymbolId id = 0; id < symbol_count(); id++) {
+            if (name(id) == str) return id;
+        }
+        name_bytes.insert(name_bytes.end(), str.begin(), str.end());
+        name_offsets.push_back(static_cast<uint32_t>(name_bytes.size()));
+        return static_cast<SymbolId>(symbol_count() - 1);
+    }
+    constexpr SymbolId intern_escaped(std::string_view str) {
+        // Decoded where a new name would go, and dropped again if it is not new
+        size_t start = name_bytes.size();
+        unescape(str, [this](char ch) { name_bytes.push_back(ch); });
+        std::string_view decoded(name_bytes.data() + start, name_bytes.size() - start);
+        for (SymbolId id = 0; id < symbol_count(); id++) {
+            if (name(id) == decoded) {
+                name_bytes.resize(start);
+                return id;
+            }
+        }
+        name_offsets.push_back(static_cast<uint32_t>(name_bytes.size()));
+        return static_cast<SymbolId>(symbol_count() - 1);
+    }
+    constexpr uint32_t add_integer(u128 value) {
+        integers.push_back(value);
+        return static_cast<uint32_t>(integers.size() - 1);
+    }
+    constexpr uint32_t add_float(double value) {
+        floats.push_back(value);
+        return static_cast<uint32_t>(floats.size() - 1);
+    }
+    constexpr void report(const Diagnostic &diagnostic) { diagnostics.push_back(diagnostic); }
+    constexpr size_t reported() const { return diagnostics.size(); }
+
+public:
+    // `source` must be followed by a readable NUL byte, as for the Lexer
+    explicit constexpr EmbeddedLexer(std::string_view source) : LexerRules(source) {
+        if (!validate(0, static_cast<uint32_t>(source.length()))) return;
+        while (!finished && cursor < source.length()) dispatch();
+    }
+
+    // Lex `Source` during compilation; an error in it fails the compilation
+    template <FixedString Source> static consteval auto lex() {
+        constexpr Counts counts = count(Source.view());
+        if constexpr (counts.failed) {
+            constexpr Diagnostic error = counts.first_error;
+            EmbeddedLexerError<error.line, error.column, error.message> failed;
+            (void)failed;
+            return EmbeddedTokens<0, 0, 0, 0, 0>{};
+        } else {
+            EmbeddedLexer lexer(Source.view());
+            EmbeddedTokens<counts.tokens, counts.integers, counts.floats, counts.symbols,
+                           counts.name_bytes>
+                out;
+            for (size_t i = 0; i < counts.tokens; i++) out.tokens[i] = lexer.tokens[i];
+            for (size_t i = 0; i < counts.integers; i++) out.integers[i] = lexer.integers[i];
+            for (size_t i = 0; i < counts.floats; i++) out.floats[i] = lexer.floats[i];
+            for (size_t i = 0; i <= counts.symbols; i++) {
+                out.name_offsets[i] = lexer.name_offsets[i];
+            }
+            for (size_t i = 0; i < counts.name_bytes; i++) out.name_bytes[i] = lexer.name_bytes[i];
+            return out;
+        }
+    }
+
+    constexpr const std::vector<Token> &get_tokens() const { return tokens; }
+    constexpr const std::vector<u128> &get_integers() const { return integers; }
+    constexpr const std::vector<double> &get_floats() const { return floats; }
+    constexpr const std::vector<Diagnostic> &get_diagnostics() const { return diagnostics; }
+    constexpr size_t symbol_count() const { return name_offsets.size() - 1; }
+    constexpr std::string_view name(SymbolId id) const {
+        return std::string_view(name_bytes.data() + name_offsets[id],
+                                name_offsets[id + 1] - name_offsets[id]);
+    }
+};
+
+} // namespace Dove
\ No newline at end of file
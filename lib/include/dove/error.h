@@ -15,11 +15,40 @@ enum class LexerError {
     StringNotTerminated,
     EmptyCharacterLiteral,
     ExpectedCharNotString,
+    CharacterNotTerminated,
+    InvalidNumberLiteral,
+    IntegerOverflow,
+    FloatOutOfRange,
+    InvalidEscapeSequence,
+    InvalidUtf8,
 };
 
-enum class ParserError {};
+enum class ParserError {
+    UnexpectedToken,
+    ExpectedExpression,
+    ExpectedType,
+    ExpectedItem,
+    InvalidAssignmentTarget,
+};
+
+enum class CompileError {
+    UnknownName,
+    TypeMismatch,
+    InvalidOperation,
+    ArgumentCount,
+    OutOfRange,
+    MissingFallback,
+    MissingMain,
+    Unsupported,
+    TooManyRegisters,
+};
 
-using ErrorType = std::variant<LexerError, ParserError>;
+enum class RuntimeError {
+    DivisionByZero,
+    StackOverflow,
+};
+
+using ErrorType = std::variant<LexerError, ParserError, CompileError, RuntimeError>;
 
 class CompilerError {
 private:
@@ -32,9 +61,11 @@ private:
         return std::visit(
             [](auto &&err) -> uint16_t {
                 using T = std::decay_t<decltype(err)>;
-                constexpr uint16_t phase_offset = std::is_same_v<T, LexerError>    ? 1000
-                                                  : std::is_same_v<T, ParserError> ? 2000
-                                                                                   : 9000;
+                constexpr uint16_t phase_offset = std::is_same_v<T, LexerError>     ? 1000
+                                                  : std::is_same_v<T, ParserError>  ? 2000
+                                                  : std::is_same_v<T, CompileError> ? 3000
+                                                  : std::is_same_v<T, RuntimeError> ? 4000
+                                                                                    : 9000;
                 return phase_offset + static_cast<uint16_t>(err);
             },
             type);
@@ -44,10 +75,14 @@ public:
     CompilerError(ErrorType type, uint32_t line, uint32_t column, std::string message)
         : type(type), line(line), column(column), message(std::move(message)) {}
 
-    std::unexpected<CompilerError> unexpected() const {
+    std::unexpected<CompilerError> unexpected() const & {
         return std::unexpected<CompilerError>(
             CompilerError{type, line, column, message});
     }
+    // A temporary moves its message instead of copying it
+    std::unexpected<CompilerError> unexpected() && {
+        return std::unexpected<CompilerError>(std::move(*this));
+    }
 
     std::string format() const {
         return std::format("[E{:04d}] {}:{}: {}", error_code(), line, column, message);
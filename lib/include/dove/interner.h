@@ -0,0 +1,65 @@
+#pragma once
+
+#include "utils/arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+// Dense index of an interned name, in first-seen order
+using SymbolId = uint32_t;
+
+/**
+ * Interner
+ *
+ * Maps identifier and string spellings to dense `SymbolId`s so later stages compare names
+ * as integers and keep per-symbol data in flat arrays. Spellings are copied into an arena;
+ * lookups go through an open-addressing table (linear probing, at most half full) that
+ * stores the 32-bit hash next to the id, so a probe only touches the bytes on a hash match.
+ *
+ * An interner is not thread-safe. Parallel lexing gives every chunk its own interner and
+ * merges them in source order with `absorb()`, which yields the same ids as a serial run.
+ */
+class Interner {
+private:
+    struct Slot {
+        uint32_t hash;
+        uint32_t id; // id + 1, 0 for an empty slot
+    };
+
+    Arena arena;
+    std::vector<std::string_view> names;
+    std::vector<uint32_t> hashes;
+    std::vector<Slot> slots;
+
+    void grow();
+    void erase_slot(size_t idx);
+
+public:
+    static constexpr SymbolId none = UINT32_MAX;
+
+    Interner();
+
+    static uint32_t hash(std::string_view str);
+
+    SymbolId intern(std::string_view str) { return intern(str, hash(str)); }
+    // `hash` must be hash(str)
+    SymbolId intern(std::string_view str, uint32_t hash);
+    // `none` if `str` was never interned
+    SymbolId find(std::string_view str) const;
+
+    std::string_view name(SymbolId id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+
+    // Forget every symbol from `count` on (used to roll back speculative lexing)
+    void truncate(size_t count);
+    // Forget every symbol, keeping the memory for the next names
+    void clear();
+    // Intern all of `other`'s names in id order; returns the new id of each of its ids
+    std::vector<SymbolId> absorb(const Interner &other);
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -1,48 +1,138 @@
 #pragma once
 
+#include "diagnostics.h"
 #include "error.h"
+#include "interner.h"
+#include "lexer_rules.h"
+#include "metrics.h"
 #include "token.h"
+#include "token_buffer.h"
 
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 #include <expected>
 
 namespace Dove {
 
-class Lexer {
+class ThreadPool;
+class TokenBatch;
+class TokenCache;
+class TokenPipeline;
+class TokenStream;
+
+class Lexer : private LexerRules<Lexer> {
 private:
-    const std::string_view source;
-    std::vector<Token> tokens;
-    std::optional<CompilerError> error;
-    uint32_t cursor;
-    uint32_t line;
-    uint32_t column;
+    friend class LexerRules<Lexer>;
+    friend class TokenPipeline;
+    friend class TokenStream;
+
+    struct Deferred {};
+
+    // Bytes the lexer may inspect past the end of a token before the token is final (one
+    // UTF-8 sequence)
+    static constexpr uint32_t lookahead = 4;
+
+    TokenBuffer tokens;
+    Interner interner;
+    std::vector<Token> token_views; // materialized on demand by get_tokens()
+    Diagnostics diagnostics;
+    TokenBuffer edit_tokens;        // edit()'s scratch: the tokens it lexes, then the old ones
+    Diagnostics edit_diagnostics;   // edit()'s scratch: old diagnostics past its restart
+    std::string unescaped;          // intern_escaped()'s scratch, kept for the next literal
+    uint32_t line_skew; // continuation bytes of the current line a stream has discarded
+    bool ascii;         // no byte >= 0x80 so far, so columns are byte offsets
+    DOVE_METRIC(Metrics metrics = new_metrics();)
+
+    // Set up without lexing (driven by TokenStream and parallel())
+    Lexer(std::string_view source, Deferred);
+    // Empty metrics with the lexer's slot names
+    DOVE_METRIC(static Metrics new_metrics();)
 
-    std::expected<void, CompilerError> start();
+    // Point at `source` with no tokens, symbols or diagnostics, keeping every buffer's
+    // capacity
+    void rewind(std::string_view source);
+    // Validate and lex all of `source`
+    void lex_all();
+    void start();
+    // dispatch() with instrumentation
+    void lex_next();
 
     // Movement
-    void advance();
-    uint8_t peek();
     uint8_t peek_prev(uint32_t n = 1);
-    uint8_t peek_next(uint32_t n = 1);
     void new_line();
+    // 1-based, in code points, of `offset` on the current line
+    uint32_t column_at(uint32_t offset) const;
+    Diagnostic invalid_utf8(uint32_t offset) const;
+    // First diagnostic as an error, for the std::expected API
+    std::unexpected<CompilerError> first_error() const;
 
-    // Handlers
-    std::expected<void, CompilerError> handle_identifier();
-    std::expected<void, CompilerError> handle_string();
-    std::expected<void, CompilerError> handle_character();
-    std::expected<void, CompilerError> handle_number();
-    void handle_comment();
+    // Scans (SIMD, see utils/scan.h)
+    void scan_whitespace();
+    void scan_identifier();
+    void scan_digits();
+    void scan_quoted(uint8_t quote);
+    uint32_t first_invalid(uint32_t from, uint32_t to);
+
+    // Storage
+    void push(TokenType type, uint32_t offset, uint32_t length, uint32_t value = 0);
+    SymbolId intern(std::string_view str);
+    SymbolId intern_escaped(std::string_view str);
+    uint32_t add_integer(u128 value);
+    uint32_t add_float(double value);
+    void report(const Diagnostic &diagnostic);
+    size_t reported() const;
 
     // Checker
     TokenType match_token_type(std::string_view str);
 
 public:
+    // `source` must be followed by a readable NUL byte, which the lexer uses as its end
+    // sentinel: std::string, string literals and SourceManager buffers all guarantee this.
+    // It is validated as UTF-8 before lexing; identifiers may use XID_Start/XID_Continue.
+    // Lexing goes on after an error, so the diagnostics cover the whole source; only
+    // invalid UTF-8 stops it before it starts.
     explicit Lexer(std::string_view source);
+    // No source yet; for reset(), lex_into() and lex_batch()
+    Lexer();
+
+    // Lazy, constant-memory alternative to the constructor
+    static TokenStream stream(std::string_view source);
+    // Replay the cached tokens of `source`; on a miss, lex it and store the result first
+    static TokenStream stream(std::string_view source, const TokenCache &cache);
+    // Lex newline-aligned chunks on `pool`; the result is identical to Lexer(source)
+    static Lexer parallel(std::string_view source, ThreadPool &pool, size_t chunk_size = 0);
+
+    // Replace `length` bytes at `offset` of `text`, the source this lexer was built over, with
+    // `replacement`. Only the tokens the edit can reach are lexed again: from the last token
+    // boundary before it until the new tokens line up with the old ones. The result is
+    // identical to Lexer(text), except that symbol ids stay stable across edits.
+    std::expected<void, CompilerError> edit(std::string &text, uint32_t offset, uint32_t length,
+                                            std::string_view replacement);
+
+    // Lex `source` from scratch as Lexer(source) would, reusing this lexer's buffers: once
+    // they have grown to fit, lexing inputs of similar size allocates nothing
+    std::expected<void, CompilerError> reset(std::string_view source);
+    // reset() into `out`, a caller-owned buffer that keeps its capacity across calls; symbol
+    // ids refer to this lexer's interner. Leaves this lexer's own buffer empty.
+    std::expected<void, CompilerError> lex_into(std::string_view source, TokenBuffer &out);
+    // Lex every source into `out` (refilled, keeping its capacity); errors are per source.
+    // Leaves this lexer empty.
+    void lex_batch(std::span<const std::string_view> sources, TokenBatch &out);
 
+    // Every error found, in source order
+    const Diagnostics &get_diagnostics() const { return diagnostics; }
+    // Token views for existing callers (built from the token buffer on first call). Both
+    // give the first diagnostic instead if there is one.
     std::expected<const std::vector<Token> *, CompilerError> get_tokens();
+    std::expected<const TokenBuffer *, CompilerError> get_token_buffer() const;
+    // Names behind the `value` of identifier and string tokens
+    const Interner &get_interner() const { return interner; }
+    // Time and bytes per handler, tokens per kind, keyword lookups and buffer growth
+    DOVE_METRIC(const Metrics &get_metrics() const { return metrics; })
 };
 
 } // namespace Dove
\ No newline at end of file
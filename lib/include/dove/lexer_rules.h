@@ -0,0 +1,469 @@
+#pragma once
+
+#include "diagnostics.h"
+#include "interner.h"
+#include "lexer_tables.h"
+#include "token.h"
+#include "utils/number.h"
+#include "utils/unicode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+namespace Dove {
+
+/**
+ * LexerRules
+ *
+ * How Dove source becomes tokens, written once as constexpr code for the runtime Lexer and
+ * the constant-evaluated EmbeddedLexer: the dispatch on the byte at the cursor, the handlers,
+ * escapes, literal decoding, keyword and operator matching, diagnostics and error recovery.
+ * It owns the cursor and what it is inside of; `Derived` decides how runs of bytes are
+ * scanned and where the results go, through these members:
+ *
+ *   scan_whitespace(), scan_identifier(), scan_digits(), scan_quoted(quote)
+ *       move the cursor past a run of ' ' '\t' '\r', of [A-Za-z0-9_], of digits, or of bytes
+ *       other than `quote`, '\\', '\n' and NUL
+ *   first_invalid(from, to)   the offset of the first invalid UTF-8 byte, or `to`
+ *   match_token_type(str)     the keyword `str` spells, or ValueIdentifier
+ *   push(type, offset, length, value), intern(str), add_integer(value), add_float(value)
+ *   intern_escaped(str)       intern what a string literal's contents decode to, decoding
+ *                             them with unescape() into storage of its own
+ *   report(diagnostic), reported()   record a diagnostic, and how many there are
+ *   new_line(), column_at(offset)    at the cursor, and 1-based on the current line
+ */
+template <typename Derived> class LexerRules {
+protected:
+    // What the cursor is inside of; comments can be suspended at the end of a streamed window
+    enum class Mode : uint8_t {
+        Code,
+        LineComment,
+        BlockComment,
+    };
+
+    std::string_view source;
+    uint32_t cursor = 0;
+    uint32_t line = 1;
+    uint32_t line_start = 0;
+    Mode mode = Mode::Code;
+    bool finished = false;    // hit a NUL byte
+    bool end_of_input = true; // false while a stream may still append to `source`
+
+    constexpr explicit LexerRules(std::string_view source) : source(source) {}
+
+    // Pass each byte the contents of a string literal decode to (its escapes checked) to `put`
+    template <typename Put> static constexpr void unescape(std::string_view value, Put &&put) {
+        for (size_t i = 0; i < value.length(); i++) {
+            uint8_t ch = value[i];
+            if (ch == '\\') ch = escape_table[static_cast<uint8_t>(value[++i])];
+            put(static_cast<char>(ch));
+        }
+    }
+
+    constexpr Derived &self() { return static_cast<Derived &>(*this); }
+    constexpr const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+    // The source is followed by a NUL sentinel (see Lexer), so peek()/peek_next() read it at
+    // the end instead of checking bounds, and every handler stops on it before advancing past.
+    constexpr void advance(uint32_t n = 1) { cursor += n; }
+    constexpr uint8_t peek() const { return static_cast<uint8_t>(source.data()[cursor]); }
+    constexpr uint8_t peek_next(uint32_t n = 1) const {
+        return static_cast<uint8_t>(source.data()[cursor + n]);
+    }
+
+    // At `offset` on the current line
+    constexpr Diagnostic diagnostic(Message message, uint32_t offset, uint32_t arg0 = 0,
+                                    uint32_t arg1 = 0) const {
+        return Diagnostic{offset, line, self().column_at(offset), {arg0, arg1}, message};
+    }
+
+    // Report every invalid UTF-8 sequence in [from, to); false if there was one
+    constexpr bool validate(uint32_t from, uint32_t to) {
+        uint32_t invalid = self().first_invalid(from, to);
+        if (invalid == to) [[likely]] {
+            return true;
+        }
+
+        // Report each malformed sequence once (with its stray continuation bytes), moving the
+        // position along so every line is only counted once
+        uint32_t saved_cursor = cursor, saved_line = line, saved_line_start = line_start;
+        while (invalid != to) {
+            for (; cursor < invalid; cursor++) {
+                if (source[cursor] == '\n') {
+                    line++;
+                    line_start = cursor + 1;
+                }
+            }
+            self().report(diagnostic(Message::InvalidUtf8Byte, invalid,
+                                     static_cast<uint8_t>(source[invalid])));
+
+            uint32_t next = invalid + 1;
+            while (next != to && (static_cast<uint8_t>(source[next]) & 0xC0) == 0x80) next++;
+            invalid = self().first_invalid(next, to);
+        }
+        cursor = saved_cursor, line = saved_line, line_start = saved_line_start;
+        return false;
+    }
+
+    // Consume one token, whitespace run, newline or comment. A lexeme a handler rejects
+    // becomes an Error token and lexing goes on after it.
+    constexpr void dispatch() {
+        if (mode != Mode::Code) {
+            continue_comment();
+            return;
+        }
+
+        uint8_t ch = peek();
+        if (ch == '\0') {
+            finished = true;
+            return;
+        }
+
+        uint32_t begin = cursor;
+        std::expected<void, Diagnostic> res;
+        switch (ch) {
+            case ' ':
+            case '\t':
+            case '\r': {
+                self().scan_whitespace();
+                break;
+            }
+            case '\n': {
+                advance();
+                self().new_line();
+                break;
+            }
+            case '/': {
+                if (peek_next() == '/' || peek_next() == '*') {
+                    handle_comment();
+                    break;
+                }
+                [[fallthrough]];
+            }
+            default: {
+                // Numbers (Integer || Floating Point)
+                if (static_cast<uint8_t>(ch - '0') < 10u) {
+                    res = handle_number();
+                }
+                // Identifiers && Keywords
+                else if (static_cast<uint8_t>((ch | 0x20) - 'a') < 26u || ch == '_') {
+                    res = handle_identifier();
+                }
+                // Unicode identifiers
+                else if (ch >= 0x80) {
+                    res = handle_unicode();
+                }
+                // Operators && Punctuation
+                else {
+                    res = handle_symbol();
+                }
+                break;
+            }
+            case '\'': {
+                res = handle_character();
+                break;
+            }
+            case '"': {
+                res = handle_string();
+                break;
+            }
+        }
+        if (!res) [[unlikely]] {
+            recover(begin, res.error());
+        }
+    }
+
+    // Turn [begin, cursor) into an Error token for `diagnostic`, skipping at least one code
+    // point
+    constexpr void recover(uint32_t begin, const Diagnostic &diagnostic) {
+        // Handlers stop at the end of what they could make sense of, which never crosses a line
+        if (cursor == begin) {
+            uint32_t codepoint;
+            uint8_t len = peek() < 0x80 ? 1 : Unicode::read_unicode(source, cursor, &codepoint);
+            advance(len ? len : 1);
+        }
+        self().push(TokenType::Error, begin, cursor - begin,
+                    static_cast<uint32_t>(self().reported()));
+        self().report(diagnostic);
+    }
+
+    // Handlers
+
+    constexpr std::expected<void, Diagnostic> handle_identifier() {
+        uint32_t start_idx = cursor;
+
+        // a-z, A-Z, 0-9, _ and, past ASCII, XID_Continue code points
+        while (true) {
+            self().scan_identifier();
+            if (peek() < 0x80) break;
+
+            uint32_t codepoint;
+            uint8_t len = Unicode::read_unicode(source, cursor, &codepoint);
+            if (len == 0 || !Unicode::is_xid_continue(codepoint)) break;
+            advance(len);
+        }
+
+        std::string_view value = source.substr(start_idx, cursor - start_idx);
+        TokenType type = self().match_token_type(value);
+
+        // The spelling was just scanned, so hashing it reads from L1
+        SymbolId symbol = type == TokenType::ValueIdentifier ? self().intern(value) : 0;
+        self().push(type, start_idx, static_cast<uint32_t>(value.length()), symbol);
+        return {};
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_unicode() {
+        uint32_t codepoint = 0;
+        uint8_t len = Unicode::read_unicode(source, cursor, &codepoint);
+        if (len != 0 && Unicode::is_xid_start(codepoint)) {
+            return handle_identifier();
+        }
+
+        // A sequence cut off by the end of a stream window is retried once more input arrives
+        return std::unexpected(diagnostic(Message::UnexpectedCodePoint, cursor, codepoint));
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_string() {
+        uint32_t start_idx = cursor;
+        bool escaped = false;
+        size_t reported = self().reported();
+
+        advance(); // "
+        while (true) {
+            self().scan_quoted('"');
+
+            uint8_t ch = peek();
+            if (ch == '"') {
+                break;
+            } else if (ch == '\\' && peek_next() != '\n' && peek_next() != '\0') {
+                check_escape();
+                escaped = true;
+                advance(2);
+                continue;
+            }
+            return std::unexpected(diagnostic(Message::StringNotTerminated, start_idx));
+        }
+
+        // Unknown escapes were reported; the literal as a whole is the error token
+        if (self().reported() != reported) [[unlikely]] {
+            advance(); // "
+            self().push(TokenType::Error, start_idx, cursor - start_idx,
+                        static_cast<uint32_t>(reported));
+            return {};
+        }
+
+        // Without escapes the contents are the spelling; otherwise they are decoded once,
+        // where `Derived` keeps its names
+        std::string_view value = source.substr(start_idx + 1, cursor - start_idx - 1);
+        SymbolId symbol = escaped ? self().intern_escaped(value) : self().intern(value);
+        self().push(TokenType::ValueString, start_idx + 1, static_cast<uint32_t>(value.length()),
+                    symbol);
+        advance(); // "
+        return {};
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_character() {
+        uint32_t start_idx = cursor;
+        size_t reported = self().reported();
+
+        advance(); // '
+        uint8_t ch = peek();
+        uint32_t value = ch;
+        if (ch == '\'') {
+            advance(); // '
+            return std::unexpected(diagnostic(Message::EmptyCharacter, start_idx));
+        } else if (ch == '\\' && peek_next() != '\n' && peek_next() != '\0') {
+            check_escape();
+            value = escape_table[peek_next()];
+            advance(2);
+        } else if (ch >= 0x80) {
+            // One code point, however many bytes it takes
+            uint8_t len = Unicode::read_unicode(source, cursor, &value);
+            advance(len ? len : 1);
+        } else if (ch != '\n' && ch != '\0' && ch != '\\') {
+            advance();
+        }
+
+        if (peek() != '\'') {
+            // Find out whether this is a longer literal or a missing quote
+            while (true) {
+                self().scan_quoted('\'');
+                if (peek() != '\\' || peek_next() == '\n' || peek_next() == '\0') break;
+                advance(2);
+            }
+            if (peek() == '\'') {
+                advance(); // '
+                return std::unexpected(diagnostic(Message::ExpectedCharNotString, start_idx));
+            }
+            return std::unexpected(diagnostic(Message::CharacterNotTerminated, start_idx));
+        }
+
+        if (self().reported() != reported) [[unlikely]] {
+            advance(); // '
+            self().push(TokenType::Error, start_idx, cursor - start_idx,
+                        static_cast<uint32_t>(reported));
+            return {};
+        }
+        self().push(TokenType::ValueCharacter, start_idx + 1, cursor - start_idx - 1, value);
+        advance(); // '
+        return {};
+    }
+
+    // At a backslash: reports it unless it starts a known escape sequence
+    constexpr bool check_escape() {
+        if (escape_table[peek_next()] == 0) [[unlikely]] {
+            self().report(diagnostic(Message::UnknownEscape, cursor, peek_next()));
+            return false;
+        }
+        return true;
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_number() {
+        uint32_t start_idx = cursor;
+
+        if (peek() == '0' && (peek_next() == 'b' || peek_next() == 'o' || peek_next() == 'x')) {
+            return handle_prefixed_number();
+        }
+
+        self().scan_digits();
+
+        // Fraction: a single '.' directly followed by a digit
+        if (peek() == '.' && static_cast<uint8_t>(peek_next() - '0') < 10u) {
+            advance();
+            self().scan_digits();
+
+            double value = 0;
+            if (!Number::floating(source.substr(start_idx, cursor - start_idx), &value)) {
+                return std::unexpected(diagnostic(Message::FloatOutOfRange, start_idx));
+            }
+            self().push(TokenType::ValueFloatingPointNumber, start_idx, cursor - start_idx,
+                        self().add_float(value));
+            return {};
+        }
+
+        u128 value = 0;
+        if (!Number::decimal(source.substr(start_idx, cursor - start_idx), &value)) {
+            return std::unexpected(diagnostic(Message::IntegerOverflow, start_idx));
+        }
+        self().push(TokenType::ValueInteger, start_idx, cursor - start_idx,
+                    self().add_integer(value));
+        return {};
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_prefixed_number() {
+        uint32_t start_idx = cursor;
+
+        uint32_t radix;
+        TokenType type;
+        switch (peek_next()) {
+            case 'b':
+                radix = 2, type = TokenType::PrefixBinary;
+                break;
+            case 'o':
+                radix = 8, type = TokenType::PrefixOctal;
+                break;
+            default:
+                radix = 16, type = TokenType::PrefixHexadecimal;
+                break;
+        }
+        advance(2);
+
+        // The literal runs to the end of the word, so `0b102` is one bad literal, not two tokens
+        uint32_t digits_idx = cursor;
+        self().scan_identifier();
+        std::string_view digits = source.substr(digits_idx, cursor - digits_idx);
+
+        if (digits.empty()) {
+            return std::unexpected(diagnostic(Message::MissingDigits, start_idx, radix));
+        }
+        for (size_t i = 0; i < digits.length(); i++) {
+            uint8_t digit = static_cast<uint8_t>(digits[i]);
+            if (!Number::is_digit(digit, radix)) {
+                return std::unexpected(diagnostic(
+                    Message::InvalidDigit, digits_idx + static_cast<uint32_t>(i), digit, radix));
+            }
+        }
+
+        u128 value = 0;
+        bool fits = radix == 2    ? Number::binary(digits, &value)
+                    : radix == 8  ? Number::octal(digits, &value)
+                                  : Number::hexadecimal(digits, &value);
+        if (!fits) {
+            return std::unexpected(diagnostic(Message::IntegerOverflow, start_idx));
+        }
+        self().push(type, start_idx, cursor - start_idx, self().add_integer(value));
+        return {};
+    }
+
+    constexpr std::expected<void, Diagnostic> handle_symbol() {
+        uint8_t state = 0;
+        uint32_t len = 0;
+        uint32_t match_len = 0;
+        TokenType type = TokenType::ValueIdentifier;
+
+        // Maximal munch: `===` is `==` `=`, `<<=` is `<<` `=`
+        while (uint8_t next = symbol_dfa.next[state][symbol_dfa.char_class[peek_next(len)]]) {
+            state = next;
+            len++;
+            if (symbol_dfa.accepting[state]) {
+                match_len = len;
+                type = symbol_dfa.accept[state];
+            }
+        }
+
+        if (match_len == 0) {
+            return std::unexpected(diagnostic(Message::UnexpectedByte, cursor, peek()));
+        }
+
+        self().push(type, cursor, match_len);
+        advance(match_len);
+        return {};
+    }
+
+    constexpr void handle_comment() {
+        mode = peek_next() == '/' ? Mode::LineComment : Mode::BlockComment;
+        advance(2);
+        continue_comment();
+    }
+
+    constexpr void continue_comment() {
+        if (mode == Mode::LineComment) {
+            while (cursor < source.length()) {
+                if (peek() == '\n' || peek() == '\0') {
+                    mode = Mode::Code;
+                    return;
+                }
+                advance();
+            }
+            return;
+        }
+
+        while (cursor + 1 < source.length()) {
+            if (peek() == '*' && peek_next() == '/') {
+                advance(2);
+                mode = Mode::Code;
+                return;
+            }
+            bool is_newline = peek() == '\n';
+            advance();
+            if (is_newline) {
+                self().new_line();
+            }
+        }
+
+        // A streamed window may end between '*' and '/', so the last byte is only consumed
+        // once there is no more input (an unterminated block comment runs to the end of the
+        // source).
+        if (end_of_input && cursor < source.length()) {
+            bool is_newline = peek() == '\n';
+            advance();
+            if (is_newline) {
+                self().new_line();
+            }
+        }
+    }
+};
+
+} // namespace Dove
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "token.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Tables of the lexer's rules, built at compile time from token.h and used by LexerRules
+// (lexer_rules.h), which both the runtime Lexer and the constant-evaluated EmbeddedLexer run
+
+namespace Dove {
+
+/**
+ * Operator DFA
+ *
+ * Generated at compile time from DOVE_SYMBOLS. Every byte maps to a character class and
+ * every state is a prefix of some spelling, so an operator is matched in one forward pass
+ * by following transitions until there is none and keeping the longest accepted prefix.
+ */
+struct SymbolSpec {
+    TokenType type;
+    std::string_view spelling;
+};
+
+inline constexpr SymbolSpec symbol_specs[] = {
+#define DOVE_SYMBOL_SPEC(name, spelling) {TokenType::name, spelling},
+    DOVE_SYMBOLS(DOVE_SYMBOL_SPEC)
+#undef DOVE_SYMBOL_SPEC
+};
+
+consteval size_t symbol_dfa_states() {
+    size_t states = 1; // root
+    for (const auto &spec : symbol_specs) states += spec.spelling.length();
+    return states;
+}
+
+struct SymbolDfa {
+    static constexpr size_t max_states = symbol_dfa_states();
+    static constexpr size_t max_classes = 64;
+
+    uint8_t char_class[256] = {};               // 0 = not part of any operator
+    uint8_t next[max_states][max_classes] = {}; // 0 = no transition (root is never a target)
+    TokenType accept[max_states] = {};
+    bool accepting[max_states] = {};
+};
+
+consteval SymbolDfa build_symbol_dfa() {
+    SymbolDfa dfa;
+    uint8_t classes = 1;
+    uint8_t states = 1;
+
+    for (const auto &spec : symbol_specs) {
+        uint8_t state = 0;
+        for (char c : spec.spelling) {
+            uint8_t &cls = dfa.char_class[static_cast<uint8_t>(c)];
+            if (!cls) cls = classes++;
+            if (classes > SymbolDfa::max_classes) {
+                throw "DOVE_SYMBOLS: too many operator characters";
+            }
+
+            uint8_t &next = dfa.next[state][cls];
+            if (!next) next = states++;
+            state = next;
+        }
+        if (dfa.accepting[state]) throw "DOVE_SYMBOLS: duplicate spelling";
+        dfa.accept[state] = spec.type;
+        dfa.accepting[state] = true;
+    }
+    return dfa;
+}
+
+inline constexpr SymbolDfa symbol_dfa = build_symbol_dfa();
+
+/**
+ * Keyword perfect hash
+ *
+ * Generated at compile time from DOVE_KEYWORDS. Every keyword fits in 8 bytes, so a
+ * candidate is loaded as one zero-padded word, hashed with a multiply-shift whose seed is
+ * searched at compile time until no two keywords collide, and confirmed with a single
+ * word compare. A length + first-character prefilter rejects most identifiers before that.
+ */
+struct KeywordSpec {
+    TokenType type;
+    std::string_view spelling;
+};
+
+inline constexpr KeywordSpec keyword_specs[] = {
+#define DOVE_KEYWORD_SPEC(name, spelling) {TokenType::name, spelling},
+    DOVE_KEYWORDS(DOVE_KEYWORD_SPEC)
+#undef DOVE_KEYWORD_SPEC
+};
+
+constexpr uint64_t keyword_word(std::string_view str) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < str.length(); i++) {
+        uint64_t byte = static_cast<uint8_t>(str[i]);
+        word |= std::endian::native == std::endian::little ? byte << (8 * i)
+                                                           : byte << (8 * (7 - i));
+    }
+    return word;
+}
+
+struct KeywordTable {
+    static constexpr uint32_t bits = 7;
+    static constexpr uint32_t slots = 1u << bits;
+
+    uint64_t seed = 0;
+    uint32_t min_len = 8;
+    uint32_t max_len = 0;
+    uint64_t first_chars[4] = {}; // 256-bit set of leading bytes
+    uint64_t words[slots] = {};   // 0 = empty slot
+    TokenType types[slots] = {};
+
+    constexpr uint32_t slot(uint64_t word) const {
+        return static_cast<uint32_t>((word * seed) >> (64 - bits));
+    }
+};
+
+consteval KeywordTable build_keyword_table() {
+    KeywordTable table;
+    for (const auto &spec : keyword_specs) {
+        if (spec.spelling.empty() || spec.spelling.length() > 8) {
+            throw "DOVE_KEYWORDS: spellings must be 1-8 bytes";
+        }
+        uint32_t len = spec.spelling.length();
+        uint8_t first = spec.spelling[0];
+        table.min_len = len < table.min_len ? len : table.min_len;
+        table.max_len = len > table.max_len ? len : table.max_len;
+        table.first_chars[first >> 6] |= uint64_t{1} << (first & 63);
+    }
+
+    // Odd multipliers from a fixed LCG until every keyword lands in its own slot
+    for (uint64_t state = 0x9E3779B97F4A7C15;; state = state * 6364136223846793005 + 1) {
+        KeywordTable candidate = table;
+        candidate.seed = state | 1;
+
+        bool perfect = true;
+        for (const auto &spec : keyword_specs) {
+            uint64_t word = keyword_word(spec.spelling);
+            uint32_t slot = candidate.slot(word);
+            if (candidate.words[slot]) {
+                perfect = false;
+                break;
+            }
+            candidate.words[slot] = word;
+            candidate.types[slot] = spec.type;
+        }
+        if (perfect) return candidate;
+    }
+}
+
+inline constexpr KeywordTable keyword_table = build_keyword_table();
+
+// The keyword spelled `str`, or ValueIdentifier (the Lexer has a faster, word-loading
+// version of this for its hot path)
+constexpr TokenType keyword_type(std::string_view str) {
+    if (str.empty() || str.length() < keyword_table.min_len ||
+        str.length() > keyword_table.max_len) {
+        return TokenType::ValueIdentifier;
+    }
+    uint64_t word = keyword_word(str);
+    uint32_t slot = keyword_table.slot(word);
+    return keyword_table.words[slot] == word ? keyword_table.types[slot]
+                                             : TokenType::ValueIdentifier;
+}
+
+/**
+ * Escape Table
+ *
+ * Byte after a backslash -> the byte it stands for, 0 if it is not an escape.
+ */
+inline constexpr std::array<uint8_t, 256> escape_table = [] {
+    std::array<uint8_t, 256> table{};
+    table['a'] = '\a';
+    table['b'] = '\b';
+    table['e'] = 0x1B;
+    table['f'] = '\f';
+    table['n'] = '\n';
+    table['r'] = '\r';
+    table['t'] = '\t';
+    table['v'] = '\v';
+    table['\\'] = '\\';
+    table['\''] = '\'';
+    table['"'] = '"';
+    table['?'] = '?';
+    return table;
+}();
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Instrumentation of the compiler phases is compiled in with DOVE_METRICS (`make METRICS=1`)
+// and is not there at all otherwise. It changes class layouts, so the library and all code
+// including its headers must be built with the same setting.
+#ifdef DOVE_METRICS
+#define DOVE_METRIC(...) __VA_ARGS__
+#else
+#define DOVE_METRIC(...)
+#endif
+
+namespace Dove {
+
+/**
+ * Metrics
+ *
+ * Measurements of one compiler phase in fixed, named slots, so recording is an indexed add:
+ * timed sections (calls, bytes, nanoseconds), counters, peak gauges and coarse trace events
+ * such as a whole run or a parallel chunk. A phase names its slots once; the metrics of its
+ * workers are combined with merge(). to_json() gives the totals and to_chrome_trace() the
+ * events for chrome://tracing or Perfetto.
+ */
+class Metrics {
+public:
+    struct Section {
+        uint64_t calls = 0;
+        uint64_t bytes = 0;
+        uint64_t nanoseconds = 0;
+    };
+
+    struct Event {
+        std::string_view name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        uint32_t thread;
+    };
+
+private:
+    std::string_view phase;
+    std::span<const std::string_view> section_names;
+    std::span<const std::string_view> counter_names;
+    std::span<const std::string_view> gauge_names;
+    std::vector<Section> sections;
+    std::vector<uint64_t> counters;
+    std::vector<uint64_t> gauges;
+    std::vector<Event> events;
+
+public:
+    // The names must outlive the metrics (static tables)
+    Metrics(std::string_view phase, std::span<const std::string_view> section_names,
+            std::span<const std::string_view> counter_names,
+            std::span<const std::string_view> gauge_names = {});
+
+    // Monotonic clock in nanoseconds
+    static uint64_t now();
+    // Small id of the calling thread, stable for its lifetime
+    static uint32_t thread_id();
+
+    void add(size_t section, uint64_t bytes, uint64_t nanoseconds) {
+        Section &entry = sections[section];
+        entry.calls++;
+        entry.bytes += bytes;
+        entry.nanoseconds += nanoseconds;
+    }
+    void count(size_t counter, uint64_t n = 1) { counters[counter] += n; }
+    void peak(size_t gauge, uint64_t value) {
+        gauges[gauge] = value > gauges[gauge] ? value : gauges[gauge];
+    }
+    // Record [start_ns, end_ns) on the calling thread
+    void event(std::string_view name, uint64_t start_ns, uint64_t end_ns);
+    // Add `other` (same phase): sections and counters are summed, gauges keep the highest
+    // value and events are appended
+    void merge(const Metrics &other);
+
+    std::string_view get_phase() const { return phase; }
+    const Section &section(size_t idx) const { return sections[idx]; }
+    uint64_t counter(size_t idx) const { return counters[idx]; }
+    uint64_t gauge(size_t idx) const { return gauges[idx]; }
+    // By name, std::nullopt if the phase has no such slot
+    std::optional<Section> find_section(std::string_view name) const;
+    std::optional<uint64_t> find_counter(std::string_view name) const;
+    std::optional<uint64_t> find_gauge(std::string_view name) const;
+    const std::vector<Event> &get_events() const { return events; }
+
+    std::string to_json() const;
+    // Trace Event Format ("X" events), one process, one track per thread
+    static std::string to_chrome_trace(std::span<const Metrics *const> metrics);
+};
+
+} // namespace Dove
\ No newline at end of file
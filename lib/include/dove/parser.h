@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ast.h"
+#include "diagnostics.h"
+#include "error.h"
+#include "token.h"
+#include "token_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <vector>
+
+namespace Dove {
+
+class ThreadPool;
+
+/**
+ * Parser
+ *
+ * Builds an Ast from a TokenBuffer: recursive descent for items, statements and types, and
+ * precedence climbing (Pratt) for expressions, with one table lookup per operator. Every
+ * node has a token of its own, so the node array is allocated once, for one node per
+ * token; lists are gathered on a scratch stack and copied into the extra array when they
+ * are complete. Nothing else is allocated while parsing.
+ *
+ * Like the lexer, the parser goes on after an error: it drops the statement or item it was
+ * in, skips to where the next one starts and reports every error in one pass.
+ *
+ * parallel() splits the tokens at the top-level item boundaries, parses runs of items on a
+ * thread pool and merges them in source order (see parser_parallel.cpp).
+ */
+class Parser {
+private:
+    const TokenBuffer &tokens;
+    uint32_t count;  // tokens, or the end of the range being parsed
+    uint32_t cursor; // from the start of that range
+    Ast ast;
+    Diagnostics diagnostics;
+    std::vector<NodeId> scratch; // elements of the lists being parsed
+    bool panicking = false;      // an error was reported and not recovered from yet
+
+    // Tokens; past the last one, peek() gives TokenType::Error
+    TokenType peek(uint32_t n = 0) const {
+        return cursor + n < count ? tokens.kind(cursor + n) : TokenType::Error;
+    }
+    bool at(TokenType type) const { return peek() == type; }
+    bool accept(TokenType type);
+    // Consume a `type` token or report that it is missing
+    bool expect(TokenType type);
+    // The token at the cursor as a diagnostic argument (token_type_count at the end). Past
+    // the end of a range it is the token that follows, as the whole-file parser would see.
+    uint32_t found() const;
+
+    // Nodes
+    NodeId add(NodeKind kind, uint32_t token, uint32_t lhs = 0, uint32_t rhs = 0,
+               TokenType op = {}, uint8_t flags = 0);
+    // Move the scratch entries from `from` on into a List operand
+    uint32_t add_list(size_t from);
+    uint32_t add_pair(NodeId first, NodeId second);
+    void reserve_extra(uint32_t n);
+
+    // Errors: report() at token `at` unless already panicking, then skip to the next
+    // statement or item with synchronize()
+    void report(Message message, uint32_t at, uint32_t arg0 = 0, uint32_t arg1 = 0);
+    void synchronize();
+
+    // Items
+    void parse_module();
+    NodeId parse_item();
+    NodeId parse_use();
+    NodeId parse_use_tree();
+    NodeId parse_obj();
+    NodeId parse_func();
+    NodeId parse_binding();
+
+    // Types
+    NodeId parse_type();
+
+    // Statements
+    NodeId parse_block();
+    NodeId parse_statement();
+    NodeId parse_if();
+    NodeId parse_match();
+    NodeId parse_arm();
+    NodeId parse_loop();
+    NodeId parse_while();
+    NodeId parse_for();
+
+    // Expressions: operators that bind tighter than `min_power` (see parser.cpp)
+    NodeId parse_expression(uint8_t min_power = 0);
+    NodeId parse_prefix();
+    NodeId parse_call(NodeId callee, uint32_t token);
+
+    // Set up over tokens [begin, end) without parsing (driven by parallel())
+    Parser(const TokenBuffer &tokens, uint32_t begin, uint32_t end);
+
+public:
+    // `tokens` must be free of lexer errors (see Lexer::get_token_buffer()) and outlive the
+    // parser and its Ast
+    explicit Parser(const TokenBuffer &tokens);
+
+    // Parse runs of top-level items of about `chunk_tokens` tokens on `pool`. Without errors
+    // the Ast is identical to that of Parser(tokens); errors are reported in source order,
+    // but an item is never recovered into the next one.
+    static Parser parallel(const TokenBuffer &tokens, ThreadPool &pool,
+                           size_t chunk_tokens = 0);
+
+    // Every error found, in source order
+    const Diagnostics &get_diagnostics() const { return diagnostics; }
+    // The tree, or the first diagnostic if there is one
+    std::expected<const Ast *, CompilerError> get_ast() const;
+    // Move the tree out; after errors it holds everything but the dropped statements and
+    // items
+    Ast take_ast() { return std::move(ast); }
+};
+
+} // namespace Dove
\ No newline at end of file
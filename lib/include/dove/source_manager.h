@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+using FileId = uint32_t;
+
+/**
+ * SourceManager
+ *
+ * Owns every source buffer of a compilation. Files are memory-mapped when possible and
+ * read once into a padded buffer otherwise. Every buffer is followed by at least `padding`
+ * readable NUL bytes, so the lexer can use the first one as its end sentinel and SIMD
+ * kernels may load a full vector past the last byte. Views stay valid for the lifetime
+ * of the manager, so tokens can point into them without copies.
+ */
+class SourceManager {
+private:
+    struct File {
+        std::string path;
+        std::string_view text;
+        void *mapping = nullptr; // mmap'd region (text + padding), or nullptr
+        size_t mapping_size = 0;
+        std::unique_ptr<char[]> buffer; // fallback storage
+    };
+
+    std::vector<File> files;
+
+    FileId add_buffer(std::string path, std::unique_ptr<char[]> buffer, size_t size);
+
+public:
+    static constexpr size_t padding = 64;
+
+    SourceManager() = default;
+    ~SourceManager();
+
+    SourceManager(const SourceManager &) = delete;
+    SourceManager &operator=(const SourceManager &) = delete;
+
+    // std::nullopt if the file can't be opened/read or is 4 GiB or larger (errno is kept)
+    std::optional<FileId> load(const std::string &path);
+    // Copies `contents` into a padded buffer
+    FileId add(std::string name, std::string_view contents);
+
+    std::string_view get_text(FileId id) const { return files[id].text; }
+    const std::string &get_path(FileId id) const { return files[id].path; }
+    size_t size() const { return files.size(); }
+};
+
+} // namespace Dove
\ No newline at end of file
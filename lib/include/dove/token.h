@@ -1,10 +1,99 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
 namespace Dove {
 
+/**
+ * Keywords
+ *
+ * X(TokenType, spelling) — primitive types and keywords. The lexer generates its keyword
+ * perfect hash from this list. Spellings must be at most 8 bytes long.
+ */
+#define DOVE_KEYWORDS(X)                \
+    X(TypeI8, "i8")                     \
+    X(TypeI16, "i16")                   \
+    X(TypeI32, "i32")                   \
+    X(TypeI64, "i64")                   \
+    X(TypeI128, "i128")                 \
+    X(TypeU8, "u8")                     \
+    X(TypeU16, "u16")                   \
+    X(TypeU32, "u32")                   \
+    X(TypeU64, "u64")                   \
+    X(TypeU128, "u128")                 \
+    X(TypeF64, "f64")                   \
+    X(TypeF128, "f128")                 \
+    X(TypeCh, "ch")                     \
+    X(TypeBool, "bool")                 \
+                                        \
+    X(KeywordLet, "let")                \
+    X(KeywordObj, "obj")                \
+    X(KeywordConst, "const")            \
+    X(KeywordFunc, "func")              \
+    X(KeywordUse, "use")                \
+    X(KeywordIf, "if")                  \
+    X(KeywordElse, "else")              \
+    X(KeywordElif, "elif")              \
+    X(KeywordMatch, "match")            \
+    X(KeywordIs, "is")                  \
+    X(KeywordFallback, "fallback")      \
+    X(KeywordLoop, "loop")              \
+    X(KeywordFor, "for")                \
+    X(KeywordIn, "in")                  \
+    X(KeywordWhile, "while")            \
+    X(KeywordBrk, "brk")                \
+    X(KeywordRtn, "rtn")                \
+    X(KeywordTrue, "true")              \
+    X(KeywordFalse, "false")
+
+/**
+ * Symbols
+ *
+ * X(TokenType, spelling) — the single source of truth for operators and punctuation.
+ * The lexer generates its operator DFA from this list, so adding an operator here needs
+ * no lexer changes. Comment openers are handled by the lexer and must not be listed.
+ */
+#define DOVE_SYMBOLS(X)                 \
+    X(SymbolAnd, "&&")                  \
+    X(SymbolAmpersand, "&")             \
+    X(SymbolOr, "||")                   \
+    X(SymbolVerticalBar, "|")           \
+    X(SymbolAssign, "=")                \
+    X(SymbolEqual, "==")                \
+    X(SymbolNot, "!")                   \
+    X(SymbolNotEqual, "!=")             \
+    X(SymbolPlus, "+")                  \
+    X(SymbolPlusEqual, "+=")            \
+    X(SymbolMinus, "-")                 \
+    X(SymbolMinusEqual, "-=")           \
+    X(SymbolArrow, "->")                \
+    X(SymbolAsterisk, "*")              \
+    X(SymbolAsteriskEqual, "*=")        \
+    X(SymbolSlash, "/")                 \
+    X(SymbolSlashEqual, "/=")           \
+    X(SymbolModulo, "%")                \
+    X(SymbolModuloEqual, "%=")          \
+    X(SymbolLess, "<")                  \
+    X(SymbolLessEqual, "<=")            \
+    X(SymbolShiftLeft, "<<")            \
+    X(SymbolGreater, ">")               \
+    X(SymbolGreaterEqual, ">=")         \
+    X(SymbolShiftRight, ">>")           \
+    X(SymbolColon, ":")                 \
+    X(SymbolDoubleColon, "::")          \
+    X(SymbolSemicolon, ";")             \
+    X(SymbolTilde, "~")                 \
+    X(SymbolDot, ".")                   \
+    X(SymbolComma, ",")                 \
+    X(SymbolLeftRoundBracket, "(")      \
+    X(SymbolRightRoundBracket, ")")     \
+    X(SymbolLeftSquareBracket, "[")     \
+    X(SymbolRightSquareBracket, "]")    \
+    X(SymbolLeftCurlyBracket, "{")      \
+    X(SymbolRightCurlyBracket, "}")
+
 /**
  * TokenType
  */
@@ -15,86 +104,55 @@ enum class TokenType : uint8_t {
     ValueString,
     ValueCharacter,
 
-    TypeI8,
-    TypeI16,
-    TypeI32,
-    TypeI64,
-    TypeI128,
-    TypeU8,
-    TypeU16,
-    TypeU32,
-    TypeU64,
-    TypeU128,
-    TypeF64,
-    TypeF128,
-    TypeCh,
-    TypeBool,
-
-    KeywordLet,
-    KeywordObj,
-    KeywordConst,
-    KeywordFunc,
-    KeywordUse,
-    KeywordIf,
-    KeywordElse,
-    KeywordElif,
-    KeywordMatch,
-    KeywordIs,
-    KeywordFallback,
-    KeywordLoop,
-    KeywordFor,
-    KeywordIn,
-    KeywordWhile,
-    KeywordBrk,
-    KeywordRtn,
-    KeywordTrue,
-    KeywordFalse,
+#define DOVE_TOKEN_ENUM_ENTRY(name, spelling) name,
+    DOVE_KEYWORDS(DOVE_TOKEN_ENUM_ENTRY)
 
-    SymbolAnd,
-    SymbolAmpersand,
-    SymbolOr,
-    SymbolVerticalBar,
-    SymbolAssign,
-    SymbolEqual,
-    SymbolNot,
-    SymbolNotEqual,
-    SymbolPlus,
-    SymbolPlusEqual,
-    SymbolMinus,
-    SymbolMinusEqual,
-    SymbolArrow,
-    SymbolAsterisk,
-    SymbolAsteriskEqual,
-    SymbolSlash,
-    SymbolSlashEqual,
-    SymbolModulo,
-    SymbolModuloEqual,
-    SymbolLess,
-    SymbolLessEqual,
-    SymbolShiftLeft,
-    SymbolGreater,
-    SymbolGreaterEqual,
-    SymbolShiftRight,
-    SymbolColon,
-    SymbolDoubleColon,
-    SymbolSemicolon,
-    SymbolTilde,
-    SymbolDot,
-    SymbolComma,
-    SymbolLeftRoundBracket,
-    SymbolRightRoundBracket,
-    SymbolLeftSquareBracket,
-    SymbolRightSquareBracket,
-    SymbolLeftCurlyBracket,
-    SymbolRightCurlyBracket,
+    DOVE_SYMBOLS(DOVE_TOKEN_ENUM_ENTRY)
+#undef DOVE_TOKEN_ENUM_ENTRY
 
+    // Integer literals written as 0b1010, 0o12 and 0xA (`str` includes the prefix)
     PrefixBinary,
     PrefixOctal,
     PrefixHexadecimal,
+
+    // A lexeme the lexer reported a diagnostic for (`value` is the index of the diagnostic)
+    Error,
 };
 
+constexpr size_t token_type_count = static_cast<size_t>(TokenType::Error) + 1;
+
+// The spelling of keywords and symbols; what the token is for the other kinds (for messages)
+constexpr std::string_view token_name(TokenType type) {
+    switch (type) {
+        case TokenType::ValueIdentifier:
+            return "identifier";
+        case TokenType::ValueInteger:
+        case TokenType::PrefixBinary:
+        case TokenType::PrefixOctal:
+        case TokenType::PrefixHexadecimal:
+            return "integer";
+        case TokenType::ValueFloatingPointNumber:
+            return "floating point number";
+        case TokenType::ValueString:
+            return "string";
+        case TokenType::ValueCharacter:
+            return "character";
+#define DOVE_TOKEN_NAME_CASE(name, spelling) \
+    case TokenType::name:                    \
+        return spelling;
+            DOVE_KEYWORDS(DOVE_TOKEN_NAME_CASE)
+            DOVE_SYMBOLS(DOVE_TOKEN_NAME_CASE)
+#undef DOVE_TOKEN_NAME_CASE
+        case TokenType::Error:
+            break;
+    }
+    return "invalid token";
+}
+
 struct Token {
     TokenType type;
+    uint32_t value; // SymbolId of identifiers and strings (decoded contents), literal index
+                    // of numbers (see TokenBuffer), the code point of characters
     std::string_view str;
     uint32_t line;
     uint32_t column;
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "diagnostics.h"
+#include "interner.h"
+#include "token.h"
+#include "token_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * TokenBatch
+ *
+ * The tokens of many small sources in one TokenBuffer, filled by Lexer::lex_batch(). The
+ * sources are copied back to back (each followed by a NUL byte) into one text the buffer
+ * refers to, so token offsets are into that text and `str()` works as usual. Source `i`
+ * owns the tokens in range(i) and the diagnostics in diagnostic_range(i), whose lines are
+ * its own; a source with invalid UTF-8 owns no tokens. Symbol ids are shared by the whole
+ * batch. Every member keeps its capacity when the batch is filled again, so a batch reused
+ * for inputs of similar size does not allocate.
+ */
+class TokenBatch {
+private:
+    friend class Lexer;
+
+    struct Entry {
+        uint32_t begin;            // offset in `text`
+        uint32_t first_token;      // index in `tokens`
+        uint32_t first_line;       // global line of its first line
+        uint32_t first_diagnostic; // index in `diagnostics`
+    };
+
+    std::string text;
+    TokenBuffer tokens;
+    Interner interner;
+    Diagnostics diagnostics;
+    std::vector<Entry> entries; // one per source, then one past the last
+
+    // Source owning token `idx`
+    size_t source_of(size_t idx) const;
+
+public:
+    size_t size() const { return entries.empty() ? 0 : entries.size() - 1; }
+
+    std::string_view source(size_t idx) const {
+        return std::string_view(text).substr(entries[idx].begin,
+                                             entries[idx + 1].begin - entries[idx].begin - 1);
+    }
+    // Token indices [first, last) of source `idx` in get_tokens()
+    std::pair<size_t, size_t> range(size_t idx) const {
+        return {entries[idx].first_token, entries[idx + 1].first_token};
+    }
+    // Diagnostic indices [first, last) of source `idx` in get_diagnostics()
+    std::pair<size_t, size_t> diagnostic_range(size_t idx) const {
+        return {entries[idx].first_diagnostic, entries[idx + 1].first_diagnostic};
+    }
+    bool failed(size_t idx) const {
+        return entries[idx].first_diagnostic != entries[idx + 1].first_diagnostic;
+    }
+
+    // Line and column within its own source
+    uint32_t line(size_t idx) const;
+    uint32_t column(size_t idx) const { return tokens.column(idx); }
+    Token token(size_t idx) const;
+
+    const TokenBuffer &get_tokens() const { return tokens; }
+    const Interner &get_interner() const { return interner; }
+    const Diagnostics &get_diagnostics() const { return diagnostics; }
+};
+
+} // namespace Dove
\ No newline at end of file
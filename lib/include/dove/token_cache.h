@@ -0,0 +1,112 @@
+#pragma once
+
+#include "interner.h"
+#include "token.h"
+#include "token_buffer.h"
+#include "utils/number.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Dove {
+
+/**
+ * CachedTokens
+ *
+ * A token cache entry mapped read-only and used in place: the accessors mirror TokenBuffer's
+ * but read straight from the mapped columns, so loading costs one mmap however many tokens
+ * there are. Symbol values index the entry's own name table, which lists the names in the
+ * id order of the lexer that stored it.
+ */
+class CachedTokens {
+private:
+    friend class TokenCache;
+
+    std::string_view source;
+    void *mapping = nullptr;
+    size_t mapping_size = 0;
+
+    std::span<const TokenType> kinds;
+    std::span<const uint32_t> offsets;
+    std::span<const uint16_t> lengths;
+    std::span<const std::pair<uint32_t, uint32_t>> long_lengths;
+    std::span<const uint32_t> values;
+    std::span<const u128> integers;
+    std::span<const double> floats;
+    std::span<const uint32_t> line_starts;
+    std::span<const uint32_t> name_offsets; // symbol count + 1 entries into `names`
+    const char *names = nullptr;
+    bool ascii = true;
+
+    CachedTokens() = default;
+
+public:
+    ~CachedTokens();
+    CachedTokens(CachedTokens &&other) noexcept;
+    CachedTokens &operator=(CachedTokens &&other) noexcept;
+
+    size_t size() const { return kinds.size(); }
+    bool empty() const { return kinds.empty(); }
+
+    TokenType kind(size_t idx) const { return kinds[idx]; }
+    uint32_t offset(size_t idx) const { return offsets[idx]; }
+    uint32_t length(size_t idx) const;
+    std::string_view str(size_t idx) const { return source.substr(offsets[idx], length(idx)); }
+    uint32_t value(size_t idx) const { return values[idx]; }
+    u128 integer(size_t idx) const { return integers[values[idx]]; }
+    double floating(size_t idx) const { return floats[values[idx]]; }
+
+    // 1-based, computed from the line table
+    uint32_t line(size_t idx) const;
+    uint32_t column(size_t idx) const;
+    uint32_t line_at(uint32_t offset) const;
+    uint32_t column_at(uint32_t offset) const;
+
+    Token token(size_t idx) const;
+
+    size_t symbol_count() const { return name_offsets.empty() ? 0 : name_offsets.size() - 1; }
+    std::string_view name(SymbolId id) const {
+        return std::string_view(names + name_offsets[id], name_offsets[id + 1] - name_offsets[id]);
+    }
+
+    std::string_view get_source() const { return source; }
+    std::span<const uint32_t> get_line_starts() const { return line_starts; }
+    std::span<const u128> get_integers() const { return integers; }
+    std::span<const double> get_floats() const { return floats; }
+};
+
+/**
+ * TokenCache
+ *
+ * Content-addressed on-disk cache of lexer output. An entry is keyed by the XXH64 hash of
+ * the source bytes and holds every TokenBuffer column, the line table, the decoded literals
+ * and the symbol names in one versioned file whose sections are aligned for their element
+ * types, so it can be mapped and read in place. Entries are written to a temporary file and
+ * renamed into place, so concurrent builds never see a partial entry. An entry written by
+ * another format version, another byte order or for other contents is a miss, and so is one
+ * whose body doesn't match the checksum in its header.
+ */
+class TokenCache {
+private:
+    std::string directory;
+
+public:
+    // Bump whenever the file layout or the lexer's output changes
+    static constexpr uint32_t version = 1;
+
+    explicit TokenCache(std::string directory);
+
+    static uint64_t key(std::string_view source);
+    std::string path(uint64_t key) const;
+
+    std::optional<CachedTokens> load(std::string_view source) const;
+    // Creates the directory if needed; false if the entry could not be written
+    bool store(std::string_view source, const TokenBuffer &tokens, const Interner &interner) const;
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "error.h"
+#include "interner.h"
+#include "lexer.h"
+#include "token.h"
+#include "utils/number.h"
+#include "utils/spsc_ring.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+
+namespace Dove {
+
+/**
+ * TokenBlock
+ *
+ * A fixed-size run of consecutive tokens, self-contained so it can be read on another
+ * thread: number tokens index the block's own literal tables (like TokenBuffer's) and the
+ * interned name of every identifier and string token is stored next to it.
+ */
+class TokenBlock {
+private:
+    friend class TokenPipeline;
+
+    uint32_t count = 0;
+    uint32_t integer_count = 0;
+    uint32_t float_count = 0;
+
+public:
+    static constexpr size_t capacity = 256;
+
+private:
+    std::array<Token, capacity> tokens;
+    std::array<std::string_view, capacity> names; // by token index, symbol tokens only
+    std::array<u128, capacity> integers;
+    std::array<double, capacity> floats;
+
+public:
+    size_t size() const { return count; }
+    std::span<const Token> get_tokens() const { return {tokens.data(), count}; }
+    const Token &operator[](size_t idx) const { return tokens[idx]; }
+
+    // Of identifier and string tokens: the name behind the SymbolId in `value`
+    std::string_view name(size_t idx) const { return names[idx]; }
+    u128 integer(const Token &token) const { return integers[token.value]; }
+    double floating(const Token &token) const { return floats[token.value]; }
+};
+
+/**
+ * TokenPipeline
+ *
+ * Lexes on a thread of its own while the caller consumes the tokens: the lexer fills
+ * TokenBlocks in place in an SpscRing and the consumer takes them in order with
+ * next_block(). A consumer that falls behind makes the lexer wait, so at most `blocks`
+ * blocks of tokens exist at any time however large the source is. The tokens and ids are
+ * the ones Lexer(source) gives; like a TokenStream, the pipeline stops at the first error.
+ */
+class TokenPipeline {
+private:
+    static constexpr size_t default_blocks = 16;
+
+    // Used by the lexing thread only, until it closes the ring
+    Lexer lexer;
+    std::optional<CompilerError> error;
+    uint32_t line = 1;       // of the last token handed over
+    uint32_t line_begin = 0; // offset of that line
+    uint32_t counted = 0;    // continuation bytes are counted up to here on that line
+    uint32_t skew = 0;       // and there are this many
+
+    SpscRing<TokenBlock> ring;
+    bool holding = false; // the consumer has not popped the front block yet
+    std::thread worker;
+
+    void produce();
+    // Lex the next tokens into `block`; false once there are no more
+    bool fill(TokenBlock &block);
+
+public:
+    // `source` must outlive the pipeline and be followed by a NUL byte (see Lexer)
+    explicit TokenPipeline(std::string_view source, size_t blocks = default_blocks);
+    // Stops the lexing thread if the tokens were not all consumed
+    ~TokenPipeline();
+
+    TokenPipeline(const TokenPipeline &) = delete;
+    TokenPipeline &operator=(const TokenPipeline &) = delete;
+
+    // The next block, waiting for the lexer if it is not ready; nullptr after the last one.
+    // A block is valid until the next call.
+    const TokenBlock *next_block();
+
+    // Only once next_block() returned nullptr: why lexing stopped early, if it did
+    const std::optional<CompilerError> &get_error() const { return error; }
+    // Only once next_block() returned nullptr; names are also in every block
+    const Interner &get_interner() const { return lexer.get_interner(); }
+};
+
+} // namespace Dove
\ No newline at end of file
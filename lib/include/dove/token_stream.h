@@ -0,0 +1,114 @@
+#pragma once
+
+#include "error.h"
+#include "lexer.h"
+#include "token.h"
+#include "token_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+// Writes up to `capacity` bytes into `buffer` and returns the count; 0 means end of input
+using ChunkReader = std::function<size_t(char *buffer, size_t capacity)>;
+
+/**
+ * TokenStream
+ *
+ * Pull-based lexing. Tokens are produced one at a time by next_token() (or by iterating
+ * the stream) and nothing is retained but the interned names, so memory is bounded by the
+ * number of distinct identifiers and strings. The input is either a complete source or a
+ * ChunkReader; in chunked mode only a sliding window of the input is kept, tokens and
+ * comments may straddle chunk boundaries, and a token's `str` is only valid until the next
+ * call (its `value` and the interner's names stay valid). A stream over a token cache entry
+ * replays the cached tokens without lexing.
+ */
+class TokenStream {
+private:
+    static constexpr size_t default_chunk_size = 64 * 1024;
+
+    Lexer lexer;
+    ChunkReader reader;
+    std::vector<char> window; // chunked mode only; NUL-terminated
+    size_t chunk_size;
+    size_t validated; // window bytes checked as UTF-8
+    std::optional<CompilerError> error;
+    std::optional<CachedTokens> cached;
+    size_t replayed = 0; // cached tokens returned so far
+
+    void refill();
+
+public:
+    class iterator {
+    private:
+        TokenStream *stream = nullptr;
+        Token current{};
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Token;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(TokenStream *stream) : stream(stream) { ++*this; }
+
+        const Token &operator*() const { return current; }
+        const Token *operator->() const { return &current; }
+
+        iterator &operator++() {
+            auto res = stream->next_token();
+            if (res && res.value()) {
+                current = *res.value();
+            } else {
+                stream = nullptr;
+            }
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const { return stream == nullptr; }
+    };
+
+    explicit TokenStream(std::string_view source);
+    explicit TokenStream(ChunkReader reader, size_t chunk_size = default_chunk_size);
+    // Replays `tokens`, a cache entry for `source`
+    TokenStream(std::string_view source, CachedTokens tokens);
+
+    TokenStream(const TokenStream &) = delete;
+    TokenStream &operator=(const TokenStream &) = delete;
+    TokenStream(TokenStream &&) = default;
+    TokenStream &operator=(TokenStream &&) = default;
+
+    // Reads chunks from a file descriptor (not closed by the stream)
+    static ChunkReader from_fd(int fd);
+
+    // The next token, or std::nullopt at the end of the input
+    std::expected<std::optional<Token>, CompilerError> next_token();
+
+    iterator begin() { return iterator(this); }
+    std::default_sentinel_t end() const { return {}; }
+
+    // Set once lexing stopped because of an error (iteration ends early)
+    const std::optional<CompilerError> &get_error() const { return error; }
+    // Names behind token values; ids are the same as the Lexer would assign
+    const Interner &get_interner() const { return lexer.get_interner(); }
+    // Of the underlying lexer; a replayed cache entry records nothing
+    DOVE_METRIC(const Metrics &get_metrics() const { return lexer.get_metrics(); })
+    // Decoded literal of the last number token returned (valid until the next call)
+    u128 get_integer(const Token &token) const {
+        return cached ? cached->get_integers()[token.value]
+                      : lexer.tokens.get_integers()[token.value];
+    }
+    double get_float(const Token &token) const {
+        return cached ? cached->get_floats()[token.value] : lexer.tokens.get_floats()[token.value];
+    }
+};
+
+} // namespace Dove
\ No newline at end of file
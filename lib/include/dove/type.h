@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Dove {
+
+/**
+ * TypeKind
+ *
+ * The static type of a value. The numeric kinds come first, integers in the order of the
+ * `TypeI8` … `TypeU128` tokens and then `f64`, so typed opcodes of a family are indexed by
+ * kind (see bytecode.h). Never is the type of `rtn` and `brk`, which produce no value and
+ * fit wherever a value is expected.
+ */
+enum class TypeKind : uint8_t {
+    I8,
+    I16,
+    I32,
+    I64,
+    I128,
+    U8,
+    U16,
+    U32,
+    U64,
+    U128,
+    F64,
+    Bool,
+    Ch,
+    Unit,
+    Never,
+    Obj,      // Type::detail is the object
+    Iterator, // Type::detail is the TypeKind of the elements
+    String,   // only as a format string
+};
+
+struct Type {
+    TypeKind kind = TypeKind::Never;
+    uint32_t detail = 0;
+
+    bool operator==(const Type &) const = default;
+
+    bool is_integer() const { return kind <= TypeKind::U128; }
+    bool is_signed() const { return kind <= TypeKind::I128; }
+    bool is_number() const { return kind <= TypeKind::F64; }
+    bool is_wide() const { return kind == TypeKind::I128 || kind == TypeKind::U128; }
+    // Ordered types: numbers and `ch`
+    bool is_ordered() const { return is_number() || kind == TypeKind::Ch; }
+    // Types whose values can be compared for equality
+    bool is_comparable() const { return is_ordered() || kind == TypeKind::Bool; }
+    uint32_t bits() const {
+        constexpr uint8_t bits[] = {8, 16, 32, 64, 128, 8, 16, 32, 64, 128, 64, 8, 8};
+        return kind <= TypeKind::Ch ? bits[static_cast<size_t>(kind)] : 64;
+    }
+};
+
+constexpr std::string_view type_name(TypeKind kind) {
+    constexpr std::string_view names[] = {"i8",  "i16",  "i32", "i64",  "i128", "u8",
+                                          "u16", "u32",  "u64", "u128", "f64",  "bool",
+                                          "ch",  "unit", "!",   "obj",  "iterator", "string"};
+    return names[static_cast<size_t>(kind)];
+}
+
+} // namespace Dove
\ No newline at end of file
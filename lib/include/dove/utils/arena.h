@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * Arena
+ *
+ * Bump allocator: allocations are carved out of large blocks and only released all at
+ * once, when the arena is reset or destroyed. Nothing is constructed or destroyed, so it is
+ * meant for trivially destructible data.
+ */
+class Arena {
+private:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    char *head = nullptr;
+    char *tail = nullptr;
+    size_t block_size;
+    size_t used = 0;
+
+    void *allocate_slow(size_t size, size_t align);
+
+public:
+    explicit Arena(size_t block_size = default_block_size) : block_size(block_size) {}
+
+    Arena(Arena &&) = default;
+    Arena &operator=(Arena &&) = default;
+
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        uintptr_t at = (reinterpret_cast<uintptr_t>(head) + align - 1) & ~(uintptr_t{align} - 1);
+        if (at + size > reinterpret_cast<uintptr_t>(tail)) [[unlikely]] {
+            return allocate_slow(size, align);
+        }
+        head = reinterpret_cast<char *>(at + size);
+        used += size;
+        return reinterpret_cast<void *>(at);
+    }
+
+    template <typename T> T *allocate_array(size_t count) {
+        return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    std::string_view copy(std::string_view str);
+
+    // Free everything for reuse. Several blocks are merged into one of their total size, so
+    // the next fill of the same size allocates nothing.
+    void reset();
+
+    size_t bytes_used() const { return used; }
+    size_t bytes_reserved() const;
+};
+
+} // namespace Dove
\ No newline at end of file
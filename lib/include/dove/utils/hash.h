@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Dove {
+
+/**
+ * Hash
+ *
+ * Content hashing for caches. `xxh64` is XXH64: 32 bytes per round in four independent
+ * lanes, so it runs at memory speed and is stable across runs, builds and hosts.
+ */
+class Hash {
+public:
+    static uint64_t xxh64(std::string_view data, uint64_t seed = 0);
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Dove {
+
+using u128 = unsigned __int128;
+using i128 = __int128;
+
+/**
+ * Number
+ *
+ * Decoders for the digits of numeric literals. Callers pass digits that were already
+ * validated for the radix (no prefix, no sign); the decoders only fail when the value does
+ * not fit. Integer literals are unsigned: a leading '-' is a separate token, and every
+ * `i128` magnitude (up to 2^127) fits in a `u128`.
+ */
+class Number {
+private:
+    static constexpr double exact_powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    static constexpr bool accumulate(std::string_view digits, uint32_t radix, u128 *out) {
+        u128 value = 0;
+        for (char ch : digits) {
+            uint8_t digit = static_cast<uint8_t>(ch);
+            uint32_t n = digit <= '9' ? digit - '0' : (digit | 0x20) - 'a' + 10;
+            if (value > (~u128{0} - n) / radix) return false;
+            value = value * radix + n;
+        }
+        *out = value;
+        return true;
+    }
+
+    // Runtime decoders (SWAR and std::from_chars)
+    static bool decode_decimal(std::string_view digits, u128 *out);
+    static bool decode_hexadecimal(std::string_view digits, u128 *out);
+    static bool decode_octal(std::string_view digits, u128 *out);
+    static bool decode_binary(std::string_view digits, u128 *out);
+    static bool decode_floating(std::string_view str, double *out);
+
+public:
+    static constexpr bool is_digit(uint8_t ch, uint32_t radix) {
+        if (static_cast<uint8_t>(ch - '0') < 10u) return static_cast<uint32_t>(ch - '0') < radix;
+        return radix == 16 && static_cast<uint8_t>((ch | 0x20) - 'a') < 6u;
+    }
+
+    // false on overflow past 2^128 - 1. Constant evaluation takes the digits one at a time.
+    static constexpr bool decimal(std::string_view digits, u128 *out) {
+        if consteval {
+            return accumulate(digits, 10, out);
+        }
+        return decode_decimal(digits, out);
+    }
+    static constexpr bool hexadecimal(std::string_view digits, u128 *out) {
+        if consteval {
+            return accumulate(digits, 16, out);
+        }
+        return decode_hexadecimal(digits, out);
+    }
+    static constexpr bool octal(std::string_view digits, u128 *out) {
+        if consteval {
+            return accumulate(digits, 8, out);
+        }
+        return decode_octal(digits, out);
+    }
+    static constexpr bool binary(std::string_view digits, u128 *out) {
+        if consteval {
+            return accumulate(digits, 2, out);
+        }
+        return decode_binary(digits, out);
+    }
+    // `str` is `digits.digits`; false if it is out of the range of a double. Only
+    // floating_exact() literals can be decoded in a constant expression.
+    static constexpr bool floating(std::string_view str, double *out) {
+        if (floating_exact(str, out)) return true;
+        if consteval {
+            throw "Dove: floating point literals of more than 15 digits cannot be decoded in a "
+                  "constant expression";
+        }
+        return decode_floating(str, out);
+    }
+    // The fast path of floating(), also usable in constant expressions: up to 15 digits are
+    // exact as a double, and so is 10^n for n <= 22, so one correctly rounded division gives
+    // the correctly rounded result. false if `str` has more digits.
+    static constexpr bool floating_exact(std::string_view str, double *out) {
+        size_t dot = str.find('.');
+        size_t fraction = str.length() - dot - 1;
+        if (str.length() - 1 > 15 || fraction > 22) return false;
+
+        uint64_t mantissa = 0;
+        for (char ch : str) {
+            if (ch != '.') mantissa = mantissa * 10 + static_cast<uint32_t>(ch - '0');
+        }
+        *out = static_cast<double>(mantissa) / exact_powers_of_ten[fraction];
+        return true;
+    }
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Dove {
+
+/**
+ * Scan
+ *
+ * Byte-run scanners for the lexer hot loops. Each scanner returns a pointer to the
+ * first byte in [it, end) that is not part of the run (or `end`). The kernel is picked
+ * once at runtime: SSE4.2 when the CPU has it, otherwise scalar. The AVX2 kernels only win
+ * on long runs, which source code rarely has (identifiers average ~5 bytes), so they are
+ * used only when picked with select().
+ */
+class Scan {
+public:
+    enum class Isa : uint8_t {
+        Scalar,
+        SSE42,
+        AVX2,
+    };
+
+    // ' ', '\t', '\r' (newlines are left to the caller for line tracking)
+    static const char *whitespace(const char *it, const char *end);
+    // a-z, A-Z, 0-9, _
+    static const char *identifier(const char *it, const char *end);
+    // 0-9
+    static const char *digits(const char *it, const char *end);
+    // Everything but `quote`, '\\', '\n' and NUL (the body of a string or char literal)
+    static const char *quoted(const char *it, const char *end, char quote);
+
+    static Isa isa();
+    // Force a kernel (e.g. for tests/benchmarks). Returns false if the CPU lacks it.
+    static bool select(Isa isa);
+};
+
+} // namespace Dove
\ No newline at end of file
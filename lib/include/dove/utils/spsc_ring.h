@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Dove {
+
+/**
+ * SpscRing
+ *
+ * Bounded lock-free queue between exactly one producer and one consumer thread. Slots are
+ * filled and read in place: the producer claim()s the next free slot, writes it and
+ * publish()es it; the consumer reads front() and pop()s it. Each side waits (on the other
+ * side's counter, with std::atomic::wait) only when the ring is full or empty, which is the
+ * backpressure: a producer can never be more than capacity() slots ahead.
+ *
+ * The counters live on separate cache lines and each side keeps a copy of the other's, so
+ * the shared lines are only read again when the copy says the ring is full or empty.
+ * close() (from either side) sets a flag bit in both counters, which also wakes a waiter.
+ */
+template <typename T> class SpscRing {
+private:
+    static constexpr size_t cache_line = 64;
+    static constexpr uint64_t closed_bit = uint64_t{1} << 63;
+
+    std::unique_ptr<T[]> slots;
+    size_t mask;
+
+    alignas(cache_line) std::atomic<uint64_t> head{0}; // slots popped; written by the consumer
+    uint64_t known_tail = 0;                            // consumer's copy of `tail`
+    alignas(cache_line) std::atomic<uint64_t> tail{0}; // slots published; by the producer
+    uint64_t known_head = 0;                            // producer's copy of `head`
+
+public:
+    // `capacity` is rounded up to a power of two
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots = std::make_unique<T[]>(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer: the next slot to fill, nullptr while the ring is full or once it is closed
+    T *try_claim() {
+        uint64_t at = tail.load(std::memory_order_relaxed);
+        if (at & closed_bit) return nullptr;
+        if (at - known_head == capacity()) {
+            uint64_t popped = head.load(std::memory_order_acquire);
+            if (popped & closed_bit) return nullptr;
+            known_head = popped;
+            if (at - known_head == capacity()) return nullptr;
+        }
+        return &slots[at & mask];
+    }
+    // Producer: the next slot to fill, waiting for the consumer while the ring is full;
+    // nullptr once it is closed
+    T *claim() {
+        while (true) {
+            if (T *slot = try_claim()) return slot;
+            uint64_t popped = head.load(std::memory_order_acquire);
+            if ((popped | tail.load(std::memory_order_relaxed)) & closed_bit) return nullptr;
+            if (tail.load(std::memory_order_relaxed) - popped == capacity()) {
+                head.wait(popped, std::memory_order_acquire);
+            }
+        }
+    }
+    // Producer: hand the claimed slot to the consumer
+    void publish() {
+        tail.fetch_add(1, std::memory_order_release);
+        tail.notify_one();
+    }
+
+    // Consumer: the oldest published slot, nullptr while the ring is empty
+    T *try_front() {
+        uint64_t at = head.load(std::memory_order_relaxed) & ~closed_bit;
+        if (at == known_tail) {
+            known_tail = tail.load(std::memory_order_acquire) & ~closed_bit;
+            if (at == known_tail) return nullptr;
+        }
+        return &slots[at & mask];
+    }
+    // Consumer: the oldest published slot, waiting for the producer while the ring is
+    // empty; nullptr once it is closed and every published slot was popped
+    T *front() {
+        while (true) {
+            if (T *slot = try_front()) return slot;
+            uint64_t published = tail.load(std::memory_order_acquire);
+            if ((published & ~closed_bit) != known_tail) continue;
+            if (published & closed_bit) return nullptr;
+            tail.wait(published, std::memory_order_acquire);
+        }
+    }
+    // Consumer: give the front slot back to the producer
+    void pop() {
+        head.fetch_add(1, std::memory_order_release);
+        head.notify_one();
+    }
+
+    // No more slots will be published (producer) or popped (consumer); what was published
+    // before can still be read
+    void close() {
+        tail.fetch_or(closed_bit, std::memory_order_release);
+        head.fetch_or(closed_bit, std::memory_order_release);
+        tail.notify_one();
+        head.notify_one();
+    }
+    bool closed() const { return tail.load(std::memory_order_acquire) & closed_bit; }
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * ThreadPool
+ *
+ * Fixed set of worker threads for data-parallel phases. `run(n, task)` calls task(i) for
+ * every i in [0, n) on the workers and the calling thread, handing out indices one at a
+ * time, and returns once all of them are done.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(size_t)> *task = nullptr;
+    size_t task_count = 0;
+    std::atomic<size_t> next_index = 0;
+    size_t busy = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    void work();
+    void drain();
+
+public:
+    // 0 = one thread per hardware thread (the caller counts as one)
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Threads that execute tasks, including the caller of run()
+    size_t size() const { return workers.size() + 1; }
+
+    void run(size_t count, const std::function<void(size_t)> &task);
+};
+
+} // namespace Dove
\ No newline at end of file
@@ -1,57 +1,93 @@
 #pragma once
 
+#include "unicode_tables.h"
+
 #include <cstdint>
 #include <string_view>
 
 namespace Dove {
 
-// Not used anymore..
-
+/**
+ * Unicode
+ *
+ * UTF-8 helpers for the lexer. Sources are validated once up front with validate(), which
+ * checks whole vectors at a time and skips pure-ASCII blocks, so the lexer only meets
+ * well-formed sequences afterwards.
+ */
 class Unicode {
-
 public:
-    static uint8_t read_unicode(const std::string_view &str, uint32_t idx, uint32_t *out) {
+    // Decode the code point at `str[idx]`. Returns its length in bytes, or 0 if the sequence
+    // is malformed (bad or missing continuation bytes, overlong, surrogate, > U+10FFFF).
+    static constexpr uint8_t read_unicode(const std::string_view &str, uint32_t idx,
+                                          uint32_t *out) {
         if (idx >= str.length()) return 0;
 
-        uint32_t codepoint = 0;
-        uint8_t bytes_read = 0;
+        size_t available = str.length() - idx;
         uint8_t byte1 = static_cast<uint8_t>(str[idx]);
 
+        uint32_t codepoint;
+        uint8_t len;
+        uint32_t min;
         // 1-byte (0xxxxxxx)
-        if ((byte1 & 0x80) == 0) {
-            codepoint = byte1;
-            bytes_read = 1;
+        if (byte1 < 0x80) {
+            *out = byte1;
+            return 1;
         }
         // 2-bytes (110xxxxx 10xxxxxx)
         else if ((byte1 & 0xE0) == 0xC0) {
-            if (idx + 1 >= str.length()) return 0;
-            codepoint = ((byte1 & 0x1F) << 6) | (static_cast<uint8_t>(str[idx + 1]));
-            bytes_read = 2;
+            codepoint = byte1 & 0x1F, len = 2, min = 0x80;
         }
         // 3-bytes (1110xxxx 10xxxxxx 10xxxxxx)
         else if ((byte1 & 0xF0) == 0xE0) {
-            if (idx + 2 >= str.length()) return 0;
-            codepoint = ((byte1 & 0x0F) << 12) |
-                        ((static_cast<uint8_t>(str[idx + 1]) & 0x3F) << 6) |
-                        (static_cast<uint8_t>(str[idx + 2]) & 0x3F);
-            bytes_read = 3;
+            codepoint = byte1 & 0x0F, len = 3, min = 0x800;
         }
         // 4-bytes (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx)
         else if ((byte1 & 0xF8) == 0xF0) {
-            if (idx + 3 >= str.length()) return 0;
-            codepoint = ((byte1 & 0x07) << 18) |
-                        ((static_cast<uint8_t>(str[idx + 1]) & 0x3F) << 12) |
-                        ((static_cast<uint8_t>(str[idx + 2]) & 0x3F) << 6) |
-                        (static_cast<uint8_t>(str[idx + 3]) & 0x3F);
-            bytes_read = 4;
+            codepoint = byte1 & 0x07, len = 4, min = 0x10000;
         }
         // Invalid
         else
             return 0;
 
+        if (available < len) return 0;
+        for (uint8_t i = 1; i < len; i++) {
+            uint8_t byte = static_cast<uint8_t>(str[idx + i]);
+            if ((byte & 0xC0) != 0x80) return 0;
+            codepoint = codepoint << 6 | (byte & 0x3F);
+        }
+
+        // Overlong encodings, UTF-16 surrogates and values past U+10FFFF
+        if (codepoint < min || (codepoint >= 0xD800 && codepoint <= 0xDFFF) ||
+            codepoint > 0x10FFFF) {
+            return 0;
+        }
+
         *out = codepoint;
-        return bytes_read;
+        return len;
+    }
+
+    // First byte of the first malformed sequence in [it, end), or `end`. `ascii` is cleared
+    // if any byte is not ASCII.
+    static const char *validate(const char *it, const char *end, bool *ascii = nullptr);
+    // [it, end) is the valid start of a sequence that continues past `end`
+    static bool truncated(const char *it, const char *end);
+
+    // Bytes in [it, end) that are not the first byte of a code point
+    static uint32_t continuation_bytes(const char *it, const char *end);
+
+    // Defined here, like read_unicode(), so the lexer's rules work in constant expressions
+    static constexpr bool is_xid_start(uint32_t codepoint) {
+        if (codepoint >= xid_limit) return false;
+        const uint64_t *block = xid_blocks[xid_index[codepoint >> xid_block_bits]];
+        uint32_t bit = codepoint & ((1u << xid_block_bits) - 1);
+        return block[bit >> 6] >> (bit & 63) & 1;
+    }
+    static constexpr bool is_xid_continue(uint32_t codepoint) {
+        if (codepoint >= xid_limit) return false;
+        const uint64_t *block = xid_blocks[xid_index[codepoint >> xid_block_bits]];
+        uint32_t bit = codepoint & ((1u << xid_block_bits) - 1);
+        return block[4 + (bit >> 6)] >> (bit & 63) & 1;
     }
 };
 
-}
\ No newline at end of file
+} // namespace Dove
\ No newline at end of file
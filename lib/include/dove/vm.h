@@ -0,0 +1,71 @@
+#pragma once
+
+#include "bytecode.h"
+#include "diagnostics.h"
+#include "error.h"
+#include "utils/arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+
+namespace Dove {
+
+/**
+ * Vm
+ *
+ * Runs a Program. Registers of all frames live on one stack of Values: a call's frame starts
+ * at its first argument in the caller's frame, so passing arguments copies nothing. The
+ * dispatch loop is threaded with computed gotos: every handler ends in its own indirect jump
+ * through a table of handler addresses indexed by the next opcode, which gives the branch
+ * predictor one jump site per opcode instead of the single one of a `switch`.
+ *
+ * Objects and iterators are allocated in an arena that lives until the next run.
+ */
+class Vm {
+private:
+    struct Frame {
+        const Function *function;
+        const Instruction *pc; // of the Call, while a callee runs
+        Value *base;
+    };
+
+    std::vector<Value> stack;
+    std::vector<Frame> frames;
+    size_t max_frames;
+    std::vector<Value> globals;
+    Arena heap;
+    const Program *program = nullptr;
+
+    std::string *output = nullptr; // stdout through `buffer` if not set
+    std::string buffer;
+    uint64_t random_state = 0x853C49E6748FEA9B;
+
+    std::expected<Value, CompilerError> execute();
+    Value *new_object(uint32_t layout);
+    Value *copy_object(const Value *object);
+    void print(const PrintFormat &format, const Value *args);
+    uint64_t random();
+    void flush();
+    std::unexpected<CompilerError> error(Message message, const Function &function,
+                                         const Instruction *pc) const;
+
+public:
+    static constexpr size_t default_stack_size = 1 << 16; // registers
+    static constexpr size_t default_max_frames = 1 << 14;
+
+    explicit Vm(size_t stack_size = default_stack_size, size_t max_frames = default_max_frames);
+
+    // Append what the program prints to `out` instead of writing it to stdout
+    void set_output(std::string *out) { output = out; }
+    // Seed of `rand::rand_bool`
+    void seed(uint64_t value) { random_state = value | 1; }
+
+    // The value `main` returns (zero for Unit) or the runtime error that stopped it.
+    // The program must be free of compiler errors.
+    std::expected<Value, CompilerError> run(const Program &program);
+};
+
+} // namespace Dove
\ No newline at end of file
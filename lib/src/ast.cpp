@@ -0,0 +1,99 @@
+#include "dove/ast.h"
+
+using namespace Dove;
+
+namespace {
+
+#define DOVE_NODE_NAME(name, lhs, rhs) #name,
+constexpr std::string_view kind_names[] = {DOVE_NODE_KINDS(DOVE_NODE_NAME)};
+#undef DOVE_NODE_NAME
+
+// Kinds whose token is followed by their name
+bool is_named(NodeKind kind) {
+    switch (kind) {
+        case NodeKind::Obj:
+        case NodeKind::Func:
+        case NodeKind::Let:
+        case NodeKind::Const:
+        case NodeKind::For:
+        case NodeKind::Path:
+        case NodeKind::Member:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+std::string Ast::dump() const {
+    std::string out;
+    if (node_count) dump(out, root, 0);
+    return out;
+}
+
+void Ast::dump(std::string &out, NodeId id, size_t depth) const {
+    const Node &node = nodes[id];
+    size_t kind = static_cast<size_t>(node.kind);
+    out.append(2 * depth, ' ');
+    out += kind_names[kind];
+
+    switch (node.kind) {
+        case NodeKind::Module:
+        case NodeKind::Block:
+        case NodeKind::UseGroup:
+        case NodeKind::Call:
+        case NodeKind::Index:
+        case NodeKind::TypeArray:
+            break;
+        case NodeKind::String:
+            out += " \"";
+            out += str(id);
+            out += '"';
+            break;
+        case NodeKind::Character:
+            out += " '";
+            out += str(id);
+            out += '\'';
+            break;
+        case NodeKind::MatchArm:
+            out += ' ';
+            out += str(id);
+            if (node.lhs) {
+                out += ' ';
+                out += token_name(node.op);
+            }
+            break;
+        default:
+            if (is_named(node.kind) || (node.flags & Node::labeled)) {
+                out += ' ';
+                out += name(id);
+            } else if (lhs_operand(node.kind) == Operand::None || node.kind == NodeKind::Unary ||
+                       node.kind == NodeKind::Binary || node.kind == NodeKind::Assign ||
+                       node.kind == NodeKind::Param) {
+                out += ' ';
+                out += str(id);
+            }
+            break;
+    }
+    if (node.flags & Node::glob) out += '!';
+    out += '\n';
+
+    for (auto [operand, value] : {std::pair{lhs_operand(node.kind), node.lhs},
+                                  std::pair{rhs_operand(node.kind), node.rhs}}) {
+        switch (operand) {
+            case Operand::None:
+                break;
+            case Operand::Node:
+                if (value) dump(out, value, depth + 1);
+                break;
+            case Operand::List:
+                for (NodeId child : list(value)) dump(out, child, depth + 1);
+                break;
+            case Operand::Pair:
+                if (first(value)) dump(out, first(value), depth + 1);
+                if (second(value)) dump(out, second(value), depth + 1);
+                break;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "dove/bytecode.h"
+
+#include <format>
+
+using namespace Dove;
+
+namespace {
+
+#define DOVE_OPCODE_NAME(name, format) #name,
+constexpr std::string_view opcode_names[] = {DOVE_OPCODES(DOVE_OPCODE_NAME)};
+#undef DOVE_OPCODE_NAME
+
+#define DOVE_OPCODE_FORMAT(name, format) Format::format,
+constexpr Format opcode_formats[] = {DOVE_OPCODES(DOVE_OPCODE_FORMAT)};
+#undef DOVE_OPCODE_FORMAT
+
+} // namespace
+
+std::string_view Dove::opcode_name(Opcode op) { return opcode_names[static_cast<size_t>(op)]; }
+
+Format Dove::opcode_format(Opcode op) { return opcode_formats[static_cast<size_t>(op)]; }
+
+std::string Program::dump() const {
+    std::string out;
+    for (size_t idx = 0; idx < functions.size(); idx++) {
+        const Function &function = functions[idx];
+        out += std::format("func {} #{} (params {}, registers {}, constants {})\n", function.name,
+                           idx, function.params, function.registers, function.constants.size());
+
+        size_t note = 0;
+        for (size_t pc = 0; pc < function.code.size(); pc++) {
+            for (; note < function.notes.size() && function.notes[note].first == pc; note++) {
+                out += std::format("  ; {}\n", function.notes[note].second);
+            }
+            const Instruction &in = function.code[pc];
+            int64_t target = static_cast<int64_t>(pc) + 1 + in.x;
+            out += std::format("  {:04} {:<16}", pc, opcode_name(in.op));
+            switch (opcode_format(in.op)) {
+                case Format::None:
+                    break;
+                case Format::A:
+                    out += std::format("r{}", in.a);
+                    break;
+                case Format::AB:
+                    out += std::format("r{}, r{}", in.a, in.b);
+                    break;
+                case Format::ABC:
+                    out += std::format("r{}, r{}, r{}", in.a, in.b, in.c);
+                    break;
+                case Format::ABF:
+                    out += std::format("r{}, r{}.{}", in.a, in.b, in.c);
+                    break;
+                case Format::AFC:
+                    out += std::format("r{}.{}, r{}", in.a, in.b, in.c);
+                    break;
+                case Format::AK:
+                    out += std::format("r{}, {}", in.a, in.x);
+                    break;
+                case Format::ABI:
+                    out += std::format("r{}, r{}, {}", in.a, in.b, in.x);
+                    break;
+                case Format::AJ:
+                    out += std::format("r{}, -> {:04}", in.a, target);
+                    break;
+                case Format::ABJ:
+                    out += std::format("r{}, r{}, -> {:04}", in.a, in.b, target);
+                    break;
+                case Format::AIJ:
+                    out += std::format("r{}, {}, -> {:04}", in.a, in.immediate(), target);
+                    break;
+                case Format::J:
+                    out += std::format("-> {:04}", target);
+                    break;
+                case Format::ACK:
+                    out += std::format("r{}, {}, {}", in.a, in.c, in.x);
+                    break;
+                case Format::AT:
+                    out += std::format("r{}, table {}", in.a, in.x);
+                    break;
+            }
+            // Trailing spaces of the padded name
+            while (out.back() == ' ') out.pop_back();
+            out += '\n';
+
+            // A table lists a target per value
+            if (opcode_format(in.op) == Format::AT) {
+                const JumpTable &table = function.tables[in.x];
+                for (size_t entry = 0; entry < table.targets.size(); entry++) {
+                    std::string value = std::to_string(table.low + static_cast<int64_t>(entry));
+                    out += std::format("{:>24} -> {:04}\n", value, table.targets[entry]);
+                }
+                out += std::format("{:>24} -> {:04}\n", "else", table.fallback);
+            }
+        }
+    }
+    return out;
+}
\ No newline at end of file
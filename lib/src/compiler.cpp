@@ -0,0 +1,2002 @@
+#include "dove/compiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+using namespace Dove;
+
+namespace {
+
+constexpr Type unit_type{TypeKind::Unit};
+constexpr Type never_type{TypeKind::Never}; // also "no expected type"
+constexpr Type bool_type{TypeKind::Bool};
+
+// The largest value of an integer type, and the magnitude of its smallest
+u128 max_value(Type type) {
+    uint32_t bits = type.bits();
+    if (type.is_signed()) return (u128{1} << (bits - 1)) - 1;
+    return bits == 128 ? ~u128{0} : (u128{1} << bits) - 1;
+}
+
+u128 min_magnitude(Type type) { return type.is_signed() ? u128{1} << (type.bits() - 1) : 0; }
+
+// `value` cut to the width of an integer type, sign-extended if it is signed: how the VM
+// sees the low bits of a 128-bit result
+u128 wrap(u128 value, Type type) {
+    uint32_t bits = type.bits();
+    if (bits == 128) return value;
+    u128 mask = (u128{1} << bits) - 1;
+    if (type.is_signed() && (value >> (bits - 1) & 1)) return value | ~mask;
+    return value & mask;
+}
+
+// `a op b` for `+`, `-`, `*`, `/` and `%` (`b` is not 0); false if it overflows T
+template <typename T> bool exact(TokenType op, T a, T b, T *out) {
+    switch (op) {
+        case TokenType::SymbolPlus:
+            return !__builtin_add_overflow(a, b, out);
+        case TokenType::SymbolMinus:
+            return !__builtin_sub_overflow(a, b, out);
+        case TokenType::SymbolAsterisk:
+            return !__builtin_mul_overflow(a, b, out);
+        case TokenType::SymbolSlash:
+            if constexpr (std::is_same_v<T, i128>) {
+                if (b == -1) return !__builtin_sub_overflow(i128{0}, a, out);
+            }
+            *out = a / b;
+            return true;
+        default:
+            if constexpr (std::is_same_v<T, i128>) {
+                if (b == -1) {
+                    *out = 0;
+                    return true;
+                }
+            }
+            *out = a % b;
+            return true;
+    }
+}
+
+// `a op b` of an integer type (applies() to it) as the VM computes it; false if the exact
+// result does not fit the type. Shifts drop bits without overflowing, like at run time.
+bool integer_operation(TokenType op, Type type, u128 a, u128 b, u128 *out) {
+    unsigned count = static_cast<unsigned>(b) & (type.bits() - 1);
+    bool overflow = false;
+    u128 result;
+    switch (op) {
+        case TokenType::SymbolShiftLeft:
+            result = a << count;
+            break;
+        case TokenType::SymbolShiftRight:
+            result = type.is_signed() ? static_cast<u128>(static_cast<i128>(a) >> count)
+                                      : a >> count;
+            break;
+        case TokenType::SymbolAmpersand:
+            result = a & b;
+            break;
+        case TokenType::SymbolVerticalBar:
+            result = a | b;
+            break;
+        default:
+            if (type.is_signed()) {
+                i128 signed_result;
+                overflow = !exact(op, static_cast<i128>(a), static_cast<i128>(b), &signed_result);
+                result = static_cast<u128>(signed_result);
+            } else {
+                overflow = !exact(op, a, b, &result);
+            }
+            break;
+    }
+    *out = wrap(result, type);
+    return !overflow && *out == result;
+}
+
+// `a op b` of a comparable type, for a comparison operator
+bool holds(TokenType op, Type type, Value a, Value b) {
+    auto compare = [op](auto x, auto y) {
+        switch (op) {
+            case TokenType::SymbolEqual:
+                return x == y;
+            case TokenType::SymbolNotEqual:
+                return x != y;
+            case TokenType::SymbolLess:
+                return x < y;
+            case TokenType::SymbolLessEqual:
+                return x <= y;
+            case TokenType::SymbolGreater:
+                return x > y;
+            default:
+                return x >= y;
+        }
+    };
+    if (type.kind == TypeKind::F64) return compare(a.f, b.f);
+    if (type.is_signed()) return compare(static_cast<i128>(a.wide), static_cast<i128>(b.wide));
+    return compare(a.wide, b.wide);
+}
+
+// Reading these copies an object; everything else makes a new one
+bool is_place(NodeKind kind) {
+    return kind == NodeKind::Identifier || kind == NodeKind::Member || kind == NodeKind::Path;
+}
+
+bool is_comparison(TokenType op) {
+    return op == TokenType::SymbolEqual || op == TokenType::SymbolNotEqual ||
+           op == TokenType::SymbolLess || op == TokenType::SymbolLessEqual ||
+           op == TokenType::SymbolGreater || op == TokenType::SymbolGreaterEqual;
+}
+
+// `a op b` is `b swapped(op) a`
+TokenType swapped(TokenType op) {
+    switch (op) {
+        case TokenType::SymbolLess:
+            return TokenType::SymbolGreater;
+        case TokenType::SymbolLessEqual:
+            return TokenType::SymbolGreaterEqual;
+        case TokenType::SymbolGreater:
+            return TokenType::SymbolLess;
+        case TokenType::SymbolGreaterEqual:
+            return TokenType::SymbolLessEqual;
+        default:
+            return op;
+    }
+}
+
+// `!(a op b)` is `a negated(op) b`, except for NaNs
+TokenType negated(TokenType op) {
+    switch (op) {
+        case TokenType::SymbolLess:
+            return TokenType::SymbolGreaterEqual;
+        case TokenType::SymbolLessEqual:
+            return TokenType::SymbolGreater;
+        case TokenType::SymbolGreater:
+            return TokenType::SymbolLessEqual;
+        case TokenType::SymbolGreaterEqual:
+            return TokenType::SymbolLess;
+        case TokenType::SymbolEqual:
+            return TokenType::SymbolNotEqual;
+        default:
+            return TokenType::SymbolEqual;
+    }
+}
+
+// The operator of a compound assignment
+TokenType compound(TokenType op) {
+    switch (op) {
+        case TokenType::SymbolPlusEqual:
+            return TokenType::SymbolPlus;
+        case TokenType::SymbolMinusEqual:
+            return TokenType::SymbolMinus;
+        case TokenType::SymbolAsteriskEqual:
+            return TokenType::SymbolAsterisk;
+        case TokenType::SymbolSlashEqual:
+            return TokenType::SymbolSlash;
+        default:
+            return TokenType::SymbolModulo;
+    }
+}
+
+bool applies(TokenType op, Type type) {
+    switch (op) {
+        case TokenType::SymbolShiftLeft:
+        case TokenType::SymbolShiftRight:
+            return type.is_integer();
+        case TokenType::SymbolAmpersand:
+        case TokenType::SymbolVerticalBar:
+            return type.is_integer() || type.kind == TypeKind::Bool;
+        default:
+            return type.is_number();
+    }
+}
+
+// The opcode of an arithmetic or bitwise operator that applies() to `type`
+Opcode arithmetic_opcode(TokenType op, Type type) {
+    switch (op) {
+        case TokenType::SymbolPlus:
+            return typed(Opcode::AddI8, type.kind);
+        case TokenType::SymbolMinus:
+            return typed(Opcode::SubI8, type.kind);
+        case TokenType::SymbolAsterisk:
+            return typed(Opcode::MulI8, type.kind);
+        case TokenType::SymbolSlash:
+            return typed(Opcode::DivI8, type.kind);
+        case TokenType::SymbolModulo:
+            return typed(Opcode::ModI8, type.kind);
+        case TokenType::SymbolShiftLeft:
+            return typed(Opcode::ShlI8, type.kind);
+        case TokenType::SymbolShiftRight:
+            return typed(Opcode::ShrI8, type.kind);
+        case TokenType::SymbolAmpersand:
+            return type.is_wide() ? Opcode::BitAnd128 : Opcode::BitAnd64;
+        default:
+            return type.is_wide() ? Opcode::BitOr128 : Opcode::BitOr64;
+    }
+}
+
+struct NativeInfo {
+    std::string_view module;
+    std::string_view name;
+    TypeKind result;
+};
+
+constexpr NativeInfo natives[] = {
+#define DOVE_NATIVE_INFO(native, module, function, result) {module, function, TypeKind::result},
+    DOVE_NATIVES(DOVE_NATIVE_INFO)
+#undef DOVE_NATIVE_INFO
+};
+
+} // namespace
+
+Compiler::Compiler(const Ast &ast, const Interner &interner)
+    : ast(ast), tokens(ast.get_tokens()), interner(interner) {
+    program.tokens = &tokens;
+    names.resize(interner.size());
+    unfolded.resize(ast.size());
+    main_symbol = interner.find("main");
+    println_symbol = interner.find("println");
+    print_symbol = interner.find("print");
+    rng_symbol = interner.find("rng");
+    range_symbol = interner.find("range");
+    underscore_symbol = interner.find("_");
+
+    declare();
+    program.entry = static_cast<uint32_t>(program.functions.size());
+    program.functions.emplace_back().name = "entry";
+    // Globals first, so the types of those without one are known in functions
+    compile_entry();
+    for (uint32_t idx = 0; idx < callables.size(); idx++) compile_function(idx);
+}
+
+std::expected<const Program *, CompilerError> Compiler::get_program() const {
+    if (!diagnostics.empty()) return diagnostics[0].to_error().unexpected();
+    return &program;
+}
+
+void Compiler::report(Message message, NodeId at, uint32_t arg0, uint32_t arg1) {
+    uint32_t offset = tokens.empty() ? 0 : tokens.start(ast[at].token);
+    diagnostics.report(message, offset, tokens.line_at(offset), tokens.column_at(offset), arg0,
+                       arg1);
+}
+
+// Declarations
+
+void Compiler::declare() {
+    // Names first, so types and calls can refer to anything declared later
+    for (NodeId item : ast.list(ast[Ast::root].lhs)) {
+        const Node &node = ast[item];
+        switch (node.kind) {
+            case NodeKind::Obj:
+                names[symbol(node.token + 1)] = {Binding::Object,
+                                                 static_cast<uint32_t>(objects.size())};
+                objects.push_back({item, {}, {}, {}});
+                break;
+            case NodeKind::Func:
+                names[symbol(node.token + 1)] = {Binding::Function, declare_function(item, none)};
+                break;
+            case NodeKind::Let:
+            case NodeKind::Const:
+                names[symbol(node.token + 1)] = {Binding::Global,
+                                                 static_cast<uint32_t>(globals.size())};
+                globals.push_back({item, none, never_type, node.kind == NodeKind::Const});
+                break;
+            default:
+                break;
+        }
+    }
+    for (uint32_t idx = 0; idx < objects.size(); idx++) declare_object(idx);
+
+    // Then types
+    for (Global &global : globals) {
+        if (ast[global.node].lhs) global.type = type_of(ast[global.node].lhs);
+    }
+    for (Callable &callable : callables) {
+        const Node &node = ast[callable.node];
+        for (NodeId param : ast.list(node.lhs)) callable.params.push_back(type_of(ast[param].lhs));
+        NodeId result = ast.first(node.rhs);
+        callable.result = result ? type_of(result) : unit_type;
+        program.functions[&callable - callables.data()].params =
+            static_cast<uint32_t>(callable.params.size() + (callable.object != none));
+    }
+    for (Object &object : objects) {
+        std::vector<int32_t> &layout = program.layouts.emplace_back();
+        for (Field &field : object.fields) {
+            field.type = type_of(ast[field.node].lhs);
+            bool nested = field.type.kind == TypeKind::Obj;
+            layout.push_back(nested ? static_cast<int32_t>(field.type.detail) : -1);
+        }
+    }
+    check_layouts();
+    program.globals = static_cast<uint32_t>(globals.size());
+}
+
+void Compiler::declare_object(uint32_t index) {
+    // Members refer to `objects`, which must not grow meanwhile
+    NodeId id = objects[index].node;
+    for (NodeId member : ast.list(ast[id].lhs)) {
+        const Node &node = ast[member];
+        SymbolId name = symbol(node.token + 1);
+        switch (node.kind) {
+            case NodeKind::Let:
+                objects[index].fields.push_back({name, member, never_type});
+                break;
+            case NodeKind::Const:
+                objects[index].consts.emplace_back(name, static_cast<uint32_t>(globals.size()));
+                globals.push_back({member, index, never_type, true});
+                break;
+            case NodeKind::Func:
+                objects[index].methods.emplace_back(name, declare_function(member, index));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+uint32_t Compiler::declare_function(NodeId id, uint32_t object) {
+    callables.push_back({id, object, {}, unit_type});
+    Function &function = program.functions.emplace_back();
+    function.name = tokens.str(ast[id].token + 1);
+    return static_cast<uint32_t>(callables.size() - 1);
+}
+
+void Compiler::check_layouts() {
+    // Objects are values, so one cannot contain itself, even through others: a depth-first
+    // walk over object fields must not come back to an object it is inside of
+    enum State : uint8_t { Unvisited, Visiting, Done };
+    std::vector<State> state(objects.size(), Unvisited);
+    std::vector<std::pair<uint32_t, size_t>> stack; // object, next field
+    for (uint32_t root = 0; root < objects.size(); root++) {
+        if (state[root] != Unvisited) continue;
+        stack.emplace_back(root, 0);
+        state[root] = Visiting;
+        while (!stack.empty()) {
+            auto &[object, next] = stack.back();
+            if (next == objects[object].fields.size()) {
+                state[object] = Done;
+                stack.pop_back();
+                continue;
+            }
+            const Field &field = objects[object].fields[next++];
+            if (field.type.kind != TypeKind::Obj) continue;
+            if (state[field.type.detail] == Visiting) {
+                report(Message::Unsupported, ast[field.node].lhs);
+                program.layouts[object][&field - objects[object].fields.data()] = -1;
+            } else if (state[field.type.detail] == Unvisited) {
+                state[field.type.detail] = Visiting;
+                stack.emplace_back(field.type.detail, 0);
+            }
+        }
+    }
+}
+
+Type Compiler::type_of(NodeId id) {
+    const Node &node = ast[id];
+    if (node.kind != NodeKind::TypeName) {
+        report(Message::Unsupported, id);
+        return never_type;
+    }
+    TokenType kind = tokens.kind(node.token);
+    if (kind >= TokenType::TypeI8 && kind <= TokenType::TypeF64) {
+        return {static_cast<TypeKind>(static_cast<uint8_t>(kind) -
+                                      static_cast<uint8_t>(TokenType::TypeI8))};
+    }
+    if (kind == TokenType::TypeCh) return {TypeKind::Ch};
+    if (kind == TokenType::TypeBool) return bool_type;
+    if (kind == TokenType::ValueIdentifier) {
+        const Binding &binding = names[symbol(node.token)];
+        if (binding.kind == Binding::Object) return {TypeKind::Obj, binding.index};
+        report(Message::UnknownName, id);
+        return never_type;
+    }
+    report(Message::Unsupported, id); // f128
+    return never_type;
+}
+
+// Functions
+
+void Compiler::begin_function(uint32_t index, uint32_t object, bool method) {
+    function = &program.functions[index];
+    scope_object = object;
+    in_method = method;
+    locals.clear();
+    visible_locals = 0;
+    loops.clear();
+    top = function->params;
+    function->registers = top;
+    registers_reported = false;
+}
+
+void Compiler::fold_globals() {
+    // A constant naming one declared after it folds that one first, through known()
+    for (uint32_t idx = 0; idx < globals.size(); idx++) {
+        if (globals[idx].fold == Global::Pending) fold_global(idx);
+    }
+}
+
+void Compiler::fold_global(uint32_t index) {
+    Global &global = globals[index];
+    const Node &node = ast[global.node];
+    if (!global.constant || !node.rhs) {
+        global.fold = Global::Failed;
+        return;
+    }
+    global.fold = Global::Folding;
+    uint32_t scope = std::exchange(scope_object, global.object);
+    Constant folded;
+    if (fold(node.rhs, global.type, &folded) &&
+        (global.type.kind == TypeKind::Never || global.type == folded.type)) {
+        report_overflow(folded);
+        global.type = folded.type;
+        global.fold = Global::Folded;
+        global.value = folded.value;
+    } else {
+        global.fold = Global::Failed;
+    }
+    scope_object = scope;
+}
+
+void Compiler::compile_entry() {
+    begin_function(program.entry, none, false);
+    result = unit_type;
+    fold_globals();
+    for (uint32_t idx = 0; idx < globals.size(); idx++) {
+        Global &global = globals[idx];
+        if (global.fold == Global::Folded) continue;
+        const Node &node = ast[global.node];
+        scope_object = global.object;
+        initialized = idx;
+        uint8_t reg = alloc(global.node);
+        if (node.rhs) {
+            Result init = value(node.rhs, global.type, {Dest::Fixed, reg});
+            if (global.type.kind == TypeKind::Never) {
+                global.type = init.type;
+            } else {
+                check(global.type, init.type, node.rhs);
+            }
+        } else {
+            load_default(reg, global.type, global.node);
+        }
+        emit(Opcode::SetGlobal, reg, 0, 0, static_cast<int32_t>(idx), node.token);
+        top = 0;
+    }
+    scope_object = none;
+    initialized = none;
+
+    const Binding *main = main_symbol != Interner::none ? &names[main_symbol] : nullptr;
+    if (!main || main->kind != Binding::Function || !callables[main->index].params.empty()) {
+        // Reported at the first token, if there is one
+        uint32_t offset = tokens.empty() ? 0 : tokens.start(0);
+        diagnostics.report(Message::MissingMain, offset, tokens.line_at(offset),
+                           tokens.column_at(offset));
+        emit(Opcode::ReturnUnit, 0, 0, 0, 0, 0);
+        return;
+    }
+    uint32_t token = ast[callables[main->index].node].token;
+    emit(Opcode::Call, 0, 0, 0, static_cast<int32_t>(main->index), token);
+    function->registers = std::max(function->registers, 1u);
+    if (callables[main->index].result == unit_type) {
+        emit(Opcode::ReturnUnit, 0, 0, 0, 0, token);
+    } else {
+        emit(Opcode::Return, 0, 0, 0, 0, token);
+    }
+}
+
+void Compiler::compile_function(uint32_t index) {
+    const Callable &callable = callables[index];
+    const Node &node = ast[callable.node];
+    begin_function(index, callable.object, callable.object != none);
+    result = callable.result;
+
+    uint8_t reg = callable.object != none; // the object is register 0 of a method
+    const auto params = ast.list(node.lhs);
+    for (size_t idx = 0; idx < params.size(); idx++) {
+        locals.push_back({symbol(ast[params[idx]].token), reg++, callable.params[idx], false});
+    }
+    visible_locals = 0;
+
+    NodeId body = ast.second(node.rhs);
+    if (!body) return; // dropped by the parser
+    if (result == unit_type) {
+        expression(body, unit_type, {Dest::Discard});
+        emit(Opcode::ReturnUnit, 0, 0, 0, 0, ast[body].token);
+        return;
+    }
+    Result value = expression(body, result, {Dest::Any});
+    if (check(result, value.type, body) && value.type.kind != TypeKind::Never) {
+        emit(Opcode::Return, value.reg, 0, 0, 0, ast[body].token);
+    }
+}
+
+// Code
+
+uint32_t Compiler::emit(Opcode op, uint32_t a, uint32_t b, uint32_t c, int32_t x,
+                        uint32_t token) {
+    function->code.push_back({op, static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                              static_cast<uint8_t>(c), x});
+    function->tokens.push_back(token);
+    return static_cast<uint32_t>(function->code.size() - 1);
+}
+
+void Compiler::patch(uint32_t at, uint32_t target) {
+    function->code[at].x = static_cast<int32_t>(target) - static_cast<int32_t>(at) - 1;
+}
+
+uint8_t Compiler::alloc(NodeId at) {
+    if (top > UINT8_MAX) {
+        if (!registers_reported) report(Message::TooManyRegisters, at);
+        registers_reported = true;
+        return UINT8_MAX;
+    }
+    function->registers = std::max(function->registers, top + 1);
+    return static_cast<uint8_t>(top++);
+}
+
+void Compiler::load(uint8_t reg, Type type, Value value, uint32_t token) {
+    i128 wide = static_cast<i128>(value.wide);
+    if (type.kind != TypeKind::F64 && wide >= INT32_MIN && wide <= INT32_MAX) {
+        emit(Opcode::LoadInt, reg, 0, 0, static_cast<int32_t>(wide), token);
+        return;
+    }
+    std::vector<Value> &constants = function->constants;
+    auto same = [&](const Value &constant) {
+        return std::memcmp(&constant, &value, sizeof(Value)) == 0;
+    };
+    auto it = std::find_if(constants.begin(), constants.end(), same);
+    if (it == constants.end()) it = constants.insert(it, value);
+    emit(Opcode::LoadConst, reg, 0, 0, static_cast<int32_t>(it - constants.begin()), token);
+}
+
+void Compiler::load_default(uint8_t reg, Type type, NodeId at) {
+    if (type.kind != TypeKind::Obj) {
+        emit(Opcode::LoadInt, reg, 0, 0, 0, ast[at].token); // 0, 0.0, false and '\0'
+        return;
+    }
+    uint32_t base = top;
+    Result object = this->object(at, type.detail);
+    emit(Opcode::Move, reg, object.reg, 0, 0, ast[at].token);
+    top = base;
+}
+
+// Names
+
+const Compiler::Local *Compiler::find_local(SymbolId name) const {
+    for (size_t idx = locals.size(); idx > visible_locals; idx--) {
+        if (locals[idx - 1].name == name) return &locals[idx - 1];
+    }
+    return nullptr;
+}
+
+uint32_t Compiler::find_field(uint32_t object, SymbolId name) const {
+    const std::vector<Field> &fields = objects[object].fields;
+    for (uint32_t idx = 0; idx < fields.size(); idx++) {
+        if (fields[idx].name == name) return idx;
+    }
+    return none;
+}
+
+uint32_t Compiler::find_method(uint32_t object, SymbolId name) const {
+    for (auto [method, index] : objects[object].methods) {
+        if (method == name) return index;
+    }
+    return none;
+}
+
+uint32_t Compiler::find_global(SymbolId name) const {
+    if (scope_object != none) {
+        for (auto [constant, index] : objects[scope_object].consts) {
+            if (constant == name) return index;
+        }
+    }
+    const Binding &binding = names[name];
+    return binding.kind == Binding::Global ? binding.index : none;
+}
+
+uint32_t Compiler::find_constant(NodeId id) const {
+    const Node &node = ast[id];
+    const Node &prefix = ast[node.lhs];
+    if (prefix.kind != NodeKind::Identifier) return none;
+    const Binding &binding = names[symbol(prefix.token)];
+    if (binding.kind != Binding::Object) return none;
+    for (auto [constant, index] : objects[binding.index].consts) {
+        if (constant == symbol(node.token + 1)) return index;
+    }
+    return none;
+}
+
+bool Compiler::known(NodeId id, Constant *out) {
+    // Resolved like place()
+    const Node &node = ast[id];
+    uint32_t global = none;
+    if (node.kind == NodeKind::Identifier) {
+        SymbolId name = symbol(node.token);
+        if (const Local *local = find_local(name)) {
+            if (!local->folded) return false;
+            *out = {local->type, local->value};
+            return true;
+        }
+        if (in_method && find_field(scope_object, name) != none) return false;
+        global = find_global(name);
+    } else if (node.kind == NodeKind::Path) {
+        global = find_constant(id);
+    }
+    if (global == none) return false;
+    // A constant is folded when it is first named; naming one that is being folded is a cycle
+    if (globals[global].fold == Global::Folding) {
+        report(Message::UnknownName, id);
+        return false;
+    }
+    if (globals[global].fold == Global::Pending) fold_global(global);
+    if (globals[global].fold != Global::Folded) return false;
+    *out = {globals[global].type, globals[global].value};
+    return true;
+}
+
+Compiler::Place Compiler::place(NodeId id) {
+    const Node &node = ast[id];
+    if (node.kind == NodeKind::Identifier) {
+        SymbolId name = symbol(node.token);
+        if (const Local *local = find_local(name)) {
+            return {Place::Local, local->type, local->reg, 0, local->constant};
+        }
+        uint32_t field = in_method ? find_field(scope_object, name) : none;
+        if (field != none) {
+            return {Place::Field, objects[scope_object].fields[field].type, 0, field, false};
+        }
+        uint32_t global = find_global(name);
+        if (global != none) {
+            // Its type is not known yet, or it would be read before it is initialized
+            if (globals[global].type.kind == TypeKind::Never || global >= initialized) {
+                report(Message::UnknownName, id);
+                return {};
+            }
+            return {Place::Global, globals[global].type, 0, global, globals[global].constant};
+        }
+        report(Message::UnknownName, id);
+        return {};
+    }
+    if (node.kind == NodeKind::Path) {
+        uint32_t global = find_constant(id);
+        if (global != none && global < initialized) {
+            return {Place::Global, globals[global].type, 0, global, true};
+        }
+        report(Message::UnknownName, id);
+        return {};
+    }
+    if (node.kind == NodeKind::Member) {
+        Result object = expression(node.lhs, never_type, {Dest::Any});
+        if (object.type.kind != TypeKind::Obj) {
+            if (object.type.kind != TypeKind::Never) {
+                report(Message::InvalidOperand, id, static_cast<uint32_t>(TokenType::SymbolDot),
+                       static_cast<uint32_t>(object.type.kind));
+            }
+            return {};
+        }
+        uint32_t field = find_field(object.type.detail, symbol(node.token + 1));
+        if (field == none) {
+            report(Message::UnknownMember, id);
+            return {};
+        }
+        return {Place::Field, objects[object.type.detail].fields[field].type, object.reg, field,
+                false};
+    }
+    report(Message::Unsupported, id);
+    return {};
+}
+
+void Compiler::store(const Place &place, uint8_t reg, uint32_t token) {
+    switch (place.kind) {
+        case Place::Local:
+            if (reg != place.reg) emit(Opcode::Move, place.reg, reg, 0, 0, token);
+            break;
+        case Place::Field:
+            emit(Opcode::SetField, place.reg, place.index, reg, 0, token);
+            break;
+        case Place::Global:
+            emit(Opcode::SetGlobal, reg, 0, 0, static_cast<int32_t>(place.index), token);
+            break;
+        case Place::None:
+            break;
+    }
+}
+
+// Types
+
+bool Compiler::check(Type expected, Type found, NodeId at) {
+    if (expected == found || expected.kind == TypeKind::Never ||
+        found.kind == TypeKind::Never) {
+        return true;
+    }
+    report(Message::TypeMismatch, at, static_cast<uint32_t>(expected.kind),
+           static_cast<uint32_t>(found.kind));
+    return false;
+}
+
+bool Compiler::is_literal(NodeId id) const {
+    const Node &node = ast[id];
+    switch (node.kind) {
+        case NodeKind::Integer:
+        case NodeKind::Float:
+        case NodeKind::Character:
+        case NodeKind::Bool:
+            return true;
+        case NodeKind::Unary:
+            return node.op == TokenType::SymbolMinus && (ast[node.lhs].kind == NodeKind::Integer ||
+                                                         ast[node.lhs].kind == NodeKind::Float);
+        default:
+            return false;
+    }
+}
+
+bool Compiler::constant(NodeId id, Type type, i128 *out) {
+    Constant value;
+    if (!(type.is_integer() || type.kind == TypeKind::Ch || type.kind == TypeKind::Bool) ||
+        !fold(id, type, &value) || value.type != type || value.overflow != Ast::root) {
+        return false;
+    }
+    // Only values that fit an i128 are useful as immediates
+    if (type.kind == TypeKind::U128 && value.value.wide > max_value({TypeKind::I128})) {
+        return false;
+    }
+    *out = static_cast<i128>(value.value.wide);
+    return true;
+}
+
+bool Compiler::fold(NodeId id, Type expected, Constant *out) {
+    if (unfolded[id].failed && unfolded[id].expected == expected) return false;
+    if (evaluate(id, expected, out)) return true;
+    unfolded[id] = {expected, true};
+    return false;
+}
+
+bool Compiler::evaluate(NodeId id, Type expected, Constant *out) {
+    const Node &node = ast[id];
+    // The first overflow is the one reported
+    auto overflow = [out](NodeId at, Type type) {
+        if (out->overflow != Ast::root) return;
+        out->overflow = at;
+        out->overflow_type = type;
+    };
+    switch (node.kind) {
+        case NodeKind::Integer: {
+            // Typed and checked as literal() does
+            Type type = expected.is_integer() ? expected : Type{TypeKind::I32};
+            *out = {type};
+            out->value.wide = tokens.integer(node.token);
+            if (out->value.wide > max_value(type)) overflow(id, type);
+            return true;
+        }
+        case NodeKind::Float:
+            *out = {{TypeKind::F64}};
+            out->value.f = tokens.floating(node.token);
+            return true;
+        case NodeKind::Character:
+            *out = {{TypeKind::Ch}};
+            out->value.wide = tokens.value(node.token) & UINT8_MAX;
+            if (tokens.value(node.token) > UINT8_MAX) overflow(id, out->type);
+            return true;
+        case NodeKind::Bool:
+            *out = {bool_type};
+            out->value.wide = tokens.kind(node.token) == TokenType::KeywordTrue;
+            return true;
+        case NodeKind::Identifier:
+        case NodeKind::Path:
+            return known(id, out);
+        case NodeKind::Unary:
+            if (node.op == TokenType::SymbolNot) {
+                if (!fold(node.lhs, bool_type, out) || out->type != bool_type) return false;
+                out->value.wide ^= 1;
+                return true;
+            }
+            if (node.op != TokenType::SymbolMinus) return false;
+            if (ast[node.lhs].kind == NodeKind::Integer) {
+                // A negative literal, which may be the smallest value of its type
+                Type type = expected.is_integer() ? expected : Type{TypeKind::I32};
+                u128 magnitude = tokens.integer(ast[node.lhs].token);
+                *out = {type};
+                out->value.wide = 0 - magnitude;
+                if (magnitude > min_magnitude(type)) overflow(node.lhs, type);
+                return true;
+            }
+            if (!fold(node.lhs, expected, out)) return false;
+            if (out->type.kind == TypeKind::F64) {
+                out->value.f = -out->value.f;
+            } else if (!out->type.is_signed()) {
+                return false;
+            } else if (!integer_operation(TokenType::SymbolMinus, out->type, 0, out->value.wide,
+                                          &out->value.wide)) {
+                overflow(id, out->type);
+            }
+            return true;
+        case NodeKind::Binary:
+            break;
+        default:
+            return false;
+    }
+
+    // Operands are typed as binary() and condition() type them
+    bool logical = node.op == TokenType::SymbolAnd || node.op == TokenType::SymbolOr;
+    bool comparison = is_comparison(node.op);
+    Type operand = logical ? bool_type : comparison ? never_type : expected;
+    Constant lhs, rhs;
+    if (operand.kind == TypeKind::Never && is_literal(node.lhs) && !is_literal(node.rhs)) {
+        if (!fold(node.rhs, never_type, &rhs) || !fold(node.lhs, rhs.type, &lhs)) return false;
+    } else if (!fold(node.lhs, operand, &lhs) || !fold(node.rhs, lhs.type, &rhs)) {
+        return false;
+    }
+    Type type = lhs.type;
+    if (rhs.type != type) return false;
+    const Constant &first = lhs.overflow != Ast::root ? lhs : rhs;
+    *out = {type, {}, first.overflow, first.overflow_type};
+    u128 a = lhs.value.wide;
+    u128 b = rhs.value.wide;
+
+    if (logical) {
+        if (type != bool_type) return false;
+        out->value.wide = node.op == TokenType::SymbolAnd ? a & b : a | b;
+        return true;
+    }
+    if (comparison) {
+        bool equality = node.op == TokenType::SymbolEqual || node.op == TokenType::SymbolNotEqual;
+        if (equality ? !type.is_comparable() : !type.is_ordered()) return false;
+        out->type = bool_type;
+        out->value.wide = holds(node.op, type, lhs.value, rhs.value);
+        return true;
+    }
+    switch (node.op) {
+        case TokenType::SymbolPlus:
+        case TokenType::SymbolMinus:
+        case TokenType::SymbolAsterisk:
+        case TokenType::SymbolSlash:
+        case TokenType::SymbolModulo:
+        case TokenType::SymbolShiftLeft:
+        case TokenType::SymbolShiftRight:
+        case TokenType::SymbolAmpersand:
+        case TokenType::SymbolVerticalBar:
+            if (!applies(node.op, type)) return false;
+            break;
+        default:
+            return false;
+    }
+    if (type.kind == TypeKind::F64) {
+        double x = lhs.value.f;
+        double y = rhs.value.f;
+        switch (node.op) {
+            case TokenType::SymbolPlus:
+                out->value.f = x + y;
+                break;
+            case TokenType::SymbolMinus:
+                out->value.f = x - y;
+                break;
+            case TokenType::SymbolAsterisk:
+                out->value.f = x * y;
+                break;
+            case TokenType::SymbolSlash:
+                out->value.f = x / y;
+                break;
+            default:
+                out->value.f = std::fmod(x, y);
+                break;
+        }
+        return true;
+    }
+    if (type == bool_type) {
+        out->value.wide = node.op == TokenType::SymbolAmpersand ? a & b : a | b;
+        return true;
+    }
+    // A division by zero is left to the VM to report
+    if ((node.op == TokenType::SymbolSlash || node.op == TokenType::SymbolModulo) && b == 0) {
+        return false;
+    }
+    if (!integer_operation(node.op, type, a, b, &out->value.wide)) overflow(id, type);
+    return true;
+}
+
+void Compiler::report_overflow(const Constant &value) {
+    if (value.overflow != Ast::root) {
+        report(Message::OutOfRange, value.overflow,
+               static_cast<uint32_t>(value.overflow_type.kind));
+    }
+}
+
+// Statements
+
+Type Compiler::statement(NodeId id) {
+    switch (ast[id].kind) {
+        case NodeKind::Let:
+        case NodeKind::Const:
+            let(id);
+            return unit_type;
+        case NodeKind::Rtn:
+            rtn(id);
+            return never_type;
+        case NodeKind::Brk:
+            brk(id);
+            return never_type;
+        default:
+            return expression(id, never_type, {Dest::Discard}).type.kind == TypeKind::Never
+                       ? never_type
+                       : unit_type;
+    }
+}
+
+void Compiler::let(NodeId id) {
+    const Node &node = ast[id];
+    Type type = node.lhs ? type_of(node.lhs) : never_type;
+    Constant folded;
+    if (node.kind == NodeKind::Const && node.rhs && fold(node.rhs, type, &folded) &&
+        (type.kind == TypeKind::Never || type == folded.type)) {
+        report_overflow(folded);
+        locals.push_back({symbol(node.token + 1), 0, folded.type, true, true, folded.value});
+        return;
+    }
+    uint8_t reg = alloc(id);
+    if (node.rhs) {
+        Result init = value(node.rhs, type, {Dest::Fixed, reg});
+        if (type.kind == TypeKind::Never) {
+            type = init.type;
+        } else {
+            check(type, init.type, node.rhs);
+        }
+    } else {
+        load_default(reg, type, id);
+    }
+    // Declared after its initializer, which may use a variable it shadows
+    locals.push_back({symbol(node.token + 1), reg, type, node.kind == NodeKind::Const});
+    top = reg + 1u;
+}
+
+void Compiler::rtn(NodeId id) {
+    const Node &node = ast[id];
+    if (!node.lhs) {
+        check(result, unit_type, id);
+        emit(Opcode::ReturnUnit, 0, 0, 0, 0, node.token);
+        return;
+    }
+    uint32_t base = top;
+    Result value = this->value(node.lhs, result, {Dest::Any});
+    check(result, value.type, node.lhs);
+    emit(Opcode::Return, value.reg, 0, 0, 0, node.token);
+    top = base;
+}
+
+void Compiler::brk(NodeId id) {
+    const Node &node = ast[id];
+    if (loops.empty()) {
+        report(Message::BreakOutsideLoop, id);
+        return;
+    }
+
+    // `brk label` leaves the loop of that label, without a value
+    size_t loop = loops.size() - 1;
+    NodeId value = node.lhs;
+    if (value && ast[value].kind == NodeKind::Identifier) {
+        SymbolId name = symbol(ast[value].token);
+        for (size_t idx = loops.size(); idx-- > 0;) {
+            if (loops[idx].label == name) {
+                loop = idx;
+                value = 0;
+                break;
+            }
+        }
+    }
+
+    Type type = unit_type;
+    if (value) {
+        if (!loops[loop].breakable) {
+            report(Message::BreakOutsideLoop, id);
+            return;
+        }
+        uint32_t base = top;
+        Dest dest = loops[loop].value ? Dest{Dest::Fixed, loops[loop].reg} : Dest{Dest::Discard};
+        type = this->value(value, loops[loop].type, dest).type;
+        top = base;
+    }
+    // `loops` may have grown and shrunk while compiling the value
+    Loop &target = loops[loop];
+    if (target.type.kind == TypeKind::Never) {
+        target.type = type;
+    } else {
+        check(target.type, type, value ? value : id);
+    }
+    target.broken = true;
+    target.breaks.push_back(emit(Opcode::Jump, 0, 0, 0, 0, node.token));
+}
+
+// Expressions
+
+Compiler::Result Compiler::expression(NodeId id, Type expected, Dest dest) {
+    uint32_t base = top;
+    Result result;
+    Constant folded;
+    switch (ast[id].kind) {
+        case NodeKind::Integer:
+        case NodeKind::Float:
+        case NodeKind::Character:
+        case NodeKind::Bool:
+            result = literal(id, expected, dest, false);
+            break;
+        case NodeKind::Identifier:
+        case NodeKind::Path:
+            result = name(id, dest);
+            break;
+        case NodeKind::Unary:
+            result = fold(id, expected, &folded) ? load_constant(id, folded, dest)
+                                                 : unary(id, expected, dest);
+            break;
+        case NodeKind::Binary:
+            result = fold(id, expected, &folded) ? load_constant(id, folded, dest)
+                                                 : binary(id, expected, dest);
+            break;
+        case NodeKind::Assign:
+            assign(id);
+            result = {unit_type};
+            break;
+        case NodeKind::Call:
+            result = call(id, dest);
+            break;
+        case NodeKind::Member:
+            result = member(id, dest);
+            break;
+        case NodeKind::Block:
+            result = block(id, expected, dest);
+            break;
+        case NodeKind::If:
+            result = if_expression(id, expected, dest);
+            break;
+        case NodeKind::Match:
+            result = match(id, expected, dest);
+            break;
+        case NodeKind::Loop:
+            result = loop(id, expected, dest);
+            break;
+        case NodeKind::While:
+            while_loop(id);
+            result = {unit_type};
+            break;
+        case NodeKind::For:
+            for_loop(id);
+            result = {unit_type};
+            break;
+        default: // strings outside of formats, indexing
+            report(Message::Unsupported, id);
+            result = {never_type};
+            break;
+    }
+
+    // A value of Any dest is in a local's register or in the first temporary; a Fixed one
+    // in its register. Either way nothing else stays allocated.
+    bool has_value = result.type.kind != TypeKind::Unit && result.type.kind != TypeKind::Never;
+    if (dest.kind == Dest::Fixed && has_value && result.reg != dest.reg) {
+        emit(Opcode::Move, dest.reg, result.reg, 0, 0, ast[id].token);
+        result.reg = dest.reg;
+    } else if (dest.kind == Dest::Any && has_value && result.reg > base) {
+        emit(Opcode::Move, base, result.reg, 0, 0, ast[id].token);
+        result.reg = static_cast<uint8_t>(base);
+    }
+    top = dest.kind == Dest::Any && has_value && result.reg >= base ? result.reg + 1u : base;
+    return result;
+}
+
+Compiler::Result Compiler::value(NodeId id, Type expected, Dest dest) {
+    uint32_t base = top;
+    Result result = expression(id, expected, dest);
+    if (result.type.kind != TypeKind::Obj || dest.kind == Dest::Discard ||
+        !is_place(ast[id].kind)) {
+        return result;
+    }
+    uint8_t reg = dest.kind == Dest::Fixed || result.reg >= base ? result.reg : alloc(id);
+    emit(Opcode::Copy, reg, result.reg, 0, 0, ast[id].token);
+    return {result.type, reg};
+}
+
+Compiler::Result Compiler::literal(NodeId id, Type expected, Dest dest, bool negate) {
+    const Node &node = ast[id];
+    Type type;
+    Value value{};
+    switch (node.kind) {
+        case NodeKind::Integer: {
+            type = expected.is_integer() ? expected : Type{TypeKind::I32};
+            u128 magnitude = tokens.integer(node.token);
+            if (negate ? magnitude > min_magnitude(type) : magnitude > max_value(type)) {
+                report(Message::OutOfRange, id, static_cast<uint32_t>(type.kind));
+            }
+            value.wide = negate ? 0 - magnitude : magnitude;
+            break;
+        }
+        case NodeKind::Float:
+            type = {TypeKind::F64};
+            value.f = negate ? -tokens.floating(node.token) : tokens.floating(node.token);
+            break;
+        case NodeKind::Character:
+            type = {TypeKind::Ch};
+            if (tokens.value(node.token) > UINT8_MAX) {
+                report(Message::OutOfRange, id, static_cast<uint32_t>(type.kind));
+            }
+            value.wide = tokens.value(node.token) & UINT8_MAX;
+            break;
+        default:
+            type = bool_type;
+            value.wide = tokens.kind(node.token) == TokenType::KeywordTrue;
+            break;
+    }
+    if (dest.kind == Dest::Discard) return {type};
+    uint8_t reg = target(dest, id);
+    load(reg, type, value, node.token);
+    return {type, reg};
+}
+
+Compiler::Result Compiler::name(NodeId id, Dest dest) {
+    Constant value;
+    if (known(id, &value)) return load_constant(id, value, dest);
+    Place place = this->place(id);
+    switch (place.kind) {
+        case Place::None:
+            return {never_type};
+        case Place::Local:
+            return {place.type, place.reg};
+        case Place::Field: {
+            uint8_t reg = target(dest, id);
+            emit(Opcode::GetField, reg, place.reg, place.index, 0, ast[id].token);
+            return {place.type, reg};
+        }
+        case Place::Global: {
+            uint8_t reg = target(dest, id);
+            emit(Opcode::GetGlobal, reg, 0, 0, static_cast<int32_t>(place.index),
+                 ast[id].token);
+            return {place.type, reg};
+        }
+    }
+    return {never_type};
+}
+
+Compiler::Result Compiler::load_constant(NodeId id, const Constant &value, Dest dest) {
+    report_overflow(value);
+    if (dest.kind == Dest::Discard) return {value.type};
+    uint8_t reg = target(dest, id);
+    load(reg, value.type, value.value, ast[id].token);
+    return {value.type, reg};
+}
+
+Compiler::Result Compiler::unary(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+    uint32_t base = top;
+    if (node.op == TokenType::SymbolMinus) {
+        if (is_literal(id)) return literal(node.lhs, expected, dest, true);
+        Result operand = expression(node.lhs, expected, {Dest::Any});
+        Type type = operand.type;
+        if (!type.is_signed() && type.kind != TypeKind::F64) {
+            if (type.kind != TypeKind::Never) {
+                report(Message::InvalidOperand, id, static_cast<uint32_t>(node.op),
+                       static_cast<uint32_t>(type.kind));
+            }
+            return {never_type};
+        }
+        top = base;
+        uint8_t reg = target(dest, id);
+        emit(typed_signed(Opcode::NegI8, type.kind), reg, operand.reg, 0, 0, node.token);
+        return {type, reg};
+    }
+    if (node.op == TokenType::SymbolNot) {
+        Result operand = expression(node.lhs, bool_type, {Dest::Any});
+        if (!check(bool_type, operand.type, node.lhs)) return {never_type};
+        top = base;
+        uint8_t reg = target(dest, id);
+        emit(Opcode::Not, reg, operand.reg, 0, 0, node.token);
+        return {bool_type, reg};
+    }
+    report(Message::Unsupported, id); // references
+    return {never_type};
+}
+
+Compiler::Result Compiler::binary(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+    uint32_t base = top;
+
+    if (node.op == TokenType::SymbolAnd || node.op == TokenType::SymbolOr ||
+        is_comparison(node.op)) {
+        // Through the branches a condition compiles to
+        uint8_t reg = target(dest, id);
+        std::vector<uint32_t> jumps;
+        condition(id, false, jumps);
+        emit(Opcode::LoadInt, reg, 0, 0, 1, node.token);
+        uint32_t end = emit(Opcode::Jump, 0, 0, 0, 0, node.token);
+        patch_all(jumps);
+        emit(Opcode::LoadInt, reg, 0, 0, 0, node.token);
+        patch(end);
+        return {bool_type, reg};
+    }
+
+    // An untyped literal on the left takes its type from the right: `1 + x`
+    if (expected.kind == TypeKind::Never && is_literal(node.lhs) && !is_literal(node.rhs)) {
+        Result rhs = expression(node.rhs, never_type, {Dest::Any});
+        Result lhs = expression(node.lhs, rhs.type, {Dest::Any});
+        if (!applies(node.op, rhs.type)) {
+            if (rhs.type.kind != TypeKind::Never) {
+                report(Message::InvalidOperand, id, static_cast<uint32_t>(node.op),
+                       static_cast<uint32_t>(rhs.type.kind));
+            }
+            return {never_type};
+        }
+        top = base;
+        uint8_t reg = target(dest, id);
+        emit(arithmetic_opcode(node.op, rhs.type), reg, lhs.reg, rhs.reg, 0, node.token);
+        return {rhs.type, reg};
+    }
+
+    Result lhs = expression(node.lhs, expected, {Dest::Any});
+    if (lhs.type.kind == TypeKind::Never) {
+        expression(node.rhs, never_type, {Dest::Discard});
+        return {never_type};
+    }
+    // The result can replace a temporary left operand
+    if (dest.kind == Dest::Any && lhs.reg >= base) dest = {Dest::Fixed, lhs.reg};
+    uint8_t reg = arithmetic(node.op, lhs.type, lhs.reg, node.rhs, dest, id);
+    return {applies(node.op, lhs.type) ? lhs.type : never_type, reg};
+}
+
+uint8_t Compiler::arithmetic(TokenType op, Type type, uint8_t lhs, NodeId rhs, Dest dest,
+                             NodeId at) {
+    uint32_t base = top;
+    if (!applies(op, type)) {
+        report(Message::InvalidOperand, at, static_cast<uint32_t>(op),
+               static_cast<uint32_t>(type.kind));
+        expression(rhs, type, {Dest::Discard});
+        return 0;
+    }
+
+    // `+` and `-` of a constant that fits in 32 bits: AddImm
+    i128 value;
+    if ((op == TokenType::SymbolPlus || op == TokenType::SymbolMinus) && type.is_integer() &&
+        constant(rhs, type, &value) && value >= -INT32_MAX && value <= INT32_MAX) {
+        top = base;
+        uint8_t reg = target(dest, at);
+        int32_t immediate = static_cast<int32_t>(op == TokenType::SymbolMinus ? -value : value);
+        emit(typed(Opcode::AddImmI8, type.kind), reg, lhs, 0, immediate, ast[at].token);
+        return reg;
+    }
+
+    Result operand = expression(rhs, type, {Dest::Any});
+    check(type, operand.type, rhs);
+    top = base;
+    uint8_t reg = target(dest, at);
+    emit(arithmetic_opcode(op, type), reg, lhs, operand.reg, 0, ast[at].token);
+    return reg;
+}
+
+void Compiler::assign(NodeId id) {
+    const Node &node = ast[id];
+    uint32_t base = top;
+    Place target = place(node.lhs);
+    if (target.kind == Place::None) {
+        expression(node.rhs, never_type, {Dest::Discard});
+        top = base;
+        return;
+    }
+    if (target.constant) report(Message::AssignToConstant, node.lhs);
+
+    if (node.op == TokenType::SymbolAssign) {
+        if (target.kind == Place::Local) {
+            check(target.type, value(node.rhs, target.type, {Dest::Fixed, target.reg}).type,
+                  node.rhs);
+        } else {
+            Result value = this->value(node.rhs, target.type, {Dest::Any});
+            check(target.type, value.type, node.rhs);
+            store(target, value.reg, node.token);
+        }
+        top = base;
+        return;
+    }
+
+    // Compound: a local is updated in place, anything else through a temporary
+    uint8_t reg = target.reg;
+    if (target.kind != Place::Local) {
+        reg = alloc(id);
+        if (target.kind == Place::Field) {
+            emit(Opcode::GetField, reg, target.reg, target.index, 0, node.token);
+        } else {
+            emit(Opcode::GetGlobal, reg, 0, 0, static_cast<int32_t>(target.index), node.token);
+        }
+    }
+    arithmetic(compound(node.op), target.type, reg, node.rhs, {Dest::Fixed, reg}, id);
+    if (target.kind != Place::Local) store(target, reg, node.token);
+    top = base;
+}
+
+Compiler::Result Compiler::call(NodeId id, Dest dest) {
+    const Node &node = ast[id];
+    const Node &callee = ast[node.lhs];
+    uint32_t base = top;
+
+    if (callee.kind == NodeKind::Identifier) {
+        SymbolId name = symbol(callee.token);
+        uint32_t method = in_method ? find_method(scope_object, name) : none;
+        if (method != none) return call_function(method, id, 0, true);
+        const Binding &binding = names[name];
+        if (binding.kind == Binding::Function) return call_function(binding.index, id, 0, false);
+        if (binding.kind == Binding::Free && (name == println_symbol || name == print_symbol)) {
+            return print(id, name == println_symbol);
+        }
+        report(binding.kind == Binding::Free ? Message::UnknownName : Message::NotCallable,
+               node.lhs);
+        return {never_type};
+    }
+
+    if (callee.kind == NodeKind::Path && ast[callee.lhs].kind == NodeKind::Identifier) {
+        SymbolId module = symbol(ast[callee.lhs].token);
+        SymbolId name = symbol(callee.token + 1);
+        if (is_range(id)) return range(id, dest);
+        for (uint32_t idx = 0; idx < std::size(natives); idx++) {
+            if (interner.name(module) != natives[idx].module ||
+                interner.name(name) != natives[idx].name) {
+                continue;
+            }
+            size_t count = ast.list(node.rhs).size();
+            if (count != 0) report(Message::ArgumentCount, id, 0, static_cast<uint32_t>(count));
+            uint8_t reg = target(dest, id);
+            emit(Opcode::Native, reg, 0, 0, static_cast<int32_t>(idx), node.token);
+            return {{natives[idx].result}, reg};
+        }
+        report(Message::UnknownName, node.lhs);
+        return {never_type};
+    }
+
+    if (callee.kind == NodeKind::Member) {
+        Result object = expression(callee.lhs, never_type, {Dest::Any});
+        if (object.type.kind != TypeKind::Obj) {
+            if (object.type.kind != TypeKind::Never) report(Message::NotCallable, node.lhs);
+            return {never_type};
+        }
+        uint32_t method = find_method(object.type.detail, symbol(callee.token + 1));
+        if (method == none) {
+            report(Message::UnknownMember, node.lhs);
+            return {never_type};
+        }
+        Result result = call_function(method, id, object.reg, true);
+        // The result is in the first argument register, above the object
+        if (result.reg != base && result.type.kind != TypeKind::Unit) {
+            emit(Opcode::Move, base, result.reg, 0, 0, node.token);
+            result.reg = static_cast<uint8_t>(base);
+        }
+        return result;
+    }
+
+    report(Message::NotCallable, node.lhs);
+    return {never_type};
+}
+
+Compiler::Result Compiler::call_function(uint32_t index, NodeId id, uint8_t self,
+                                         bool has_self) {
+    const Node &node = ast[id];
+    const Callable &callable = callables[index];
+    const auto args = ast.list(node.rhs);
+    if (args.size() != callable.params.size()) {
+        report(Message::ArgumentCount, id, static_cast<uint32_t>(callable.params.size()),
+               static_cast<uint32_t>(args.size()));
+        return {callable.result};
+    }
+
+    // The callee's frame starts at the first argument
+    uint8_t first = static_cast<uint8_t>(top);
+    if (has_self) emit(Opcode::Move, alloc(id), self, 0, 0, node.token);
+    for (size_t idx = 0; idx < args.size(); idx++) {
+        uint8_t reg = alloc(args[idx]);
+        check(callable.params[idx], value(args[idx], callable.params[idx], {Dest::Fixed, reg}).type,
+              args[idx]);
+    }
+    emit(Opcode::Call, first, 0, static_cast<uint32_t>(args.size() + has_self),
+         static_cast<int32_t>(index), node.token);
+    return {callable.result, first};
+}
+
+Compiler::Result Compiler::print(NodeId id, bool newline) {
+    const Node &node = ast[id];
+    const auto args = ast.list(node.rhs);
+    if (args.empty() || ast[args[0]].kind != NodeKind::String) {
+        report(Message::Unsupported, args.empty() ? id : args[0]);
+        return {unit_type};
+    }
+
+    // `{}` is replaced by the next argument
+    PrintFormat format{{}, {}, newline};
+    std::string_view text = interner.name(tokens.value(ast[args[0]].token));
+    for (size_t at; (at = text.find("{}")) != std::string_view::npos; text.remove_prefix(at + 2)) {
+        format.pieces.emplace_back(text.substr(0, at));
+    }
+    format.pieces.emplace_back(text);
+    if (format.pieces.size() != args.size()) {
+        report(Message::FormatArguments, id, static_cast<uint32_t>(format.pieces.size() - 1),
+               static_cast<uint32_t>(args.size() - 1));
+        return {unit_type};
+    }
+
+    uint8_t first = static_cast<uint8_t>(top);
+    for (size_t idx = 1; idx < args.size(); idx++) {
+        Type type = expression(args[idx], never_type, {Dest::Fixed, alloc(args[idx])}).type;
+        if (!type.is_comparable() && type.kind != TypeKind::Never) {
+            report(Message::Unsupported, args[idx]);
+        }
+        format.types.push_back(type.kind);
+    }
+    emit(Opcode::Print, first, 0, static_cast<uint32_t>(args.size() - 1),
+         static_cast<int32_t>(program.formats.size()), node.token);
+    program.formats.push_back(std::move(format));
+    return {unit_type};
+}
+
+bool Compiler::is_range(NodeId id) const {
+    const Node &node = ast[id];
+    if (node.kind != NodeKind::Call || ast[node.lhs].kind != NodeKind::Path) return false;
+    const Node &callee = ast[node.lhs];
+    return ast[callee.lhs].kind == NodeKind::Identifier &&
+           symbol(ast[callee.lhs].token) == rng_symbol && symbol(callee.token + 1) == range_symbol;
+}
+
+Type Compiler::bounds(NodeId id, uint8_t from, uint8_t to) {
+    const Node &node = ast[id];
+    const auto args = ast.list(node.rhs);
+    if (args.size() != 2) {
+        report(Message::ArgumentCount, id, 2, static_cast<uint32_t>(args.size()));
+        return never_type;
+    }
+    // Bounds of the same type; a literal takes the type of the other one
+    Type type, other;
+    if (is_literal(args[0]) && !is_literal(args[1])) {
+        other = expression(args[1], never_type, {Dest::Fixed, to}).type;
+        type = expression(args[0], other, {Dest::Fixed, from}).type;
+    } else {
+        type = expression(args[0], never_type, {Dest::Fixed, from}).type;
+        other = expression(args[1], type, {Dest::Fixed, to}).type;
+    }
+    check(type, other, args[1]);
+    if (!type.is_integer()) {
+        if (type.kind != TypeKind::Never) {
+            report(Message::TypeMismatch, args[0], static_cast<uint32_t>(TypeKind::I32),
+                   static_cast<uint32_t>(type.kind));
+        }
+        return never_type;
+    }
+    return type;
+}
+
+Compiler::Result Compiler::range(NodeId id, Dest dest) {
+    uint32_t base = top;
+    uint8_t from = alloc(id);
+    uint8_t to = alloc(id);
+    Type type = bounds(id, from, to);
+    if (type.kind == TypeKind::Never) return {never_type};
+    top = base;
+    uint8_t reg = target(dest, id);
+    emit(typed_order(Opcode::RangeI64, type), reg, from, to, 0, ast[id].token);
+    return {{TypeKind::Iterator, static_cast<uint32_t>(type.kind)}, reg};
+}
+
+Compiler::Result Compiler::member(NodeId id, Dest dest) {
+    uint32_t base = top;
+    Place place = this->place(id);
+    if (place.kind == Place::None) return {never_type};
+    top = base;
+    uint8_t reg = target(dest, id);
+    emit(Opcode::GetField, reg, place.reg, place.index, 0, ast[id].token);
+    return {place.type, reg};
+}
+
+Compiler::Result Compiler::block(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+
+    // An object is written as a block of field assignments: `{ value = 0 }`
+    if (expected.kind == TypeKind::Obj) {
+        bool fields = true;
+        for (NodeId statement : ast.list(node.lhs)) {
+            fields = fields && ast[statement].kind == NodeKind::Assign;
+        }
+        if (fields && (!node.rhs || ast[node.rhs].kind == NodeKind::Assign)) {
+            return object(id, expected.detail);
+        }
+    }
+
+    // The value's register is taken before the block's locals
+    bool has_value = dest.kind != Dest::Discard && node.rhs;
+    uint8_t reg = has_value ? target(dest, id) : 0;
+    size_t scope = locals.size();
+    uint32_t base = top;
+
+    bool diverges = false;
+    for (NodeId statement : ast.list(node.lhs)) {
+        diverges = this->statement(statement).kind == TypeKind::Never || diverges;
+    }
+    Type type = diverges ? never_type : unit_type;
+    if (node.rhs) {
+        type = expression(node.rhs, expected, has_value ? Dest{Dest::Fixed, reg} : dest).type;
+    }
+    locals.resize(scope);
+    top = base;
+    return {type, reg};
+}
+
+Compiler::Result Compiler::object(NodeId id, uint32_t object) {
+    const Node &node = ast[id];
+    // A new register even for a Fixed dest: the fields may read the object it holds
+    uint8_t reg = alloc(id);
+    emit(Opcode::New, reg, 0, 0, static_cast<int32_t>(object), node.token);
+
+    std::vector<bool> assigned(objects[object].fields.size());
+    auto initialize = [&](NodeId assignment) {
+        const Node &field_node = ast[assignment];
+        if (field_node.op != TokenType::SymbolAssign ||
+            ast[field_node.lhs].kind != NodeKind::Identifier) {
+            report(Message::Unsupported, assignment);
+            return;
+        }
+        uint32_t field = find_field(object, symbol(ast[field_node.lhs].token));
+        if (field == none) {
+            report(Message::UnknownMember, field_node.lhs);
+            return;
+        }
+        uint32_t base = top;
+        const Type type = objects[object].fields[field].type;
+        Result value = this->value(field_node.rhs, type, {Dest::Any});
+        check(type, value.type, field_node.rhs);
+        emit(Opcode::SetField, reg, field, value.reg, 0, field_node.token);
+        assigned[field] = true;
+        top = base;
+    };
+    // Anything but a block (the declaration of a variable without an initializer) builds the
+    // default object
+    if (node.kind == NodeKind::Block) {
+        for (NodeId statement : ast.list(node.lhs)) initialize(statement);
+        if (node.rhs) initialize(node.rhs);
+    }
+
+    // Fields left out get their initializer, compiled where the object is declared, or their
+    // own default object. New leaves them zeroed.
+    for (uint32_t field = 0; field < assigned.size(); field++) {
+        const Type type = objects[object].fields[field].type;
+        NodeId init = ast[objects[object].fields[field].node].rhs;
+        bool nested = type.kind == TypeKind::Obj && program.layouts[object][field] >= 0;
+        if (assigned[field] || (!init && !nested)) continue;
+        uint32_t base = top;
+        auto saved = std::tuple{scope_object, in_method, visible_locals};
+        scope_object = object;
+        in_method = false;
+        visible_locals = locals.size();
+        Result value = init ? this->value(init, type, {Dest::Any})
+                            : this->object(objects[object].fields[field].node, type.detail);
+        if (init) check(type, value.type, init);
+        emit(Opcode::SetField, reg, field, value.reg, 0, node.token);
+        std::tie(scope_object, in_method, visible_locals) = saved;
+        top = base;
+    }
+    return {{TypeKind::Obj, object}, reg};
+}
+
+Compiler::Result Compiler::if_expression(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+    NodeId then = ast.first(node.rhs);
+    NodeId otherwise = ast.second(node.rhs);
+    bool has_value = dest.kind != Dest::Discard && otherwise;
+    uint8_t reg = has_value ? target(dest, id) : 0;
+    Dest branch = has_value ? Dest{Dest::Fixed, reg} : Dest{Dest::Discard};
+
+    std::vector<uint32_t> jumps;
+    condition(node.lhs, false, jumps);
+    Type type = expression(then, expected, branch).type;
+    if (!otherwise) {
+        patch_all(jumps);
+        return {unit_type};
+    }
+
+    bool joins = type.kind != TypeKind::Never;
+    uint32_t end = joins ? emit(Opcode::Jump, 0, 0, 0, 0, node.token) : 0;
+    patch_all(jumps);
+    Type other = expression(otherwise, type.kind == TypeKind::Never ? expected : type, branch).type;
+    if (type.kind == TypeKind::Never) {
+        type = other;
+    } else if (has_value) {
+        check(type, other, otherwise);
+    } else if (!(type == other) && other.kind != TypeKind::Never) {
+        type = unit_type; // the branches' values are dropped anyway
+    }
+    if (joins) patch(end);
+    return {type, reg};
+}
+
+Compiler::Result Compiler::match(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+    bool has_value = dest.kind != Dest::Discard;
+    uint8_t reg = has_value ? target(dest, id) : 0;
+    Dest arm_dest = has_value ? Dest{Dest::Fixed, reg} : Dest{Dest::Discard};
+    uint32_t base = top;
+    Result subject = expression(node.lhs, never_type, {Dest::Any});
+    Type kind = subject.type;
+
+    // Arms after a fallback are never taken. A target of `count` leaves the match.
+    auto arms = ast.list(node.rhs);
+    uint32_t count = 0;
+    uint32_t otherwise = static_cast<uint32_t>(arms.size());
+    while (count < arms.size() && otherwise == arms.size()) {
+        if (!ast[arms[count]].lhs) otherwise = count;
+        count++;
+    }
+    if (otherwise == arms.size()) otherwise = count;
+
+    // Arms comparing a value of an integer, `ch` or bool with `==` to a constant are cases;
+    // any other arm compiles the match to its comparisons in order
+    std::vector<Case> cases;
+    bool constant_cases = kind.is_integer() || kind.kind == TypeKind::Ch ||
+                          kind.kind == TypeKind::Bool;
+    for (uint32_t idx = 0; idx < count && constant_cases; idx++) {
+        const Node &arm = ast[arms[idx]];
+        i128 value = 0;
+        if (!arm.lhs) continue;
+        constant_cases = arm.op == TokenType::SymbolEqual && constant(arm.lhs, kind, &value);
+        cases.push_back({value, idx});
+    }
+    // The first arm of a value wins
+    std::stable_sort(cases.begin(), cases.end(),
+                     [](const Case &a, const Case &b) { return a.value < b.value; });
+    cases.erase(std::unique(cases.begin(), cases.end(),
+                            [](const Case &a, const Case &b) { return a.value == b.value; }),
+                cases.end());
+
+    // Dispatch: jumps to each arm (and past the match), then the arm that is reached by falling
+    // through, if any, which goes first
+    std::vector<std::vector<uint32_t>> jumps(count + 1);
+    uint32_t next = otherwise;
+    std::optional<uint32_t> table;
+    uint32_t token = node.token;
+    auto target_of = [&](i128 value) {
+        auto it = std::find_if(cases.begin(), cases.end(),
+                               [&](const Case &c) { return c.value == value; });
+        return it == cases.end() ? otherwise : it->arm;
+    };
+    if (kind.kind == TypeKind::Never) {
+        // Reported already; the arms are still checked
+    } else if (!constant_cases) {
+        function->notes.emplace_back(
+            here(), std::format("match: {} arm(s) tested in order", count - (otherwise < count)));
+        for (uint32_t idx = 0; idx < count; idx++) {
+            const Node &arm = ast[arms[idx]];
+            if (arm.lhs) compare(arm.op, subject, arm.lhs, true, jumps[idx], arms[idx]);
+        }
+    } else if (kind.kind == TypeKind::Bool) {
+        // One branch, falling through to whichever arm comes first
+        uint32_t when_true = target_of(1);
+        uint32_t when_false = target_of(0);
+        function->notes.emplace_back(here(), "match: bool branch");
+        if (when_true != when_false) {
+            bool sense = when_true > when_false;
+            jumps[sense ? when_true : when_false].push_back(
+                emit(sense ? Opcode::JumpIf : Opcode::JumpIfNot, subject.reg, 0, 0, 0, token));
+        }
+        next = std::min(when_true, when_false);
+    } else if (is_dense(cases, kind)) {
+        // The table is indexed by the offset from the lowest case, in i128 so that u64 cases
+        // past 2^63 do not wrap; the VM subtracts the low case's 64-bit pattern modulo 2^64
+        i128 low = cases.front().value;
+        size_t span = static_cast<size_t>(cases.back().value - low) + 1;
+        function->notes.emplace_back(
+            here(), std::format("match: jump table, {} case(s) over {} value(s)", cases.size(),
+                                span));
+        table = static_cast<uint32_t>(function->tables.size());
+        JumpTable &jump_table = function->tables.emplace_back();
+        jump_table.low = static_cast<int64_t>(static_cast<uint64_t>(low));
+        jump_table.targets.assign(span, otherwise);
+        for (const Case &c : cases) jump_table.targets[static_cast<size_t>(c.value - low)] = c.arm;
+        jump_table.fallback = otherwise;
+        emit(Opcode::JumpTable, subject.reg, 0, 0, static_cast<int32_t>(*table), token);
+        next = count + 1; // nothing falls through
+    } else {
+        function->notes.emplace_back(here(),
+                                     std::format("match: decision tree, {} case(s)", cases.size()));
+        decide(subject, cases, otherwise, true, jumps, id);
+    }
+    if (next == count) jumps[count].push_back(emit(Opcode::Jump, 0, 0, 0, 0, token));
+
+    // The arms, the one dispatch falls through to first
+    std::vector<uint32_t> order;
+    if (next < count) order.push_back(next);
+    for (uint32_t idx = 0; idx < count; idx++) {
+        if (idx != next) order.push_back(idx);
+    }
+    std::vector<uint32_t> starts(count + 1);
+    std::vector<uint32_t> ends;
+    Type type = expected;
+    for (size_t at = 0; at < order.size(); at++) {
+        const Node &arm = ast[arms[order[at]]];
+        starts[order[at]] = here();
+        patch_all(jumps[order[at]]);
+        Type arm_type = value(arm.rhs, type, arm_dest).type;
+        if (type.kind == TypeKind::Never) {
+            type = arm_type;
+        } else if (has_value) {
+            check(type, arm_type, arm.rhs);
+        }
+        if (at + 1 < order.size() && arm_type.kind != TypeKind::Never) {
+            ends.push_back(emit(Opcode::Jump, 0, 0, 0, 0, arm.token));
+        }
+    }
+    starts[count] = here();
+    patch_all(jumps[count]);
+    patch_all(ends);
+    if (table) {
+        JumpTable &jump_table = function->tables[*table];
+        for (uint32_t &target : jump_table.targets) target = starts[target];
+        jump_table.fallback = starts[jump_table.fallback];
+    }
+    top = base;
+
+    bool exhaustive = otherwise < count;
+    if (kind.kind == TypeKind::Bool && constant_cases) {
+        exhaustive = exhaustive || (target_of(0) < count && target_of(1) < count);
+    }
+    if (has_value && !exhaustive && type.kind != TypeKind::Unit) {
+        report(Message::MissingFallback, id);
+    }
+    // Without arms, nothing diverges
+    return {!exhaustive && type.kind == TypeKind::Never ? unit_type : type, reg};
+}
+
+bool Compiler::is_dense(const std::vector<Case> &cases, Type type) const {
+    // At least half of the table are cases, and enough of them that the tree would be deep
+    if (type.is_wide() || cases.size() < dense_cases) return false;
+    u128 span = static_cast<u128>(cases.back().value - cases.front().value) + 1;
+    return span <= 2 * cases.size();
+}
+
+void Compiler::decide(Result subject, std::span<const Case> cases, uint32_t otherwise,
+                      bool last, std::vector<std::vector<uint32_t>> &jumps, NodeId at) {
+    // A few cases are tested one by one, more are halved by the middle one
+    if (cases.size() <= tree_leaf) {
+        for (const Case &c : cases) {
+            jumps[c.arm].push_back(
+                jump_constant(TokenType::SymbolEqual, subject.type, subject.reg, c.value, at));
+        }
+        if (!last) jumps[otherwise].push_back(emit(Opcode::Jump, 0, 0, 0, 0, ast[at].token));
+        return;
+    }
+    size_t middle = cases.size() / 2;
+    uint32_t left = jump_constant(TokenType::SymbolLess, subject.type, subject.reg,
+                                  cases[middle].value, at);
+    decide(subject, cases.subspan(middle), otherwise, false, jumps, at);
+    patch(left);
+    decide(subject, cases.first(middle), otherwise, last, jumps, at);
+}
+
+Compiler::Result Compiler::loop(NodeId id, Type expected, Dest dest) {
+    const Node &node = ast[id];
+    bool has_value = dest.kind != Dest::Discard;
+    uint8_t reg = has_value ? target(dest, id) : 0;
+    SymbolId label = node.flags & Node::labeled ? symbol(node.token + 1) : Interner::none;
+
+    uint32_t start = here();
+    loops.push_back({label, expected, reg, has_value, true, false, {}});
+    expression(node.lhs, unit_type, {Dest::Discard});
+    patch(emit(Opcode::Jump, 0, 0, 0, 0, node.token), start);
+
+    Loop done = std::move(loops.back());
+    loops.pop_back();
+    patch_all(done.breaks);
+    // Without a `brk` the loop never ends
+    if (!done.broken) return {never_type, reg};
+    return {done.type.kind == TypeKind::Never ? unit_type : done.type, reg};
+}
+
+void Compiler::while_loop(NodeId id) {
+    const Node &node = ast[id];
+    // Rotated: the condition is at the bottom and jumps back to the body
+    uint32_t entry = emit(Opcode::Jump, 0, 0, 0, 0, node.token);
+    uint32_t body = here();
+    loops.push_back({Interner::none, unit_type, 0, false, false, false, {}});
+    expression(node.rhs, unit_type, {Dest::Discard});
+    patch(entry);
+
+    std::vector<uint32_t> jumps;
+    condition(node.lhs, true, jumps);
+    for (uint32_t jump : jumps) patch(jump, body);
+    patch_all(loops.back().breaks);
+    loops.pop_back();
+}
+
+void Compiler::for_loop(NodeId id) {
+    const Node &node = ast[id];
+    uint32_t base = top;
+    size_t scope = locals.size();
+    SymbolId name = symbol(node.token + 1);
+    loops.push_back({Interner::none, unit_type, 0, false, false, false, {}});
+
+    if (is_range(node.lhs)) {
+        // A counted loop: the bounds are evaluated once, an empty range skips the loop, and
+        // the counter is the binding (which the body cannot assign), incremented and tested
+        // by one ForLoop per iteration. No iterator is allocated.
+        uint8_t counter = alloc(id);
+        uint8_t end = alloc(id);
+        Type type = bounds(node.lhs, counter, end);
+        if (type.kind != TypeKind::Never) {
+            if (name != underscore_symbol) locals.push_back({name, counter, type, true});
+            uint32_t skip = emit(typed_order(Opcode::JumpLeI64, type), end, counter, 0, 0,
+                                 node.token);
+            uint32_t body = here();
+            expression(node.rhs, unit_type, {Dest::Discard});
+            patch(emit(typed_order(Opcode::ForLoopI64, type), counter, end, 0, 0, node.token),
+                  body);
+            patch(skip);
+        }
+    } else {
+        // Anything else: ask the iterator for the next value until it has none
+        uint8_t iterator = alloc(id);
+        Type type = expression(node.lhs, never_type, {Dest::Fixed, iterator}).type;
+        if (type.kind == TypeKind::Iterator) {
+            uint8_t binding = alloc(id);
+            if (name != underscore_symbol) {
+                locals.push_back({name, binding, {static_cast<TypeKind>(type.detail)}, true});
+            }
+            uint32_t next = emit(Opcode::IterNext, iterator, binding, 0, 0, node.token);
+            expression(node.rhs, unit_type, {Dest::Discard});
+            patch(emit(Opcode::Jump, 0, 0, 0, 0, node.token), next);
+            patch(next);
+        } else if (type.kind != TypeKind::Never) {
+            report(Message::Unsupported, node.lhs);
+        }
+    }
+
+    patch_all(loops.back().breaks);
+    loops.pop_back();
+    locals.resize(scope);
+    top = base;
+}
+
+// Conditions
+
+void Compiler::condition(NodeId id, bool when, std::vector<uint32_t> &jumps) {
+    const Node &node = ast[id];
+    uint32_t base = top;
+    Constant value;
+    if (fold(id, bool_type, &value) && value.type == bool_type) {
+        // Known: always or never taken
+        report_overflow(value);
+        if ((value.value.wide != 0) == when) {
+            jumps.push_back(emit(Opcode::Jump, 0, 0, 0, 0, node.token));
+        }
+    } else if (node.kind == NodeKind::Binary &&
+               (node.op == TokenType::SymbolAnd || node.op == TokenType::SymbolOr)) {
+        // `a && b` is false as soon as `a` is; `a || b` true as soon as `a` is
+        bool shortcut = node.op == TokenType::SymbolOr;
+        if (when == shortcut) {
+            condition(node.lhs, when, jumps);
+            condition(node.rhs, when, jumps);
+        } else {
+            std::vector<uint32_t> skip;
+            condition(node.lhs, shortcut, skip);
+            condition(node.rhs, when, jumps);
+            patch_all(skip);
+        }
+    } else if (node.kind == NodeKind::Unary && node.op == TokenType::SymbolNot) {
+        condition(node.lhs, !when, jumps);
+    } else if (node.kind == NodeKind::Binary && is_comparison(node.op)) {
+        // A constant goes to the right, where it can be an immediate
+        NodeId lhs = node.lhs;
+        NodeId rhs = node.rhs;
+        TokenType op = node.op;
+        if (fold(lhs, never_type, &value) && !fold(rhs, never_type, &value)) {
+            std::swap(lhs, rhs);
+            op = swapped(op);
+        }
+        Result left = expression(lhs, never_type, {Dest::Any});
+        compare(op, left, rhs, when, jumps, id);
+    } else {
+        Result value = expression(id, bool_type, {Dest::Any});
+        check(bool_type, value.type, id);
+        jumps.push_back(emit(when ? Opcode::JumpIf : Opcode::JumpIfNot, value.reg, 0, 0, 0,
+                             node.token));
+    }
+    top = base;
+}
+
+void Compiler::compare(TokenType op, Result lhs, NodeId rhs, bool when,
+                       std::vector<uint32_t> &jumps, NodeId at) {
+    Type type = lhs.type;
+    uint32_t token = ast[at].token;
+    bool equality = op == TokenType::SymbolEqual || op == TokenType::SymbolNotEqual;
+    if (type.kind == TypeKind::Never) {
+        expression(rhs, never_type, {Dest::Discard});
+        return;
+    }
+    if (equality ? !type.is_comparable() : !type.is_ordered()) {
+        report(Message::InvalidOperand, at, static_cast<uint32_t>(op),
+               static_cast<uint32_t>(type.kind));
+        return;
+    }
+
+    // Integers are exact, so "not less" is "greater or equal"
+    i128 value;
+    TokenType relation = when ? op : negated(op);
+    if (constant(rhs, type, &value)) {
+        jumps.push_back(jump_constant(relation, type, lhs.reg, value, at));
+        return;
+    }
+
+    Result other = expression(rhs, type, {Dest::Any});
+    check(type, other.type, rhs);
+    if (!when && type.kind == TypeKind::F64 && !equality) {
+        // NaN is neither less, equal nor greater, so for floats it is not: "not less" has
+        // opcodes of its own
+        uint8_t a = lhs.reg;
+        uint8_t b = other.reg;
+        if (op == TokenType::SymbolGreater || op == TokenType::SymbolGreaterEqual) {
+            std::swap(a, b);
+            op = swapped(op);
+        }
+        Opcode opcode = op == TokenType::SymbolLess ? Opcode::JumpNotLtF64 : Opcode::JumpNotLeF64;
+        jumps.push_back(emit(opcode, a, b, 0, 0, token));
+        return;
+    }
+    jumps.push_back(jump_registers(relation, type, lhs.reg, other.reg, token));
+}
+
+uint32_t Compiler::jump_registers(TokenType relation, Type type, uint8_t a, uint8_t b,
+                                  uint32_t token) {
+    if (relation == TokenType::SymbolGreater || relation == TokenType::SymbolGreaterEqual) {
+        std::swap(a, b);
+        relation = swapped(relation);
+    }
+    Opcode opcode;
+    switch (relation) {
+        case TokenType::SymbolLess:
+            opcode = typed_order(Opcode::JumpLtI64, type);
+            break;
+        case TokenType::SymbolLessEqual:
+            opcode = typed_order(Opcode::JumpLeI64, type);
+            break;
+        case TokenType::SymbolEqual:
+            opcode = typed_equality(Opcode::JumpEqW64, type);
+            break;
+        default:
+            opcode = typed_equality(Opcode::JumpNeW64, type);
+            break;
+    }
+    return emit(opcode, a, b, 0, 0, token);
+}
+
+uint32_t Compiler::jump_constant(TokenType relation, Type type, uint8_t reg, i128 value,
+                                 NodeId at) {
+    uint32_t token = ast[at].token;
+    // Compared to a 16-bit immediate without loading it
+    if (!type.is_wide() && value >= INT16_MIN && value <= INT16_MAX &&
+        (type.is_signed() || value >= 0)) {
+        bool is_signed = type.is_signed();
+        Opcode opcode;
+        switch (relation) {
+            case TokenType::SymbolLess:
+                opcode = is_signed ? Opcode::JumpLtImmI64 : Opcode::JumpLtImmU64;
+                break;
+            case TokenType::SymbolLessEqual:
+                opcode = is_signed ? Opcode::JumpLeImmI64 : Opcode::JumpLeImmU64;
+                break;
+            case TokenType::SymbolGreater:
+                opcode = is_signed ? Opcode::JumpGtImmI64 : Opcode::JumpGtImmU64;
+                break;
+            case TokenType::SymbolGreaterEqual:
+                opcode = is_signed ? Opcode::JumpGeImmI64 : Opcode::JumpGeImmU64;
+                break;
+            case TokenType::SymbolEqual:
+                opcode = Opcode::JumpEqImm;
+                break;
+            default:
+                opcode = Opcode::JumpNeImm;
+                break;
+        }
+        uint16_t bits = static_cast<uint16_t>(value);
+        return emit(opcode, reg, bits & 0xFF, bits >> 8, 0, token);
+    }
+    uint32_t base = top;
+    uint8_t temp = alloc(at);
+    Value constant;
+    constant.wide = static_cast<u128>(value);
+    load(temp, type, constant, token);
+    top = base;
+    return jump_registers(relation, type, reg, temp, token);
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "dove/diagnostics.h"
+#include "dove/token.h"
+#include "dove/type.h"
+
+#include <format>
+
+using namespace Dove;
+
+namespace {
+
+std::string_view radix_name(uint32_t radix) {
+    return radix == 2 ? "binary" : radix == 8 ? "octal" : "hexadecimal";
+}
+
+// A token kind in a parser message
+std::string describe(uint32_t found) {
+    if (found >= token_type_count) return "the end of the file";
+    switch (TokenType type = static_cast<TokenType>(found)) {
+        case TokenType::ValueIdentifier:
+        case TokenType::ValueInteger:
+        case TokenType::PrefixBinary:
+        case TokenType::PrefixOctal:
+        case TokenType::PrefixHexadecimal:
+        case TokenType::Error:
+            return std::format("an {}", token_name(type));
+        case TokenType::ValueFloatingPointNumber:
+        case TokenType::ValueString:
+        case TokenType::ValueCharacter:
+            return std::format("a {}", token_name(type));
+        default:
+            return std::format("'{}'", token_name(type));
+    }
+}
+
+// A type in a compiler message
+std::string describe_type(uint32_t kind) {
+    switch (TypeKind type = static_cast<TypeKind>(kind)) {
+        case TypeKind::Unit:
+            return "no value";
+        case TypeKind::Obj:
+            return "an object";
+        case TypeKind::Iterator:
+            return "an iterator";
+        case TypeKind::String:
+            return "a string";
+        default:
+            return std::format("'{}'", type_name(type));
+    }
+}
+
+} // namespace
+
+ErrorType Diagnostic::type() const {
+    switch (message) {
+        case Message::InvalidUtf8Byte:
+            return LexerError::InvalidUtf8;
+        case Message::UnexpectedCodePoint:
+        case Message::UnexpectedByte:
+            return LexerError::UnexpectedLexeme;
+        case Message::StringNotTerminated:
+            return LexerError::StringNotTerminated;
+        case Message::EmptyCharacter:
+            return LexerError::EmptyCharacterLiteral;
+        case Message::ExpectedCharNotString:
+            return LexerError::ExpectedCharNotString;
+        case Message::CharacterNotTerminated:
+            return LexerError::CharacterNotTerminated;
+        case Message::UnknownEscape:
+            return LexerError::InvalidEscapeSequence;
+        case Message::FloatOutOfRange:
+            return LexerError::FloatOutOfRange;
+        case Message::IntegerOverflow:
+            return LexerError::IntegerOverflow;
+        case Message::MissingDigits:
+        case Message::InvalidDigit:
+            return LexerError::InvalidNumberLiteral;
+        case Message::ExpectedToken:
+            return ParserError::UnexpectedToken;
+        case Message::ExpectedExpression:
+            return ParserError::ExpectedExpression;
+        case Message::ExpectedType:
+            return ParserError::ExpectedType;
+        case Message::ExpectedItem:
+        case Message::ExpectedMember:
+            return ParserError::ExpectedItem;
+        case Message::InvalidAssignment:
+            return ParserError::InvalidAssignmentTarget;
+        case Message::UnknownName:
+        case Message::UnknownMember:
+            return CompileError::UnknownName;
+        case Message::TypeMismatch:
+            return CompileError::TypeMismatch;
+        case Message::InvalidOperand:
+        case Message::NotCallable:
+        case Message::AssignToConstant:
+        case Message::BreakOutsideLoop:
+            return CompileError::InvalidOperation;
+        case Message::ArgumentCount:
+        case Message::FormatArguments:
+            return CompileError::ArgumentCount;
+        case Message::OutOfRange:
+            return CompileError::OutOfRange;
+        case Message::MissingFallback:
+            return CompileError::MissingFallback;
+        case Message::MissingMain:
+            return CompileError::MissingMain;
+        case Message::Unsupported:
+            return CompileError::Unsupported;
+        case Message::TooManyRegisters:
+            return CompileError::TooManyRegisters;
+        case Message::DivisionByZero:
+            return RuntimeError::DivisionByZero;
+        case Message::StackOverflow:
+            return RuntimeError::StackOverflow;
+    }
+    return LexerError::UnexpectedLexeme;
+}
+
+CompilerError Diagnostic::to_error() const {
+    std::string text;
+    switch (message) {
+        case Message::InvalidUtf8Byte:
+            text = std::format("Invalid UTF-8 byte (0x{:02X}).", args[0]);
+            break;
+        case Message::UnexpectedCodePoint:
+            text = std::format("Unexpected character (U+{:04X}).", args[0]);
+            break;
+        case Message::UnexpectedByte:
+            text = std::format("Unexpected character (0x{:02X}).", args[0]);
+            break;
+        case Message::StringNotTerminated:
+            text = "Strings should end with a double quote. Multi-line strings are not yet "
+                   "supported.";
+            break;
+        case Message::EmptyCharacter:
+            text = "Character value is empty.";
+            break;
+        case Message::ExpectedCharNotString:
+            text = "A single character should be written between single-quotes.";
+            break;
+        case Message::CharacterNotTerminated:
+            text = "Characters should end with a single quote.";
+            break;
+        case Message::UnknownEscape:
+            text = std::format("Unknown escape sequence (\\{}).", static_cast<char>(args[0]));
+            break;
+        case Message::FloatOutOfRange:
+            text = "Floating point literal is out of range.";
+            break;
+        case Message::IntegerOverflow:
+            text = "Integer literal does not fit in 128 bits.";
+            break;
+        case Message::MissingDigits:
+            text = std::format("Expected {} digits after the prefix.", radix_name(args[0]));
+            break;
+        case Message::InvalidDigit:
+            text = std::format("Invalid digit '{}' in {} literal.", static_cast<char>(args[0]),
+                               radix_name(args[1]));
+            break;
+        case Message::ExpectedToken:
+            text = std::format("Expected {} but found {}.", describe(args[0]), describe(args[1]));
+            break;
+        case Message::ExpectedExpression:
+            text = std::format("Expected an expression but found {}.", describe(args[0]));
+            break;
+        case Message::ExpectedType:
+            text = std::format("Expected a type but found {}.", describe(args[0]));
+            break;
+        case Message::ExpectedItem:
+            text = std::format("Expected 'use', 'obj', 'func', 'let' or 'const' but found {}.",
+                               describe(args[0]));
+            break;
+        case Message::ExpectedMember:
+            text = std::format("Expected a field or method but found {}.", describe(args[0]));
+            break;
+        case Message::InvalidAssignment:
+            text = "Only variables, members, elements and dereferences can be assigned to.";
+            break;
+        case Message::UnknownName:
+            text = "Nothing with this name is in scope.";
+            break;
+        case Message::UnknownMember:
+            text = "The object has no field or method with this name.";
+            break;
+        case Message::TypeMismatch:
+            text = std::format("Expected {} but found {}.", describe_type(args[0]),
+                               describe_type(args[1]));
+            break;
+        case Message::InvalidOperand:
+            text = std::format("'{}' cannot be applied to {}.",
+                               token_name(static_cast<TokenType>(args[0])), describe_type(args[1]));
+            break;
+        case Message::NotCallable:
+            text = "Only functions, methods and natives can be called.";
+            break;
+        case Message::AssignToConstant:
+            text = "Constants cannot be assigned to.";
+            break;
+        case Message::BreakOutsideLoop:
+            text = "'brk' outside of a loop, or with a value out of a 'while' or 'for'.";
+            break;
+        case Message::ArgumentCount:
+            text = std::format("Expected {} argument(s) but found {}.", args[0], args[1]);
+            break;
+        case Message::FormatArguments:
+            text = std::format("The format string has {} placeholder(s) but {} argument(s) "
+                               "follow it.",
+                               args[0], args[1]);
+            break;
+        case Message::OutOfRange:
+            text = std::format("The value does not fit in {}.", describe_type(args[0]));
+            break;
+        case Message::MissingFallback:
+            text = "A match whose value is used needs a 'fallback' arm.";
+            break;
+        case Message::MissingMain:
+            text = "There is no 'main' function without parameters.";
+            break;
+        case Message::Unsupported:
+            text = "This is not supported by the bytecode compiler yet.";
+            break;
+        case Message::TooManyRegisters:
+            text = "The function needs more than 256 registers.";
+            break;
+        case Message::DivisionByZero:
+            text = "Division by zero.";
+            break;
+        case Message::StackOverflow:
+            text = "Stack overflow.";
+            break;
+    }
+    return CompilerError(type(), line, column, std::move(text));
+}
+
+std::string Diagnostics::format() const {
+    std::string out;
+    for (const Diagnostic &diagnostic : records) {
+        out += diagnostic.format();
+        out += '\n';
+    }
+    return out;
+}
@@ -0,0 +1,121 @@
+#include "dove/interner.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Dove;
+
+namespace {
+
+constexpr size_t initial_slots = 1024;
+
+} // namespace
+
+Interner::Interner() : arena(16 * 1024), slots(initial_slots, Slot{0, 0}) {}
+
+uint32_t Interner::hash(std::string_view str) {
+    // Multiply-xorshift over 8-byte words; names are short, so this is a couple of rounds
+    constexpr uint64_t k = 0x9E3779B97F4A7C15;
+    uint64_t h = str.length() * k;
+    const char *it = str.data();
+    size_t len = str.length();
+
+    for (; len >= 8; it += 8, len -= 8) {
+        uint64_t word;
+        std::memcpy(&word, it, sizeof(word));
+        h = (h ^ word) * k;
+        h ^= h >> 29;
+    }
+    if (len) {
+        uint64_t word = 0;
+        std::memcpy(&word, it, len);
+        h = (h ^ word) * k;
+        h ^= h >> 29;
+    }
+    return static_cast<uint32_t>(h ^ h >> 32);
+}
+
+SymbolId Interner::intern(std::string_view str, uint32_t hash) {
+    size_t mask = slots.size() - 1;
+    for (size_t idx = hash & mask;; idx = (idx + 1) & mask) {
+        Slot &slot = slots[idx];
+        if (slot.id == 0) {
+            SymbolId id = static_cast<SymbolId>(names.size());
+            names.push_back(arena.copy(str));
+            hashes.push_back(hash);
+            slot = Slot{hash, id + 1};
+            if (names.size() * 2 > slots.size()) grow();
+            return id;
+        }
+        if (slot.hash == hash && names[slot.id - 1] == str) {
+            return slot.id - 1;
+        }
+    }
+}
+
+SymbolId Interner::find(std::string_view str) const {
+    uint32_t h = hash(str);
+    size_t mask = slots.size() - 1;
+    for (size_t idx = h & mask;; idx = (idx + 1) & mask) {
+        const Slot &slot = slots[idx];
+        if (slot.id == 0) return none;
+        if (slot.hash == h && names[slot.id - 1] == str) return slot.id - 1;
+    }
+}
+
+void Interner::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{0, 0});
+    old.swap(slots);
+
+    size_t mask = slots.size() - 1;
+    for (const Slot &slot : old) {
+        if (slot.id == 0) continue;
+        size_t idx = slot.hash & mask;
+        while (slots[idx].id != 0) idx = (idx + 1) & mask;
+        slots[idx] = slot;
+    }
+}
+
+void Interner::erase_slot(size_t idx) {
+    // Backward-shift deletion: pull later entries of the probe run into the hole so every
+    // remaining entry stays reachable from its home slot
+    size_t mask = slots.size() - 1;
+    size_t hole = idx;
+    for (size_t next = (hole + 1) & mask; slots[next].id != 0; next = (next + 1) & mask) {
+        size_t home = slots[next].hash & mask;
+        // Move it unless its home lies cyclically in (hole, next]
+        bool reachable = hole <= next ? hole < home && home <= next : hole < home || home <= next;
+        if (!reachable) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = Slot{0, 0};
+}
+
+void Interner::truncate(size_t count) {
+    size_t mask = slots.size() - 1;
+    while (names.size() > count) {
+        uint32_t id = static_cast<uint32_t>(names.size() - 1);
+        size_t idx = hashes[id] & mask;
+        while (slots[idx].id != id + 1) idx = (idx + 1) & mask;
+        erase_slot(idx);
+        names.pop_back();
+        hashes.pop_back();
+    }
+}
+
+void Interner::clear() {
+    arena.reset();
+    names.clear();
+    hashes.clear();
+    std::fill(slots.begin(), slots.end(), Slot{0, 0});
+}
+
+std::vector<SymbolId> Interner::absorb(const Interner &other) {
+    std::vector<SymbolId> remap(other.size());
+    for (size_t id = 0; id < other.size(); id++) {
+        remap[id] = intern(other.names[id], other.hashes[id]);
+    }
+    return remap;
+}
\ No newline at end of file
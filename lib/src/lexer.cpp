@@ -1,363 +1,215 @@
 #include "dove/lexer.h"
 #include "dove/error.h"
+#include "dove/lexer_tables.h"
 #include "dove/token.h"
+#include "dove/token_cache.h"
+#include "dove/token_stream.h"
+#include "dove/utils/number.h"
+#include "dove/utils/scan.h"
+#include "dove/utils/unicode.h"
 
-#include <unordered_set>
-#include <map>
+#include <bit>
+#include <cstring>
 
 using namespace Dove;
 
-Lexer::Lexer(std::string_view source) : source(source), cursor(0), line(1), column(1) {
-    auto res = start();
-    if (!res) {
-        error = res.error();
+namespace {
+
+#ifdef DOVE_METRICS
+/**
+ * Lexer Metrics
+ *
+ * Sections are the handlers lex_next() dispatches to, plus UTF-8 validation. Counters are
+ * the tokens produced per TokenType (in enum order), then the keyword table outcomes.
+ */
+enum Section : size_t {
+    IdentifierSection,
+    StringSection,
+    CharacterSection,
+    NumberSection,
+    SymbolSection,
+    CommentSection,
+    WhitespaceSection,
+    ValidateSection,
+};
+
+constexpr std::string_view section_names[] = {
+    "identifier", "string", "character", "number", "symbol", "comment", "whitespace", "validate",
+};
+
+enum Counter : size_t {
+    KeywordHits = token_type_count,
+    KeywordMisses,
+    KeywordFiltered, // rejected by length or first byte before hashing
+    BufferGrowths,
+};
+
+constexpr std::string_view counter_names[] = {
+    "tokens.ValueIdentifier",
+    "tokens.ValueInteger",
+    "tokens.ValueFloatingPointNumber",
+    "tokens.ValueString",
+    "tokens.ValueCharacter",
+#define DOVE_COUNTER_NAME(name, spelling) "tokens." #name,
+    DOVE_KEYWORDS(DOVE_COUNTER_NAME)
+    DOVE_SYMBOLS(DOVE_COUNTER_NAME)
+#undef DOVE_COUNTER_NAME
+    "tokens.PrefixBinary",
+    "tokens.PrefixOctal",
+    "tokens.PrefixHexadecimal",
+    "tokens.Error",
+    "keyword_hits",
+    "keyword_misses",
+    "keyword_filtered",
+    "buffer_growths",
+};
+static_assert(std::size(counter_names) == BufferGrowths + 1);
+
+enum Gauge : size_t {
+    BufferPeakBytes,
+};
+
+constexpr std::string_view gauge_names[] = {"buffer_peak_bytes"};
+
+// Same branches as LexerRules::dispatch(), on the bytes at the cursor (`next` is only needed after
+// a '/')
+Section section_of(bool in_comment, uint8_t ch, uint8_t next) {
+    if (in_comment) return CommentSection;
+    switch (ch) {
+        case '\0':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            return WhitespaceSection;
+        case '\'':
+            return CharacterSection;
+        case '"':
+            return StringSection;
+        case '/':
+            if (next == '/' || next == '*') return CommentSection;
+            return SymbolSection;
+        default:
+            if (static_cast<uint8_t>(ch - '0') < 10u) return NumberSection;
+            if (static_cast<uint8_t>((ch | 0x20) - 'a') < 26u || ch == '_' || ch >= 0x80) {
+                return IdentifierSection;
+            }
+            return SymbolSection;
     }
 }
+#endif
 
-std::expected<const std::vector<Token> *, CompilerError> Lexer::get_tokens() {
-    if (error) return std::unexpected<CompilerError>(error.value());
-    return &tokens;
-}
+} // namespace
 
-std::expected<void, CompilerError> Lexer::start() {
-    while (cursor < source.length()) {
-        uint8_t ch = peek();
-        if (ch == '\0') break;
+Lexer::Lexer(std::string_view source) : Lexer(source, Deferred{}) { lex_all(); }
 
-        uint8_t prev = peek_prev();
-        uint8_t next = peek_next();
+Lexer::Lexer() : Lexer({}, Deferred{}) {}
 
-        switch (ch) {
-            case ' ':
-            case '\t':
-            case '\r': {
-                advance();
-                break;
-            }
-            case '\n': {
-                advance();
-                new_line();
-                break;
-            }
-            case '&': {
-                if (prev == '&') {
-                    tokens.push_back(Token{.type = TokenType::SymbolAnd,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != '&') {
-                    tokens.push_back(Token{.type = TokenType::SymbolAmpersand,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '|': {
-                if (prev == '|') {
-                    tokens.push_back(Token{.type = TokenType::SymbolOr,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != '|') {
-                    tokens.push_back(Token{.type = TokenType::SymbolVerticalBar,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '=': {
-                if (prev == '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '!') {
-                    tokens.push_back(Token{.type = TokenType::SymbolNotEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '+') {
-                    tokens.push_back(Token{.type = TokenType::SymbolPlusEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '-') {
-                    tokens.push_back(Token{.type = TokenType::SymbolMinusEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '*') {
-                    tokens.push_back(Token{.type = TokenType::SymbolAsteriskEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '/') {
-                    tokens.push_back(Token{.type = TokenType::SymbolSlashEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '%') {
-                    tokens.push_back(Token{.type = TokenType::SymbolModuloEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '<') {
-                    tokens.push_back(Token{.type = TokenType::SymbolLessEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '>') {
-                    tokens.push_back(Token{.type = TokenType::SymbolGreaterEqual,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolAssign,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '!': {
-                if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolNot,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '+': {
-                if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolPlus,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '-': {
-                if (next != '=' && next != '>') {
-                    tokens.push_back(Token{.type = TokenType::SymbolMinus,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '*': {
-                if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolAsterisk,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '/': {
-                if (next == '/' || next == '*') {
-                    handle_comment();
-                    break;
-                } else if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolSlash,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '%': {
-                if (next != '=') {
-                    tokens.push_back(Token{.type = TokenType::SymbolModulo,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '<': {
-                if (prev == '<') {
-                    tokens.push_back(Token{.type = TokenType::SymbolShiftLeft,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != '=' && next != '<') {
-                    tokens.push_back(Token{.type = TokenType::SymbolLess,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case '>': {
-                if (prev == '>') {
-                    tokens.push_back(Token{.type = TokenType::SymbolShiftRight,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (prev == '-') {
-                    tokens.push_back(Token{.type = TokenType::SymbolArrow,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != '=' && next != '>') {
-                    tokens.push_back(Token{.type = TokenType::SymbolGreater,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case ':': {
-                if (prev == ':') {
-                    tokens.push_back(Token{.type = TokenType::SymbolDoubleColon,
-                                           .str = source.substr(cursor - 1, 2),
-                                           .line = line,
-                                           .column = column - 1});
-                } else if (next != ':') {
-                    tokens.push_back(Token{.type = TokenType::SymbolColon,
-                                           .str = source.substr(cursor, 1),
-                                           .line = line,
-                                           .column = column});
-                }
-                advance();
-                break;
-            }
-            case ';': {
-                tokens.push_back(Token{.type = TokenType::SymbolSemicolon,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '~': {
-                tokens.push_back(Token{.type = TokenType::SymbolTilde,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '.': {
-                tokens.push_back(Token{.type = TokenType::SymbolDot,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case ',': {
-                tokens.push_back(Token{.type = TokenType::SymbolComma,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '(': {
-                tokens.push_back(Token{.type = TokenType::SymbolLeftRoundBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case ')': {
-                tokens.push_back(Token{.type = TokenType::SymbolRightRoundBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '[': {
-                tokens.push_back(Token{.type = TokenType::SymbolLeftSquareBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case ']': {
-                tokens.push_back(Token{.type = TokenType::SymbolRightSquareBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '{': {
-                tokens.push_back(Token{.type = TokenType::SymbolLeftCurlyBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '}': {
-                tokens.push_back(Token{.type = TokenType::SymbolRightCurlyBracket,
-                                       .str = source.substr(cursor, 1),
-                                       .line = line,
-                                       .column = column});
-                advance();
-                break;
-            }
-            case '\'': {
-                auto res = handle_character();
-                if (!res) return std::unexpected<CompilerError>(res.error());
-                advance();
-                break;
-            }
-            case '"': {
-                auto res = handle_string();
-                if (!res) return std::unexpected<CompilerError>(res.error());
-                advance();
-                break;
-            }
-            default: {
-                // Numbers (Integer || Floating Point)
-                if ((ch - '0') < 10u) {
-                    auto res = handle_number();
-                    if (!res) return std::unexpected<CompilerError>(res.error());
-                }
-                // Identifiers && Keywords
-                else if ((ch | 0x20) - 'a' < 26u || ch == '_') {
-                    auto res = handle_identifier();
-                    if (!res) return std::unexpected<CompilerError>(res.error());
-                }
-            }
-        }
+Lexer::Lexer(std::string_view source, Deferred)
+    : LexerRules(source), tokens(source), line_skew(0), ascii(true) {}
+
+#ifdef DOVE_METRICS
+Metrics Lexer::new_metrics() { return Metrics("lexer", section_names, counter_names, gauge_names); }
+#endif
+
+TokenStream Lexer::stream(std::string_view source) { return TokenStream(source); }
+
+TokenStream Lexer::stream(std::string_view source, const TokenCache &cache) {
+    if (auto hit = cache.load(source)) return TokenStream(source, std::move(*hit));
+
+    // Sources with errors are not cached; the plain stream reports the error
+    Lexer lexer(source);
+    if (lexer.diagnostics.empty() && cache.store(source, lexer.tokens, lexer.interner)) {
+        if (auto stored = cache.load(source)) return TokenStream(source, std::move(*stored));
     }
+    return TokenStream(source);
+}
+
+std::expected<void, CompilerError> Lexer::reset(std::string_view source) {
+    rewind(source);
+    lex_all();
+    if (!diagnostics.empty()) return first_error();
     return {};
 }
 
-void Lexer::advance() {
-    if (cursor < source.length()) {
-        cursor++;
-        column++;
+std::expected<void, CompilerError> Lexer::lex_into(std::string_view source, TokenBuffer &out) {
+    std::swap(tokens, out);
+    auto res = reset(source);
+    std::swap(tokens, out);
+    tokens.reset({});
+    this->source = {};
+    return res;
+}
+
+std::expected<const std::vector<Token> *, CompilerError> Lexer::get_tokens() {
+    if (!diagnostics.empty()) return first_error();
+    if (token_views.size() != tokens.size()) {
+        token_views = tokens.to_tokens();
     }
+    return &token_views;
 }
 
-uint8_t Lexer::peek() {
-    if (cursor >= source.length()) {
-        return 0;
+std::expected<const TokenBuffer *, CompilerError> Lexer::get_token_buffer() const {
+    if (!diagnostics.empty()) return first_error();
+    return &tokens;
+}
+
+std::unexpected<CompilerError> Lexer::first_error() const {
+    return diagnostics[0].to_error().unexpected();
+}
+
+void Lexer::rewind(std::string_view source) {
+    this->source = source;
+    tokens.reset(source);
+    interner.clear();
+    token_views.clear();
+    diagnostics.clear();
+    cursor = line_start = line_skew = 0;
+    line = 1;
+    mode = Mode::Code;
+    finished = false;
+    end_of_input = true;
+    ascii = true;
+}
+
+void Lexer::lex_all() {
+    DOVE_METRIC(uint64_t started = Metrics::now();)
+
+    // Validate up front so the handlers only ever see well-formed UTF-8
+    bool valid = validate(0, static_cast<uint32_t>(source.length()));
+    tokens.set_ascii(ascii);
+    DOVE_METRIC(metrics.add(ValidateSection, source.length(), Metrics::now() - started);)
+    if (!valid) return;
+
+    tokens.reserve_for_source();
+    start();
+    DOVE_METRIC(metrics.event("lex", started, Metrics::now());)
+}
+
+void Lexer::start() {
+    while (!finished && cursor < source.length()) lex_next();
+}
+
+void Lexer::lex_next() {
+#ifndef DOVE_METRICS
+    dispatch();
+#else
+    uint8_t ch = peek();
+    Section section = section_of(mode != Mode::Code, ch, ch == '/' ? peek_next() : 0);
+    uint32_t begin = cursor;
+    size_t count = tokens.size();
+    size_t memory = tokens.memory_usage();
+    uint64_t started = Metrics::now();
+
+    dispatch();
+
+    metrics.add(section, cursor - begin, Metrics::now() - started);
+    if (tokens.size() > count) metrics.count(static_cast<size_t>(tokens.kind(count)));
+    if (tokens.memory_usage() != memory) {
+        metrics.count(BufferGrowths);
+        metrics.peak(BufferPeakBytes, tokens.memory_usage());
     }
-    return static_cast<uint8_t>(source[cursor]);
+#endif
 }
 
 uint8_t Lexer::peek_prev(uint32_t n) {
@@ -367,201 +219,111 @@ uint8_t Lexer::peek_prev(uint32_t n) {
     return static_cast<uint8_t>(source[cursor - n]);
 }
 
-uint8_t Lexer::peek_next(uint32_t n) {
-    if (cursor + n >= source.length()) {
-        return 0;
-    }
-    return static_cast<uint8_t>(source[cursor + n]);
-}
-
 void Lexer::new_line() {
     line++;
-    column = 1;
+    line_start = cursor;
+    line_skew = 0;
+    tokens.add_line(cursor);
 }
 
-std::expected<void, CompilerError> Lexer::handle_identifier() {
-    uint32_t start_col = column;
-    uint32_t start_idx = cursor;
-
-    while (cursor < source.length()) {
-        uint8_t ch = peek();
-
-        bool is_valid = ((ch | 0x20) - 'a') < 26u || // a-z, A-Z
-                        (ch - '0') < 10u ||          // 0-9
-                        ch == '_';                   // _
+uint32_t Lexer::column_at(uint32_t offset) const {
+    uint32_t column = offset - line_start + 1;
+    if (ascii) return column;
+    // Columns count code points. A stream may have discarded the start of the line (then
+    // line_start has wrapped around past the offset) and keeps its count in line_skew.
+    uint32_t from = line_start <= offset ? line_start : 0;
+    return column - line_skew -
+           Unicode::continuation_bytes(source.data() + from, source.data() + offset);
+}
 
-        if (is_valid) {
-            advance();
-        } else {
-            break;
+Diagnostic Lexer::invalid_utf8(uint32_t offset) const {
+    // Find the line from the lexer's position; this only runs on the error path
+    uint32_t error_line = line;
+    uint32_t error_line_start = line_start;
+    for (uint32_t idx = cursor; idx < offset; idx++) {
+        if (source[idx] == '\n') {
+            error_line++;
+            error_line_start = idx + 1;
         }
     }
+    uint32_t column = error_line == line ? column_at(offset)
+                                         : offset - error_line_start + 1 -
+                                               Unicode::continuation_bytes(
+                                                   source.data() + error_line_start,
+                                                   source.data() + offset);
+    return Diagnostic{offset,
+                      error_line,
+                      column,
+                      {static_cast<uint8_t>(source[offset]), 0},
+                      Message::InvalidUtf8Byte};
+}
 
-    std::string_view value = source.substr(start_idx, cursor - start_idx);
-    TokenType type = match_token_type(value);
-
-    tokens.push_back(Token{.type = type, .str = value, .line = line, .column = start_col});
-    return {};
+void Lexer::scan_whitespace() {
+    const char *it = source.data() + cursor;
+    advance(Scan::whitespace(it, source.data() + source.length()) - it);
 }
 
-std::expected<void, CompilerError> Lexer::handle_string() {
-    uint32_t start_col = column;
-    uint32_t start_idx = cursor;
-
-    advance(); // "
-    while (cursor < source.length()) {
-        uint8_t ch = peek();
-        uint8_t prev = peek_prev();
-
-        if (prev != '\\' && ch == '"') {
-            break;
-        } else if (ch == '\n' || ch == '\0') {
-            return CompilerError(LexerError::StringNotTerminated, line, start_col,
-                                 "Strings should end with a double quote. Multi-line strings "
-                                 "are not yet supported.")
-                .unexpected();
-        }
-        advance();
-    }
-    std::string_view value = source.substr(start_idx + 1, cursor - start_idx - 1);
-    tokens.push_back(
-        Token{.type = TokenType::ValueString, .str = value, .line = line, .column = start_col});
-    return {};
+void Lexer::scan_identifier() {
+    const char *it = source.data() + cursor;
+    advance(Scan::identifier(it, source.data() + source.length()) - it);
 }
 
-std::expected<void, CompilerError> Lexer::handle_character() {
-    uint32_t start_col = column;
-    uint32_t start_idx = cursor;
-    uint8_t len = 0;
-
-    advance(); // '
-    while (cursor < source.length()) {
-        uint8_t ch = peek();
-        uint8_t prev = peek_prev();
-        uint8_t next = peek_next();
-
-        if (prev != '\\' && ch == '\'') {
-            if (len == 0) {
-                return CompilerError(LexerError::EmptyCharacterLiteral, line, start_col,
-                                     "Character value is empty.")
-                    .unexpected();
-            } else if (len >= 2) {
-                return CompilerError(LexerError::ExpectedCharNotString, line, start_col,
-                                     "A single character should be written between single-quotes.")
-                    .unexpected();
-            }
-            break;
-        }
+void Lexer::scan_digits() {
+    const char *it = source.data() + cursor;
+    advance(Scan::digits(it, source.data() + source.length()) - it);
+}
 
-        if (ch == '\\') {
-            static std::unordered_set<uint8_t> escape_chars = {'a', 'b', 'e',  'f',  'n', 'r',
-                                                               't', 'v', '\\', '\'', '"', '?'};
-            if (escape_chars.find(next) != escape_chars.end()) {
-                advance(); // Skip backslash
-            }
-        }
+void Lexer::scan_quoted(uint8_t quote) {
+    const char *it = source.data() + cursor;
+    advance(Scan::quoted(it, source.data() + source.length(), quote) - it);
+}
 
-        advance();
-        len++;
-    }
+uint32_t Lexer::first_invalid(uint32_t from, uint32_t to) {
+    const char *data = source.data();
+    return static_cast<uint32_t>(Unicode::validate(data + from, data + to, &ascii) - data);
+}
 
-    std::string_view value = source.substr(start_idx + 1, cursor - start_idx - 1);
-    tokens.push_back(
-        Token{.type = TokenType::ValueCharacter, .str = value, .line = line, .column = start_col});
-    return {};
+void Lexer::push(TokenType type, uint32_t offset, uint32_t length, uint32_t value) {
+    tokens.push(type, offset, length, value);
 }
 
-std::expected<void, CompilerError> Lexer::handle_number() {
-    uint32_t start_col = column;
-    uint32_t start_idx = cursor;
-    bool is_floating_point = false;
-
-    // there's gotta be a better way...
-    while (cursor < source.length()) {
-        uint8_t ch = peek();
-        if ((ch - '0') < 10u || (ch == '.' && !is_floating_point && (peek_next() - '0') < 10u)) {
-            if (ch == '.') {
-                is_floating_point = true;
-            }
-            advance();
-        } else {
-            break;
-        }
-    }
+SymbolId Lexer::intern(std::string_view str) { return interner.intern(str); }
 
-    std::string_view value = source.substr(start_idx, cursor - start_idx);
-    tokens.push_back(Token{.type = is_floating_point ? TokenType::ValueFloatingPointNumber
-                                                     : TokenType::ValueInteger,
-                           .str = value,
-                           .line = line,
-                           .column = start_col});
-    return {};
+SymbolId Lexer::intern_escaped(std::string_view str) {
+    unescaped.clear();
+    unescape(str, [this](char ch) { unescaped.push_back(ch); });
+    return interner.intern(unescaped);
 }
 
-void Lexer::handle_comment() {
-    if (peek_next() == '/') {
-        while (cursor < source.length()) {
-            if (peek() == '\n' || peek() == '\0') {
-                break;
-            }
-            advance();
-        }
-    } else if (peek_next() == '*') {
-        advance();
-        advance();
-        while (cursor < source.length()) {
-            if (peek_prev() == '*' && peek() == '/') {
-                advance();
-                break;
-            }
-            if (peek() == '\n') {
-                new_line();
-            }
-            advance();
-        }
-    }
-}
+uint32_t Lexer::add_integer(u128 value) { return tokens.add_integer(value); }
+
+uint32_t Lexer::add_float(double value) { return tokens.add_float(value); }
+
+void Lexer::report(const Diagnostic &diagnostic) { diagnostics.report(diagnostic); }
+
+size_t Lexer::reported() const { return diagnostics.size(); }
 
 TokenType Lexer::match_token_type(std::string_view str) {
-    static const std::map<std::string_view, TokenType> keywords = {
-        {      "i8",          TokenType::TypeI8},
-        {     "i16",         TokenType::TypeI16},
-        {     "i32",         TokenType::TypeI32},
-        {     "i64",         TokenType::TypeI64},
-        {    "i128",        TokenType::TypeI128},
-        {      "u8",          TokenType::TypeU8},
-        {     "u16",         TokenType::TypeU16},
-        {     "u32",         TokenType::TypeU32},
-        {     "u64",         TokenType::TypeU64},
-        {    "u128",        TokenType::TypeU128},
-        {     "f64",         TokenType::TypeF64},
-        {    "f128",        TokenType::TypeF128},
-        {      "ch",          TokenType::TypeCh},
-        {    "bool",        TokenType::TypeBool},
-        {    "true",     TokenType::KeywordTrue},
-        {   "false",    TokenType::KeywordFalse},
-        {     "let",      TokenType::KeywordLet},
-        {     "obj",      TokenType::KeywordObj},
-        {   "const",    TokenType::KeywordConst},
-        {    "func",     TokenType::KeywordFunc},
-        {     "use",      TokenType::KeywordUse},
-        {      "if",       TokenType::KeywordIf},
-        {    "elif",     TokenType::KeywordElif},
-        {    "else",     TokenType::KeywordElse},
-        {   "match",    TokenType::KeywordMatch},
-        {      "is",       TokenType::KeywordIs},
-        {"fallback", TokenType::KeywordFallback},
-        {    "loop",     TokenType::KeywordLoop},
-        {     "for",      TokenType::KeywordFor},
-        {      "in",       TokenType::KeywordIn},
-        {   "while",    TokenType::KeywordWhile},
-        {     "brk",      TokenType::KeywordBrk},
-        {     "rtn",      TokenType::KeywordRtn},
-    };
-
-    auto res = keywords.find(str);
-    if (res != keywords.end()) {
-        return res->second;
+    uint32_t len = str.length();
+    uint8_t first = str[0];
+    if (len < keyword_table.min_len || len > keyword_table.max_len ||
+        !(keyword_table.first_chars[first >> 6] >> (first & 63) & 1)) {
+        DOVE_METRIC(metrics.count(KeywordFiltered);)
+        return TokenType::ValueIdentifier;
     }
-    return TokenType::ValueIdentifier;
+
+    // One word-sized load when 8 bytes are readable, otherwise copy what is there
+    uint64_t word = 0;
+    if (str.data() + sizeof(word) <= source.data() + source.length()) {
+        std::memcpy(&word, str.data(), sizeof(word));
+        word &= std::endian::native == std::endian::little ? ~uint64_t{0} >> (64 - 8 * len)
+                                                           : ~uint64_t{0} << (64 - 8 * len);
+    } else {
+        std::memcpy(&word, str.data(), len);
+    }
+
+    uint32_t slot = keyword_table.slot(word);
+    bool hit = keyword_table.words[slot] == word;
+    DOVE_METRIC(metrics.count(hit ? KeywordHits : KeywordMisses);)
+    return hit ? keyword_table.types[slot] : TokenType::ValueIdentifier;
 }
\ No newline at end of file
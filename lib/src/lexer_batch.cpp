@@ -0,0 +1,56 @@
+#include "dove/lexer.h"
+#include "dove/token_batch.h"
+
+#include <utility>
+
+using namespace Dove;
+
+void Lexer::lex_batch(std::span<const std::string_view> sources, TokenBatch &out) {
+    // Copy the sources first: each gets a NUL sentinel, and the text must not move while
+    // the tokens are made
+    out.text.clear();
+    out.entries.clear();
+    for (std::string_view piece : sources) {
+        out.entries.push_back({static_cast<uint32_t>(out.text.size()), 0, 0, 0});
+        out.text += piece;
+        out.text += '\0';
+    }
+    out.entries.push_back({static_cast<uint32_t>(out.text.size()), 0, 0, 0});
+
+    std::swap(tokens, out.tokens);
+    std::swap(interner, out.interner);
+    std::swap(diagnostics, out.diagnostics);
+    rewind(out.text);
+    tokens.reserve_for_source();
+
+    // Each source is lexed like a parallel chunk: over the text up to its own sentinel,
+    // starting at its first byte on line 1, so offsets are into the whole text
+    bool all_ascii = true;
+    for (size_t idx = 0; idx < sources.size(); idx++) {
+        TokenBatch::Entry &entry = out.entries[idx];
+        uint32_t end = entry.begin + static_cast<uint32_t>(sources[idx].length());
+        if (idx) tokens.add_line(entry.begin);
+        entry.first_token = static_cast<uint32_t>(tokens.size());
+        entry.first_line = static_cast<uint32_t>(tokens.get_line_starts().size());
+        entry.first_diagnostic = static_cast<uint32_t>(diagnostics.size());
+
+        source = std::string_view(out.text.data(), end);
+        cursor = line_start = entry.begin;
+        line = 1;
+        line_skew = 0;
+        mode = Mode::Code;
+        finished = false;
+        ascii = true;
+
+        if (validate(entry.begin, end)) start();
+        all_ascii = all_ascii && ascii;
+    }
+    out.entries.back().first_token = static_cast<uint32_t>(tokens.size());
+    out.entries.back().first_diagnostic = static_cast<uint32_t>(diagnostics.size());
+    tokens.set_ascii(all_ascii);
+
+    std::swap(tokens, out.tokens);
+    std::swap(interner, out.interner);
+    std::swap(diagnostics, out.diagnostics);
+    rewind({});
+}
\ No newline at end of file
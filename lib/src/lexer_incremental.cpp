@@ -0,0 +1,130 @@
+#include "dove/lexer.h"
+#include "dove/utils/unicode.h"
+
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+using namespace Dove;
+
+namespace {
+
+bool is_continuation(char ch) { return (static_cast<uint8_t>(ch) & 0xC0) == 0x80; }
+
+} // namespace
+
+std::expected<void, CompilerError> Lexer::edit(std::string &text, uint32_t offset,
+                                               uint32_t length, std::string_view replacement) {
+    text.replace(offset, length, replacement);
+    source = text;
+    token_views.clear();
+
+    // The rest of the text was valid before, so only the code points around the edit need
+    // checking, unless the last run reported errors
+    const char *data = text.data();
+    uint32_t edit_end = offset + static_cast<uint32_t>(replacement.length());
+    uint32_t check_from = offset >= 4 ? offset - 4 : 0;
+    uint32_t check_to = edit_end;
+    while (check_from < offset && is_continuation(data[check_from])) check_from++;
+    for (int i = 0; i < 3 && check_to < text.length() && is_continuation(data[check_to]); i++) {
+        check_to++;
+    }
+    if (!diagnostics.empty()) {
+        check_from = 0;
+        check_to = static_cast<uint32_t>(text.length());
+        ascii = true;
+    }
+    const char *invalid = Unicode::validate(data + check_from, data + check_to, &ascii);
+    tokens.set_ascii(ascii);
+    if (invalid != data + check_to) {
+        tokens.reset(source);
+        diagnostics.clear();
+        cursor = line_start = line_skew = 0;
+        line = 1;
+        ascii = true;
+        validate(0, static_cast<uint32_t>(text.length()));
+        tokens.set_ascii(ascii);
+        return first_error();
+    }
+
+    // Restart after the last token whose lexing cannot have looked at the edited bytes; the
+    // gap after a token always starts outside of comments
+    auto before_edit = [&](size_t idx) { return tokens.end(idx) + lookahead <= offset; };
+    auto indices = std::views::iota(size_t{0}, tokens.size());
+    size_t first = std::ranges::partition_point(indices, before_edit) - indices.begin();
+    uint32_t restart = first ? tokens.end(first - 1) : 0;
+
+    // The patch is lexed by this lexer, into the scratch buffer and its own interner, as
+    // lex_into() does, so an edit allocates nothing once the scratch buffer has grown
+    uint32_t restart_line = tokens.line_at(restart);
+    line_start = tokens.get_line_starts()[restart_line - 1];
+    line = restart_line;
+    line_skew = 0;
+    cursor = restart;
+    mode = Mode::Code;
+    finished = false;
+    end_of_input = true;
+    std::swap(tokens, edit_tokens);
+    tokens.reset(source);
+
+    // Diagnostics are in source order. Those of the tokens before the restart stay where they
+    // are and the patch reports after them; only the ones past the restart are set aside.
+    auto before = [](uint32_t offset) {
+        return [offset](const Diagnostic &diagnostic) { return diagnostic.offset < offset; };
+    };
+    size_t kept = std::ranges::partition_point(diagnostics, before(restart)) - diagnostics.begin();
+    edit_diagnostics.clear();
+    for (size_t idx = kept; idx < diagnostics.size(); idx++) {
+        edit_diagnostics.report(diagnostics[idx]);
+    }
+    diagnostics.truncate(kept);
+
+    // Once a new token past the edit starts where an old one did, the bytes from there on are
+    // the same and so are the tokens
+    int64_t delta = static_cast<int64_t>(replacement.length()) - length;
+    size_t last = first;
+    bool synced = false;
+    uint32_t old_start = 0;
+    while (!finished && cursor < source.length()) {
+        size_t count = tokens.size();
+        size_t reported = diagnostics.size();
+        lex_next();
+        if (tokens.size() == count || tokens.start(count) < edit_end) continue;
+
+        old_start = static_cast<uint32_t>(tokens.start(count) - delta);
+        while (last < edit_tokens.size() && edit_tokens.start(last) < old_start) last++;
+        if (last < edit_tokens.size() && edit_tokens.start(last) == old_start) {
+            tokens.truncate(count);
+            diagnostics.truncate(reported);
+            synced = true;
+            break;
+        }
+    }
+    std::swap(tokens, edit_tokens);
+
+    if (!synced) {
+        last = tokens.size();
+        old_start = UINT32_MAX;
+    }
+    size_t patched = first + edit_tokens.size();
+    tokens.splice(first, last, edit_tokens, restart, old_start, delta);
+
+    // The diagnostics of the tokens after the sync point move with them: new indices, and
+    // the position is looked up again in the spliced line table
+    size_t tail = std::ranges::partition_point(edit_diagnostics, before(old_start)) -
+                  edit_diagnostics.begin();
+    if (tail != edit_diagnostics.size()) {
+        tokens.shift_diagnostics(patched, static_cast<int64_t>(diagnostics.size()) -
+                                              static_cast<int64_t>(kept + tail));
+        for (size_t idx = tail; idx < edit_diagnostics.size(); idx++) {
+            Diagnostic diagnostic = edit_diagnostics[idx];
+            diagnostic.offset = static_cast<uint32_t>(diagnostic.offset + delta);
+            diagnostic.line = tokens.line_at(diagnostic.offset);
+            diagnostic.column = tokens.column_at(diagnostic.offset);
+            diagnostics.report(diagnostic);
+        }
+    }
+
+    if (!diagnostics.empty()) return first_error();
+    return {};
+}
\ No newline at end of file
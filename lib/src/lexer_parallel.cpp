@@ -0,0 +1,125 @@
+#include "dove/lexer.h"
+#include "dove/utils/thread_pool.h"
+#include "dove/utils/unicode.h"
+
+#include <cstring>
+
+using namespace Dove;
+
+namespace {
+
+// Below this, splitting costs more than it saves
+constexpr size_t min_chunk_size = 256 * 1024;
+
+} // namespace
+
+Lexer Lexer::parallel(std::string_view source, ThreadPool &pool, size_t chunk_size) {
+    Lexer lexer(source, Deferred{});
+    DOVE_METRIC(uint64_t started = Metrics::now();)
+
+    if (chunk_size == 0) {
+        chunk_size = source.length() / (pool.size() * 4);
+        chunk_size = chunk_size < min_chunk_size ? min_chunk_size : chunk_size;
+    }
+
+    // Chunks start right after a '\n': no token, string or line comment crosses a boundary,
+    // only block comments can.
+    std::vector<uint32_t> bounds = {0};
+    while (bounds.back() < source.length()) {
+        size_t target = bounds.back() + chunk_size;
+        if (target >= source.length()) {
+            bounds.push_back(source.length());
+            break;
+        }
+        const void *newline = std::memchr(source.data() + target, '\n', source.length() - target);
+        bounds.push_back(newline ? static_cast<const char *>(newline) - source.data() + 1
+                                 : source.length());
+    }
+    size_t count = bounds.size() - 1;
+
+    if (count <= 1) {
+        return Lexer(source);
+    }
+
+    // Per chunk: offset of its first invalid UTF-8 byte (its end if none), all ASCII or not
+    std::vector<uint32_t> invalid(count);
+    std::vector<uint8_t> ascii(count, true);
+
+    // A chunk lexer sees the source up to the end of its chunk and starts at the beginning of
+    // a line, so offsets are already absolute. Only the line number is unknown up front.
+    auto lex_chunk = [&](size_t idx, Mode mode, uint32_t line) {
+        Lexer chunk(source.substr(0, bounds[idx + 1]), Deferred{});
+        chunk.cursor = bounds[idx];
+        chunk.line_start = bounds[idx];
+        chunk.line = line;
+        chunk.mode = mode;
+        chunk.ascii = ascii[idx];
+        chunk.tokens.reserve((bounds[idx + 1] - bounds[idx]) / 6 + 16, 0);
+        DOVE_METRIC(uint64_t chunk_started = Metrics::now();)
+        chunk.start();
+        DOVE_METRIC(chunk.metrics.event("lex chunk", chunk_started, Metrics::now());)
+        return chunk;
+    };
+
+    // Validate every chunk as UTF-8 (no sequence crosses a '\n') and speculate that it starts
+    // in code. A chunk that fails validation is not lexed.
+    std::vector<Lexer> chunks;
+    chunks.reserve(count);
+    for (size_t i = 0; i < count; i++) chunks.push_back(Lexer({}, Deferred{}));
+    pool.run(count, [&](size_t idx) {
+        const char *begin = source.data() + bounds[idx];
+        const char *end = source.data() + bounds[idx + 1];
+        bool chunk_ascii = true;
+        const char *bad = Unicode::validate(begin, end, &chunk_ascii);
+        invalid[idx] = static_cast<uint32_t>(bad - source.data());
+        ascii[idx] = chunk_ascii;
+        if (invalid[idx] == bounds[idx + 1]) chunks[idx] = lex_chunk(idx, Mode::Code, 1);
+    });
+
+    // The serial lexer validates everything before lexing and stops if anything is invalid;
+    // that is rare enough to report serially
+    for (size_t idx = 0; idx < count; idx++) {
+        lexer.ascii = lexer.ascii && ascii[idx];
+        if (invalid[idx] != bounds[idx + 1]) {
+            lexer.ascii = true;
+            lexer.validate(0, static_cast<uint32_t>(source.length()));
+            lexer.tokens.set_ascii(lexer.ascii);
+            DOVE_METRIC(lexer.metrics.event("lex", started, Metrics::now());)
+            return lexer;
+        }
+    }
+    lexer.tokens.set_ascii(lexer.ascii);
+
+    // Stitch in source order. A chunk whose real entry state differs from the speculation
+    // (it starts inside a block comment) is lexed again from that state. Chunks count lines
+    // from 1, so their diagnostics move down to the line the chunk really starts on.
+    size_t total = 0;
+    for (const auto &chunk : chunks) total += chunk.tokens.size();
+    lexer.tokens.reserve(total, source.length() / 24 + 1);
+
+    Mode mode = Mode::Code;
+    for (size_t idx = 0; idx < count; idx++) {
+        if (mode != Mode::Code) {
+            chunks[idx] = lex_chunk(idx, mode, 1);
+        }
+        Lexer &chunk = chunks[idx];
+
+        uint32_t first_line = static_cast<uint32_t>(lexer.tokens.get_line_starts().size());
+        uint32_t diagnostic_base = static_cast<uint32_t>(lexer.diagnostics.size());
+        for (Diagnostic diagnostic : chunk.diagnostics) {
+            diagnostic.line += first_line - 1;
+            lexer.diagnostics.report(diagnostic);
+        }
+
+        // Absorbing chunk interners in source order assigns ids in first-seen order, as the
+        // serial lexer does
+        std::vector<SymbolId> symbols = lexer.interner.absorb(chunk.interner);
+        lexer.tokens.append(chunk.tokens, symbols, diagnostic_base);
+        // Only the run whose tokens are kept counts; discarded speculation is left out
+        DOVE_METRIC(lexer.metrics.merge(chunk.metrics);)
+        if (chunk.finished) break; // NUL byte: the serial lexer stops here too
+        mode = chunk.mode;
+    }
+    DOVE_METRIC(lexer.metrics.event("lex", started, Metrics::now());)
+    return lexer;
+}
\ No newline at end of file
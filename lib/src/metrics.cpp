@@ -0,0 +1,123 @@
+#include "dove/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+
+using namespace Dove;
+
+namespace {
+
+template <typename T>
+std::optional<T> find(std::span<const std::string_view> names, const std::vector<T> &values,
+                      std::string_view name) {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) return std::nullopt;
+    return values[it - names.begin()];
+}
+
+// Slot names are identifiers from static tables, so they need no JSON escaping
+void append_values(std::string &out, std::span<const std::string_view> names,
+                   const std::vector<uint64_t> &values) {
+    out += '{';
+    for (size_t i = 0; i < names.size(); i++) {
+        out += std::format("{}\"{}\": {}", i ? ", " : "", names[i], values[i]);
+    }
+    out += '}';
+}
+
+} // namespace
+
+Metrics::Metrics(std::string_view phase, std::span<const std::string_view> section_names,
+                 std::span<const std::string_view> counter_names,
+                 std::span<const std::string_view> gauge_names)
+    : phase(phase), section_names(section_names), counter_names(counter_names),
+      gauge_names(gauge_names), sections(section_names.size()), counters(counter_names.size()),
+      gauges(gauge_names.size()) {}
+
+uint64_t Metrics::now() {
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+uint32_t Metrics::thread_id() {
+    static std::atomic<uint32_t> next{0};
+    thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Metrics::event(std::string_view name, uint64_t start_ns, uint64_t end_ns) {
+    events.push_back(Event{.name = name,
+                           .start_ns = start_ns,
+                           .duration_ns = end_ns - start_ns,
+                           .thread = thread_id()});
+}
+
+void Metrics::merge(const Metrics &other) {
+    for (size_t i = 0; i < sections.size(); i++) {
+        sections[i].calls += other.sections[i].calls;
+        sections[i].bytes += other.sections[i].bytes;
+        sections[i].nanoseconds += other.sections[i].nanoseconds;
+    }
+    for (size_t i = 0; i < counters.size(); i++) counters[i] += other.counters[i];
+    for (size_t i = 0; i < gauges.size(); i++) peak(i, other.gauges[i]);
+    events.insert(events.end(), other.events.begin(), other.events.end());
+}
+
+std::optional<Metrics::Section> Metrics::find_section(std::string_view name) const {
+    return find(section_names, sections, name);
+}
+
+std::optional<uint64_t> Metrics::find_counter(std::string_view name) const {
+    return find(counter_names, counters, name);
+}
+
+std::optional<uint64_t> Metrics::find_gauge(std::string_view name) const {
+    return find(gauge_names, gauges, name);
+}
+
+std::string Metrics::to_json() const {
+    std::string out = std::format("{{\"phase\": \"{}\", \"sections\": {{", phase);
+    for (size_t i = 0; i < sections.size(); i++) {
+        out += std::format("{}\"{}\": {{\"calls\": {}, \"bytes\": {}, \"ns\": {}}}", i ? ", " : "",
+                           section_names[i], sections[i].calls, sections[i].bytes,
+                           sections[i].nanoseconds);
+    }
+    out += "}, \"counters\": ";
+    append_values(out, counter_names, counters);
+    out += ", \"gauges\": ";
+    append_values(out, gauge_names, gauges);
+    out += ", \"events\": [";
+    for (size_t i = 0; i < events.size(); i++) {
+        out += std::format("{}{{\"name\": \"{}\", \"start_ns\": {}, \"duration_ns\": {}, "
+                           "\"thread\": {}}}",
+                           i ? ", " : "", events[i].name, events[i].start_ns,
+                           events[i].duration_ns, events[i].thread);
+    }
+    out += "]}";
+    return out;
+}
+
+std::string Metrics::to_chrome_trace(std::span<const Metrics *const> metrics) {
+    // Timestamps are in microseconds, relative to the earliest event
+    uint64_t origin = UINT64_MAX;
+    for (const Metrics *phase : metrics) {
+        for (const Event &event : phase->events) origin = std::min(origin, event.start_ns);
+    }
+
+    std::string out = "{\"traceEvents\": [";
+    bool first = true;
+    for (const Metrics *phase : metrics) {
+        for (const Event &event : phase->events) {
+            out += std::format("{}\n  {{\"name\": \"{}\", \"cat\": \"{}\", \"ph\": \"X\", "
+                               "\"ts\": {:.3f}, \"dur\": {:.3f}, \"pid\": 1, \"tid\": {}}}",
+                               first ? "" : ",", event.name, phase->phase,
+                               (event.start_ns - origin) / 1e3, event.duration_ns / 1e3,
+                               event.thread);
+            first = false;
+        }
+    }
+    out += "\n], \"displayTimeUnit\": \"ns\"}";
+    return out;
+}
\ No newline at end of file
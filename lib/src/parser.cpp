@@ -0,0 +1,688 @@
+#include "dove/parser.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace Dove;
+
+namespace {
+
+/**
+ * Binding powers
+ *
+ * How tightly an infix or postfix operator binds, 0 for tokens that end an expression. An
+ * operator is applied while its power is above the caller's minimum, so the right operand
+ * of a left-associative operator is parsed with the operator's own power and that of a
+ * right-associative one with one less.
+ */
+enum Power : uint8_t {
+    End,
+    Assignment, // right-associative
+    Or,
+    And,
+    Equality,
+    Comparison,
+    BitOr,
+    BitAnd,
+    Shift,
+    Sum,
+    Product,
+    Prefix,
+    Postfix, // calls, members, indexing and paths
+};
+
+constexpr std::array<uint8_t, token_type_count> infix_power = [] {
+    std::array<uint8_t, token_type_count> power{};
+    auto set = [&](std::initializer_list<TokenType> types, Power value) {
+        for (TokenType type : types) power[static_cast<size_t>(type)] = value;
+    };
+    set({TokenType::SymbolAssign, TokenType::SymbolPlusEqual, TokenType::SymbolMinusEqual,
+         TokenType::SymbolAsteriskEqual, TokenType::SymbolSlashEqual,
+         TokenType::SymbolModuloEqual},
+        Assignment);
+    set({TokenType::SymbolOr}, Or);
+    set({TokenType::SymbolAnd}, And);
+    set({TokenType::SymbolEqual, TokenType::SymbolNotEqual}, Equality);
+    set({TokenType::SymbolLess, TokenType::SymbolLessEqual, TokenType::SymbolGreater,
+         TokenType::SymbolGreaterEqual},
+        Comparison);
+    set({TokenType::SymbolVerticalBar}, BitOr);
+    set({TokenType::SymbolAmpersand}, BitAnd);
+    set({TokenType::SymbolShiftLeft, TokenType::SymbolShiftRight}, Shift);
+    set({TokenType::SymbolPlus, TokenType::SymbolMinus}, Sum);
+    set({TokenType::SymbolAsterisk, TokenType::SymbolSlash, TokenType::SymbolModulo}, Product);
+    set({TokenType::SymbolLeftRoundBracket, TokenType::SymbolLeftSquareBracket,
+         TokenType::SymbolDot, TokenType::SymbolDoubleColon},
+        Postfix);
+    return power;
+}();
+
+bool is_primitive_type(TokenType type) {
+    return type >= TokenType::TypeI8 && type <= TokenType::TypeBool;
+}
+
+// Where synchronize() stops: the first token of a statement or item
+bool starts_statement(TokenType type) {
+    switch (type) {
+        case TokenType::KeywordLet:
+        case TokenType::KeywordConst:
+        case TokenType::KeywordRtn:
+        case TokenType::KeywordBrk:
+        case TokenType::KeywordIf:
+        case TokenType::KeywordMatch:
+        case TokenType::KeywordLoop:
+        case TokenType::KeywordWhile:
+        case TokenType::KeywordFor:
+        case TokenType::KeywordUse:
+        case TokenType::KeywordObj:
+        case TokenType::KeywordFunc:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Expressions that end with a block need no `;` to be a statement
+bool ends_with_block(NodeKind kind) {
+    switch (kind) {
+        case NodeKind::Block:
+        case NodeKind::If:
+        case NodeKind::Match:
+        case NodeKind::Loop:
+        case NodeKind::While:
+        case NodeKind::For:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool is_assignable(NodeKind kind, TokenType op) {
+    return kind == NodeKind::Identifier || kind == NodeKind::Member ||
+           kind == NodeKind::Index || (kind == NodeKind::Unary && op == TokenType::SymbolAsterisk);
+}
+
+} // namespace
+
+Parser::Parser(const TokenBuffer &tokens)
+    : Parser(tokens, 0, static_cast<uint32_t>(tokens.size())) {
+    parse_module();
+}
+
+Parser::Parser(const TokenBuffer &tokens, uint32_t begin, uint32_t end)
+    : tokens(tokens), count(end), cursor(begin) {
+    // No two nodes share a token, so with the module there are at most one per token plus
+    // one. The extra array holds about one entry per two tokens and grows if it has to.
+    ast.tokens = &tokens;
+    ast.nodes = ast.arena.allocate_array<Node>(end - begin + 1);
+    ast.extra_capacity = (end - begin) / 2 + 16;
+    ast.extra = ast.arena.allocate_array<uint32_t>(ast.extra_capacity);
+    ast.node_count = 1;
+}
+
+std::expected<const Ast *, CompilerError> Parser::get_ast() const {
+    if (!diagnostics.empty()) return diagnostics[0].to_error().unexpected();
+    return &ast;
+}
+
+bool Parser::accept(TokenType type) {
+    if (!at(type)) return false;
+    cursor++;
+    return true;
+}
+
+bool Parser::expect(TokenType type) {
+    if (accept(type)) return true;
+    report(Message::ExpectedToken, cursor, static_cast<uint32_t>(type), found());
+    return false;
+}
+
+uint32_t Parser::found() const {
+    return cursor < tokens.size() ? static_cast<uint32_t>(tokens.kind(cursor))
+                                  : token_type_count;
+}
+
+NodeId Parser::add(NodeKind kind, uint32_t token, uint32_t lhs, uint32_t rhs, TokenType op,
+                   uint8_t flags) {
+    ast.nodes[ast.node_count] = Node{kind, flags, op, token, lhs, rhs};
+    return ast.node_count++;
+}
+
+uint32_t Parser::add_list(size_t from) {
+    uint32_t length = static_cast<uint32_t>(scratch.size() - from);
+    reserve_extra(length + 1);
+    uint32_t at = ast.extra_count;
+    ast.extra[at] = length;
+    std::copy(scratch.begin() + from, scratch.end(), ast.extra + at + 1);
+    ast.extra_count += length + 1;
+    scratch.resize(from);
+    return at;
+}
+
+uint32_t Parser::add_pair(NodeId first, NodeId second) {
+    reserve_extra(2);
+    uint32_t at = ast.extra_count;
+    ast.extra[at] = first;
+    ast.extra[at + 1] = second;
+    ast.extra_count += 2;
+    return at;
+}
+
+void Parser::reserve_extra(uint32_t n) {
+    if (ast.extra_count + n <= ast.extra_capacity) [[likely]] {
+        return;
+    }
+    // The old array stays in the arena until the Ast goes
+    uint32_t capacity = std::max(ast.extra_capacity * 2, ast.extra_count + n);
+    uint32_t *grown = ast.arena.allocate_array<uint32_t>(capacity);
+    std::copy(ast.extra, ast.extra + ast.extra_count, grown);
+    ast.extra = grown;
+    ast.extra_capacity = capacity;
+}
+
+void Parser::report(Message message, uint32_t at, uint32_t arg0, uint32_t arg1) {
+    if (panicking) return;
+    panicking = true;
+
+    // The end of the file is reported right after the last token
+    uint32_t size = static_cast<uint32_t>(tokens.size());
+    uint32_t offset = at < size ? tokens.start(at) : size ? tokens.end(size - 1) : 0;
+    diagnostics.report(message, offset, tokens.line_at(offset), tokens.column_at(offset), arg0,
+                       arg1);
+}
+
+void Parser::synchronize() {
+    // Skip past the next `;`, or up to the `}` closing the enclosing block or the next
+    // statement or item keyword, whichever comes first outside nested blocks. At least one
+    // token is skipped unless the cursor is at such a `}`, so callers always make progress.
+    panicking = false;
+    uint32_t depth = 0;
+    for (uint32_t start = cursor; cursor < count; cursor++) {
+        TokenType type = tokens.kind(cursor);
+        if (depth == 0) {
+            if (type == TokenType::SymbolRightCurlyBracket) return;
+            if (type == TokenType::SymbolSemicolon) {
+                cursor++;
+                return;
+            }
+            if (cursor != start && starts_statement(type)) return;
+        }
+        if (type == TokenType::SymbolLeftCurlyBracket) {
+            depth++;
+        } else if (type == TokenType::SymbolRightCurlyBracket) {
+            depth--;
+        }
+    }
+}
+
+// Items
+
+void Parser::parse_module() {
+    size_t from = scratch.size();
+    while (cursor < count) {
+        size_t mark = scratch.size();
+        if (NodeId item = parse_item()) {
+            scratch.push_back(item);
+            continue;
+        }
+        scratch.resize(mark);
+        synchronize();
+        if (at(TokenType::SymbolRightCurlyBracket)) cursor++; // nothing to close here
+    }
+    ast.nodes[Ast::root] = Node{NodeKind::Module, 0, {}, 0, add_list(from), 0};
+}
+
+NodeId Parser::parse_item() {
+    switch (peek()) {
+        case TokenType::KeywordUse:
+            return parse_use();
+        case TokenType::KeywordObj:
+            return parse_obj();
+        case TokenType::KeywordFunc:
+            return parse_func();
+        case TokenType::KeywordLet:
+        case TokenType::KeywordConst:
+            return parse_binding();
+        default:
+            report(Message::ExpectedItem, cursor, found());
+            return 0;
+    }
+}
+
+NodeId Parser::parse_use() {
+    uint32_t token = cursor++;
+    NodeId tree = parse_use_tree();
+    if (!tree || !expect(TokenType::SymbolSemicolon)) return 0;
+    return add(NodeKind::Use, token, tree);
+}
+
+NodeId Parser::parse_use_tree() {
+    uint32_t token = cursor;
+    if (accept(TokenType::SymbolLeftCurlyBracket)) {
+        size_t from = scratch.size();
+        while (!at(TokenType::SymbolRightCurlyBracket)) {
+            NodeId tree = parse_use_tree();
+            if (!tree) return 0;
+            scratch.push_back(tree);
+            if (!accept(TokenType::SymbolComma)) break;
+        }
+        if (!expect(TokenType::SymbolRightCurlyBracket)) return 0;
+        return add(NodeKind::UseGroup, token, add_list(from));
+    }
+
+    if (!expect(TokenType::ValueIdentifier)) return 0;
+    if (accept(TokenType::SymbolNot)) {
+        return add(NodeKind::UseName, token, 0, 0, {}, Node::glob);
+    }
+    NodeId name = add(NodeKind::UseName, token);
+    uint32_t path = cursor;
+    if (!accept(TokenType::SymbolDoubleColon)) return name;
+    NodeId rest = parse_use_tree();
+    if (!rest) return 0;
+    return add(NodeKind::UsePath, path, name, rest);
+}
+
+NodeId Parser::parse_obj() {
+    uint32_t token = cursor++;
+    if (!expect(TokenType::ValueIdentifier) || !expect(TokenType::SymbolLeftCurlyBracket)) {
+        return 0;
+    }
+
+    size_t from = scratch.size();
+    while (!at(TokenType::SymbolRightCurlyBracket) && cursor < count) {
+        size_t mark = scratch.size();
+        NodeId member = 0;
+        switch (peek()) {
+            case TokenType::KeywordLet:
+            case TokenType::KeywordConst:
+                member = parse_binding();
+                break;
+            case TokenType::KeywordFunc:
+                member = parse_func();
+                break;
+            default:
+                report(Message::ExpectedMember, cursor, found());
+                break;
+        }
+        if (member) {
+            scratch.push_back(member);
+            continue;
+        }
+        scratch.resize(mark);
+        synchronize();
+    }
+    if (!expect(TokenType::SymbolRightCurlyBracket)) return 0;
+    return add(NodeKind::Obj, token, add_list(from));
+}
+
+NodeId Parser::parse_func() {
+    uint32_t token = cursor++;
+    if (!expect(TokenType::ValueIdentifier) || !expect(TokenType::SymbolLeftRoundBracket)) {
+        return 0;
+    }
+
+    size_t from = scratch.size();
+    while (!at(TokenType::SymbolRightRoundBracket)) {
+        uint32_t name = cursor;
+        if (!expect(TokenType::ValueIdentifier) || !expect(TokenType::SymbolColon)) return 0;
+        NodeId type = parse_type();
+        if (!type) return 0;
+        scratch.push_back(add(NodeKind::Param, name, type));
+        if (!accept(TokenType::SymbolComma)) break;
+    }
+    if (!expect(TokenType::SymbolRightRoundBracket)) return 0;
+
+    NodeId result = 0;
+    if (accept(TokenType::SymbolArrow) && !(result = parse_type())) return 0;
+    NodeId body = parse_block();
+    if (!body) return 0;
+    uint32_t params = add_list(from);
+    return add(NodeKind::Func, token, params, add_pair(result, body));
+}
+
+NodeId Parser::parse_binding() {
+    NodeKind kind = at(TokenType::KeywordLet) ? NodeKind::Let : NodeKind::Const;
+    uint32_t token = cursor++;
+    if (!expect(TokenType::ValueIdentifier)) return 0;
+
+    NodeId type = 0;
+    NodeId value = 0;
+    if (accept(TokenType::SymbolColon) && !(type = parse_type())) return 0;
+    if (accept(TokenType::SymbolAssign) && !(value = parse_expression())) return 0;
+    if (!expect(TokenType::SymbolSemicolon)) return 0;
+    return add(kind, token, type, value);
+}
+
+// Types
+
+NodeId Parser::parse_type() {
+    uint32_t token = cursor;
+    TokenType type = peek();
+    if (is_primitive_type(type)) {
+        cursor++;
+        return add(NodeKind::TypeName, token);
+    }
+
+    switch (type) {
+        case TokenType::ValueIdentifier: {
+            cursor++;
+            NodeId name = add(NodeKind::TypeName, token);
+            while (at(TokenType::SymbolDoubleColon)) {
+                uint32_t path = cursor++;
+                if (!expect(TokenType::ValueIdentifier)) return 0;
+                name = add(NodeKind::Path, path, name);
+            }
+            return name;
+        }
+        case TokenType::SymbolLeftSquareBracket: {
+            // [element, length] or [element, ~]
+            cursor++;
+            NodeId element = parse_type();
+            if (!element || !expect(TokenType::SymbolComma)) return 0;
+            NodeId length = 0;
+            if (!accept(TokenType::SymbolTilde) && !(length = parse_expression())) return 0;
+            if (!expect(TokenType::SymbolRightSquareBracket)) return 0;
+            return add(NodeKind::TypeArray, token, element, length);
+        }
+        case TokenType::SymbolAmpersand:
+        case TokenType::KeywordConst: {
+            cursor++;
+            NodeId inner = parse_type();
+            if (!inner) return 0;
+            NodeKind kind =
+                type == TokenType::SymbolAmpersand ? NodeKind::TypeRef : NodeKind::TypeConst;
+            return add(kind, token, inner);
+        }
+        default:
+            report(Message::ExpectedType, cursor, found());
+            return 0;
+    }
+}
+
+// Statements
+
+NodeId Parser::parse_block() {
+    uint32_t token = cursor;
+    if (!expect(TokenType::SymbolLeftCurlyBracket)) return 0;
+
+    // An expression without a `;` before the `}` is the value of the block
+    size_t from = scratch.size();
+    NodeId value = 0;
+    while (!at(TokenType::SymbolRightCurlyBracket) && cursor < count) {
+        size_t mark = scratch.size();
+        NodeId statement = parse_statement();
+        if (statement) {
+            NodeKind kind = ast.nodes[statement].kind;
+            bool expression = kind != NodeKind::Let && kind != NodeKind::Const &&
+                              kind != NodeKind::Rtn && kind != NodeKind::Brk;
+            if (!expression || accept(TokenType::SymbolSemicolon)) {
+                scratch.push_back(statement);
+                continue;
+            }
+            if (at(TokenType::SymbolRightCurlyBracket)) {
+                value = statement;
+                break;
+            }
+            if (ends_with_block(kind)) {
+                scratch.push_back(statement);
+                continue;
+            }
+            expect(TokenType::SymbolSemicolon);
+        }
+        scratch.resize(mark);
+        synchronize();
+    }
+    if (!expect(TokenType::SymbolRightCurlyBracket)) return 0;
+    return add(NodeKind::Block, token, add_list(from), value);
+}
+
+NodeId Parser::parse_statement() {
+    uint32_t token = cursor;
+    switch (peek()) {
+        case TokenType::KeywordLet:
+        case TokenType::KeywordConst:
+            return parse_binding();
+        case TokenType::KeywordRtn:
+        case TokenType::KeywordBrk: {
+            // The `;` may be left out before a `}`
+            cursor++;
+            NodeId value = 0;
+            if (!at(TokenType::SymbolSemicolon) && !at(TokenType::SymbolRightCurlyBracket) &&
+                !(value = parse_expression())) {
+                return 0;
+            }
+            if (!at(TokenType::SymbolRightCurlyBracket) && !expect(TokenType::SymbolSemicolon)) {
+                return 0;
+            }
+            NodeKind kind = tokens.kind(token) == TokenType::KeywordRtn ? NodeKind::Rtn
+                                                                        : NodeKind::Brk;
+            return add(kind, token, value);
+        }
+        case TokenType::SymbolLeftCurlyBracket:
+        case TokenType::KeywordIf:
+        case TokenType::KeywordMatch:
+        case TokenType::KeywordLoop:
+        case TokenType::KeywordWhile:
+        case TokenType::KeywordFor:
+            // As statements these are complete at their closing `}`: `if a {} -b` is two
+            return parse_prefix();
+        default:
+            return parse_expression();
+    }
+}
+
+NodeId Parser::parse_if() {
+    uint32_t token = cursor++;
+    NodeId condition = parse_expression();
+    if (!condition) return 0;
+    NodeId then = parse_block();
+    if (!then) return 0;
+
+    NodeId otherwise = 0;
+    if (at(TokenType::KeywordElif)) {
+        if (!(otherwise = parse_if())) return 0;
+    } else if (accept(TokenType::KeywordElse)) {
+        otherwise = at(TokenType::KeywordIf) ? parse_if() : parse_block();
+        if (!otherwise) return 0;
+    }
+    return add(NodeKind::If, token, condition, add_pair(then, otherwise));
+}
+
+NodeId Parser::parse_match() {
+    uint32_t token = cursor++;
+    NodeId value = parse_expression();
+    if (!value || !expect(TokenType::SymbolLeftCurlyBracket)) return 0;
+
+    size_t from = scratch.size();
+    while (!at(TokenType::SymbolRightCurlyBracket) && cursor < count) {
+        size_t mark = scratch.size();
+        if (NodeId arm = parse_arm()) {
+            scratch.push_back(arm);
+            continue;
+        }
+        scratch.resize(mark);
+        synchronize();
+    }
+    if (!expect(TokenType::SymbolRightCurlyBracket)) return 0;
+    return add(NodeKind::Match, token, value, add_list(from));
+}
+
+NodeId Parser::parse_arm() {
+    // is [comparison] pattern: value;  or  fallback: value;
+    uint32_t token = cursor;
+    TokenType op = TokenType::SymbolEqual;
+    NodeId pattern = 0;
+    if (accept(TokenType::KeywordIs)) {
+        switch (peek()) {
+            case TokenType::SymbolEqual:
+            case TokenType::SymbolNotEqual:
+            case TokenType::SymbolLess:
+            case TokenType::SymbolLessEqual:
+            case TokenType::SymbolGreater:
+            case TokenType::SymbolGreaterEqual:
+                op = tokens.kind(cursor++);
+                break;
+            default:
+                break;
+        }
+        if (!(pattern = parse_expression())) return 0;
+    } else if (!accept(TokenType::KeywordFallback)) {
+        report(Message::ExpectedToken, cursor, static_cast<uint32_t>(TokenType::KeywordIs),
+               found());
+        return 0;
+    }
+    if (!expect(TokenType::SymbolColon)) return 0;
+
+    NodeId value = parse_expression();
+    if (!value) return 0;
+    if (!accept(TokenType::SymbolSemicolon) && !at(TokenType::SymbolRightCurlyBracket) &&
+        !ends_with_block(ast.nodes[value].kind)) {
+        expect(TokenType::SymbolSemicolon);
+        return 0;
+    }
+    return add(NodeKind::MatchArm, token, pattern, value, op);
+}
+
+NodeId Parser::parse_loop() {
+    uint32_t token = cursor++;
+    uint8_t flags = accept(TokenType::ValueIdentifier) ? Node::labeled : 0;
+    NodeId body = parse_block();
+    if (!body) return 0;
+    return add(NodeKind::Loop, token, body, 0, {}, flags);
+}
+
+NodeId Parser::parse_while() {
+    uint32_t token = cursor++;
+    NodeId condition = parse_expression();
+    if (!condition) return 0;
+    NodeId body = parse_block();
+    if (!body) return 0;
+    return add(NodeKind::While, token, condition, body);
+}
+
+NodeId Parser::parse_for() {
+    uint32_t token = cursor++;
+    if (!expect(TokenType::ValueIdentifier) || !expect(TokenType::KeywordIn)) return 0;
+    NodeId iterable = parse_expression();
+    if (!iterable) return 0;
+    NodeId body = parse_block();
+    if (!body) return 0;
+    return add(NodeKind::For, token, iterable, body);
+}
+
+// Expressions
+
+NodeId Parser::parse_expression(uint8_t min_power) {
+    NodeId lhs = parse_prefix();
+    while (lhs) {
+        TokenType op = peek();
+        uint8_t power = infix_power[static_cast<size_t>(op)];
+        if (power <= min_power) break;
+
+        uint32_t token = cursor++;
+        switch (op) {
+            case TokenType::SymbolLeftRoundBracket:
+                lhs = parse_call(lhs, token);
+                break;
+            case TokenType::SymbolLeftSquareBracket: {
+                NodeId index = parse_expression();
+                if (!index || !expect(TokenType::SymbolRightSquareBracket)) return 0;
+                lhs = add(NodeKind::Index, token, lhs, index);
+                break;
+            }
+            case TokenType::SymbolDot:
+            case TokenType::SymbolDoubleColon:
+                if (!expect(TokenType::ValueIdentifier)) return 0;
+                lhs = add(op == TokenType::SymbolDot ? NodeKind::Member : NodeKind::Path, token,
+                          lhs);
+                break;
+            default:
+                if (power == Assignment) {
+                    const Node &target = ast.nodes[lhs];
+                    if (!is_assignable(target.kind, target.op)) {
+                        report(Message::InvalidAssignment, token);
+                        return 0;
+                    }
+                    NodeId value = parse_expression(power - 1);
+                    lhs = value ? add(NodeKind::Assign, token, lhs, value, op) : 0;
+                } else {
+                    NodeId rhs = parse_expression(power);
+                    lhs = rhs ? add(NodeKind::Binary, token, lhs, rhs, op) : 0;
+                }
+                break;
+        }
+    }
+    return lhs;
+}
+
+NodeId Parser::parse_prefix() {
+    uint32_t token = cursor;
+    TokenType type = peek();
+    switch (type) {
+        case TokenType::ValueIdentifier:
+            cursor++;
+            return add(NodeKind::Identifier, token);
+        case TokenType::ValueInteger:
+        case TokenType::PrefixBinary:
+        case TokenType::PrefixOctal:
+        case TokenType::PrefixHexadecimal:
+            cursor++;
+            return add(NodeKind::Integer, token);
+        case TokenType::ValueFloatingPointNumber:
+            cursor++;
+            return add(NodeKind::Float, token);
+        case TokenType::ValueString:
+            cursor++;
+            return add(NodeKind::String, token);
+        case TokenType::ValueCharacter:
+            cursor++;
+            return add(NodeKind::Character, token);
+        case TokenType::KeywordTrue:
+        case TokenType::KeywordFalse:
+            cursor++;
+            return add(NodeKind::Bool, token);
+        case TokenType::SymbolLeftRoundBracket: {
+            // Grouping needs no node of its own
+            cursor++;
+            NodeId inner = parse_expression();
+            if (!inner || !expect(TokenType::SymbolRightRoundBracket)) return 0;
+            return inner;
+        }
+        case TokenType::SymbolMinus:
+        case TokenType::SymbolNot:
+        case TokenType::SymbolAmpersand:
+        case TokenType::SymbolAsterisk: {
+            cursor++;
+            NodeId operand = parse_expression(Prefix);
+            if (!operand) return 0;
+            return add(NodeKind::Unary, token, operand, 0, type);
+        }
+        case TokenType::SymbolLeftCurlyBracket:
+            return parse_block();
+        case TokenType::KeywordIf:
+            return parse_if();
+        case TokenType::KeywordMatch:
+            return parse_match();
+        case TokenType::KeywordLoop:
+            return parse_loop();
+        case TokenType::KeywordWhile:
+            return parse_while();
+        case TokenType::KeywordFor:
+            return parse_for();
+        default:
+            report(Message::ExpectedExpression, cursor, found());
+            return 0;
+    }
+}
+
+NodeId Parser::parse_call(NodeId callee, uint32_t token) {
+    size_t from = scratch.size();
+    while (!at(TokenType::SymbolRightRoundBracket)) {
+        NodeId argument = parse_expression();
+        if (!argument) return 0;
+        scratch.push_back(argument);
+        if (!accept(TokenType::SymbolComma)) break;
+    }
+    if (!expect(TokenType::SymbolRightRoundBracket)) return 0;
+    return add(NodeKind::Call, token, callee, add_list(from));
+}
\ No newline at end of file
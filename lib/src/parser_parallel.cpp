@@ -0,0 +1,149 @@
+#include "dove/parser.h"
+#include "dove/utils/thread_pool.h"
+
+#include <algorithm>
+#include <span>
+
+using namespace Dove;
+
+namespace {
+
+// Below this, splitting costs more than it saves
+constexpr size_t min_chunk_tokens = 64 * 1024;
+
+bool starts_item(TokenType type) {
+    switch (type) {
+        case TokenType::KeywordUse:
+        case TokenType::KeywordObj:
+        case TokenType::KeywordFunc:
+        case TokenType::KeywordLet:
+        case TokenType::KeywordConst:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+Parser Parser::parallel(const TokenBuffer &tokens, ThreadPool &pool, size_t chunk_tokens) {
+    uint32_t count = static_cast<uint32_t>(tokens.size());
+    if (chunk_tokens == 0) {
+        // With no other thread, the merge is pure overhead
+        if (pool.size() == 1) return Parser(tokens);
+        chunk_tokens = count / (pool.size() * 4);
+        chunk_tokens = std::max(chunk_tokens, min_chunk_tokens);
+    }
+
+    // An item starts at an item keyword right after a `;` or `}` outside every bracket (a
+    // `const` anywhere else qualifies a type). Each piece is a run of whole items of at least
+    // `chunk_tokens` tokens. Unbalanced closing brackets are ignored, as synchronize() skips
+    // them at the top level.
+    std::vector<uint32_t> bounds = {0};
+    uint32_t depth = 0;
+    for (uint32_t i = 1; i < count; i++) {
+        TokenType previous = tokens.kind(i - 1);
+        switch (previous) {
+            case TokenType::SymbolLeftRoundBracket:
+            case TokenType::SymbolLeftSquareBracket:
+            case TokenType::SymbolLeftCurlyBracket:
+                depth++;
+                break;
+            case TokenType::SymbolRightRoundBracket:
+            case TokenType::SymbolRightSquareBracket:
+            case TokenType::SymbolRightCurlyBracket:
+                depth -= depth != 0;
+                break;
+            default:
+                break;
+        }
+        if (depth == 0 && i - bounds.back() >= chunk_tokens && starts_item(tokens.kind(i)) &&
+            (previous == TokenType::SymbolSemicolon ||
+             previous == TokenType::SymbolRightCurlyBracket)) {
+            bounds.push_back(i);
+        }
+    }
+    bounds.push_back(count);
+    size_t pieces = bounds.size() - 1;
+
+    if (pieces <= 1) {
+        return Parser(tokens);
+    }
+
+    // Every piece is parsed into an Ast, and so an arena, of its own
+    std::vector<Ast> asts(pieces);
+    std::vector<Diagnostics> diagnostics(pieces);
+    pool.run(pieces, [&](size_t idx) {
+        Parser piece(tokens, bounds[idx], bounds[idx + 1]);
+        piece.parse_module();
+        asts[idx] = piece.take_ast();
+        diagnostics[idx] = std::move(piece.diagnostics);
+    });
+
+    // A piece has a module of its own at node 0, whose list is the last thing in its extra
+    // array. The merged Ast takes every other node and extra entry of every piece, in source
+    // order, which is where the serial parser puts them, and one module list at the end.
+    std::vector<uint32_t> node_base(pieces + 1);
+    std::vector<uint32_t> extra_base(pieces + 1);
+    std::vector<uint32_t> item_base(pieces + 1);
+    for (size_t idx = 0; idx < pieces; idx++) {
+        const Ast &piece = asts[idx];
+        uint32_t items = piece.nodes[Ast::root].lhs;
+        node_base[idx + 1] = node_base[idx] + piece.node_count - 1;
+        extra_base[idx + 1] = extra_base[idx] + items;
+        item_base[idx + 1] = item_base[idx] + piece.extra[items];
+    }
+
+    Parser parser(tokens, 0, 0);
+    Ast &ast = parser.ast;
+    uint32_t module_list = extra_base[pieces];
+    ast.node_count = node_base[pieces] + 1;
+    ast.extra_count = module_list + 1 + item_base[pieces];
+    ast.extra_capacity = ast.extra_count;
+    ast.nodes = ast.arena.allocate_array<Node>(ast.node_count);
+    ast.extra = ast.arena.allocate_array<uint32_t>(ast.extra_capacity);
+    ast.nodes[Ast::root] = Node{NodeKind::Module, 0, {}, 0, module_list, 0};
+    ast.extra[module_list] = item_base[pieces];
+
+    // Pieces land at offsets known up front, so they are copied concurrently. Node ids move
+    // up by the nodes of the pieces before, extra indices by their extra entries; 0 stays
+    // "none".
+    pool.run(pieces, [&](size_t idx) {
+        const Ast &piece = asts[idx];
+        uint32_t nodes = node_base[idx];
+        uint32_t extra = extra_base[idx];
+        uint32_t *out = ast.extra + extra;
+        std::copy(piece.extra, piece.extra + piece.nodes[Ast::root].lhs, out);
+
+        auto relocate = [&](Operand operand, uint32_t value) -> uint32_t {
+            switch (operand) {
+                case Operand::None:
+                    return value;
+                case Operand::Node:
+                    return value ? value + nodes : 0;
+                case Operand::List:
+                    for (uint32_t &child : std::span(out + value + 1, out[value])) {
+                        child += child ? nodes : 0;
+                    }
+                    return value + extra;
+                case Operand::Pair:
+                    out[value] += out[value] ? nodes : 0;
+                    out[value + 1] += out[value + 1] ? nodes : 0;
+                    return value + extra;
+            }
+            return value;
+        };
+        for (uint32_t id = 1; id < piece.node_count; id++) {
+            Node node = piece.nodes[id];
+            node.lhs = relocate(lhs_operand(node.kind), node.lhs);
+            node.rhs = relocate(rhs_operand(node.kind), node.rhs);
+            ast.nodes[id + nodes] = node;
+        }
+
+        uint32_t *items = ast.extra + module_list + 1 + item_base[idx];
+        for (NodeId item : piece.list(piece.nodes[Ast::root].lhs)) *items++ = item + nodes;
+    });
+
+    for (const Diagnostics &piece : diagnostics) parser.diagnostics.append(piece);
+    return parser;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "dove/source_manager.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Dove;
+
+namespace {
+
+// Token offsets are 32-bit
+constexpr size_t max_source_size = UINT32_MAX - SourceManager::padding;
+
+size_t round_up(size_t value, size_t align) { return (value + align - 1) / align * align; }
+
+// Map `size` bytes of `fd` followed by zeroed anonymous pages. Bytes between the end of the
+// file and the end of its last page are zero-filled by the kernel.
+void *map_padded(int fd, size_t size, size_t *mapping_size) {
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t total = round_up(size + SourceManager::padding, page);
+
+    void *base = mmap(nullptr, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return nullptr;
+
+    if (mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, total);
+        return nullptr;
+    }
+    madvise(base, size, MADV_SEQUENTIAL);
+
+    *mapping_size = total;
+    return base;
+}
+
+} // namespace
+
+SourceManager::~SourceManager() {
+    for (auto &file : files) {
+        if (file.mapping) munmap(file.mapping, file.mapping_size);
+    }
+}
+
+std::optional<FileId> SourceManager::load(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return std::nullopt;
+    }
+
+    // Regular, non-empty files are mapped
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = static_cast<size_t>(st.st_size);
+        if (size > max_source_size) {
+            close(fd);
+            errno = EFBIG;
+            return std::nullopt;
+        }
+
+        size_t mapping_size = 0;
+        if (void *mapping = map_padded(fd, size, &mapping_size)) {
+            close(fd);
+            File file;
+            file.path = path;
+            file.text = std::string_view(static_cast<const char *>(mapping), size);
+            file.mapping = mapping;
+            file.mapping_size = mapping_size;
+            files.push_back(std::move(file));
+            return static_cast<FileId>(files.size() - 1);
+        }
+    }
+
+    // Everything else (pipes, empty files, failed mappings) is read once into a padded buffer
+    size_t capacity = S_ISREG(st.st_mode) && st.st_size > 0 ? st.st_size : 64 * 1024;
+    auto buffer = std::make_unique<char[]>(capacity + padding);
+    size_t size = 0;
+    while (true) {
+        if (size == capacity) {
+            if (capacity > max_source_size) {
+                close(fd);
+                errno = EFBIG;
+                return std::nullopt;
+            }
+            auto grown = std::make_unique<char[]>(capacity * 2 + padding);
+            std::memcpy(grown.get(), buffer.get(), size);
+            buffer = std::move(grown);
+            capacity *= 2;
+        }
+
+        ssize_t n = read(fd, buffer.get() + size, capacity - size);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            int err = errno;
+            close(fd);
+            errno = err;
+            return std::nullopt;
+        }
+        size += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    if (size > max_source_size) {
+        errno = EFBIG;
+        return std::nullopt;
+    }
+    return add_buffer(path, std::move(buffer), size);
+}
+
+FileId SourceManager::add(std::string name, std::string_view contents) {
+    auto buffer = std::make_unique<char[]>(contents.length() + padding);
+    std::memcpy(buffer.get(), contents.data(), contents.length());
+    return add_buffer(std::move(name), std::move(buffer), contents.length());
+}
+
+FileId SourceManager::add_buffer(std::string path, std::unique_ptr<char[]> buffer, size_t size) {
+    std::memset(buffer.get() + size, 0, padding);
+
+    File file;
+    file.path = std::move(path);
+    file.text = std::string_view(buffer.get(), size);
+    file.buffer = std::move(buffer);
+    files.push_back(std::move(file));
+    return static_cast<FileId>(files.size() - 1);
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "dove/token_batch.h"
+
+#include <algorithm>
+
+using namespace Dove;
+
+size_t TokenBatch::source_of(size_t idx) const {
+    // The first entry whose tokens start after `idx`, minus one. Empty sources share their
+    // first token with the next one, so take the last of equal starts.
+    auto it = std::upper_bound(
+        entries.begin(), entries.end(), static_cast<uint32_t>(idx),
+        [](uint32_t idx, const Entry &entry) { return idx < entry.first_token; });
+    return it - entries.begin() - 1;
+}
+
+uint32_t TokenBatch::line(size_t idx) const {
+    return tokens.line(idx) - entries[source_of(idx)].first_line + 1;
+}
+
+Token TokenBatch::token(size_t idx) const {
+    Token token = tokens.token(idx);
+    token.line = line(idx);
+    return token;
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "dove/token_buffer.h"
+#include "dove/utils/unicode.h"
+
+#include <algorithm>
+
+using namespace Dove;
+
+namespace {
+
+// Overwrite [first, last) of `column` with `with`, moving the tail once
+template <typename T>
+void replace_range(std::vector<T> &column, size_t first, size_t last, std::span<const T> with) {
+    size_t count = last - first;
+    if (with.size() > count) {
+        column.insert(column.begin() + last, with.size() - count, T{});
+    } else {
+        column.erase(column.begin() + first + with.size(), column.begin() + last);
+    }
+    std::copy(with.begin(), with.end(), column.begin() + first);
+}
+
+} // namespace
+
+TokenBuffer::TokenBuffer(std::string_view source) : source(source) { line_starts.push_back(0); }
+
+void TokenBuffer::reserve(size_t tokens, size_t lines) {
+    kinds.reserve(tokens);
+    offsets.reserve(tokens);
+    lengths.reserve(tokens);
+    values.reserve(tokens);
+    line_starts.reserve(lines);
+}
+
+void TokenBuffer::reserve_for_source() {
+    // Typical Dove sources average 6-10 bytes per token and 25-40 bytes per line
+    reserve(source.length() / 6 + 16, source.length() / 24 + 1);
+}
+
+void TokenBuffer::reset(std::string_view source) {
+    this->source = source;
+    clear();
+}
+
+void TokenBuffer::clear() {
+    kinds.clear();
+    offsets.clear();
+    lengths.clear();
+    long_lengths.clear();
+    values.clear();
+    integers.clear();
+    floats.clear();
+    line_starts.assign(1, 0);
+    dead_literals = 0;
+}
+
+void TokenBuffer::append(const TokenBuffer &other, std::span<const uint32_t> symbols,
+                         uint32_t diagnostic_base) {
+    uint32_t base = static_cast<uint32_t>(size());
+    kinds.insert(kinds.end(), other.kinds.begin(), other.kinds.end());
+    offsets.insert(offsets.end(), other.offsets.begin(), other.offsets.end());
+    lengths.insert(lengths.end(), other.lengths.begin(), other.lengths.end());
+    for (auto [idx, length] : other.long_lengths) long_lengths.emplace_back(base + idx, length);
+    values.insert(values.end(), other.values.begin(), other.values.end());
+
+    // Rebase literal and diagnostic indices and remap symbols
+    uint32_t integer_base = static_cast<uint32_t>(integers.size());
+    uint32_t float_base = static_cast<uint32_t>(floats.size());
+    integers.insert(integers.end(), other.integers.begin(), other.integers.end());
+    floats.insert(floats.end(), other.floats.begin(), other.floats.end());
+    for (size_t idx = base; idx < size(); idx++) {
+        if (has_integer(kinds[idx])) {
+            values[idx] += integer_base;
+        } else if (kinds[idx] == TokenType::ValueFloatingPointNumber) {
+            values[idx] += float_base;
+        } else if (!symbols.empty() && has_symbol(kinds[idx])) {
+            values[idx] = symbols[values[idx]];
+        } else if (kinds[idx] == TokenType::Error) {
+            values[idx] += diagnostic_base;
+        }
+    }
+    // Every buffer's line table starts with an implicit first line
+    line_starts.insert(line_starts.end(), other.line_starts.begin() + 1, other.line_starts.end());
+}
+
+void TokenBuffer::shift_diagnostics(size_t from, int64_t delta) {
+    if (delta == 0) return;
+    for (size_t idx = from; idx < size(); idx++) {
+        if (kinds[idx] == TokenType::Error) {
+            values[idx] = static_cast<uint32_t>(values[idx] + delta);
+        }
+    }
+}
+
+void TokenBuffer::truncate(size_t count) {
+    for (size_t idx = size(); idx-- > count;) {
+        if (has_integer(kinds[idx])) {
+            integers.pop_back();
+        } else if (kinds[idx] == TokenType::ValueFloatingPointNumber) {
+            floats.pop_back();
+        }
+    }
+    kinds.resize(count);
+    offsets.resize(count);
+    lengths.resize(count);
+    values.resize(count);
+    while (!long_lengths.empty() && long_lengths.back().first >= count) long_lengths.pop_back();
+}
+
+void TokenBuffer::splice(size_t first, size_t last, const TokenBuffer &patch, uint32_t from,
+                         uint32_t to, int64_t delta) {
+    // The replaced tokens' literals stay in the tables until they outnumber the live ones
+    for (size_t idx = first; idx < last; idx++) {
+        TokenType kind = kinds[idx];
+        dead_literals += has_integer(kind) || kind == TokenType::ValueFloatingPointNumber;
+    }
+    uint32_t integer_base = static_cast<uint32_t>(integers.size());
+    uint32_t float_base = static_cast<uint32_t>(floats.size());
+    integers.insert(integers.end(), patch.integers.begin(), patch.integers.end());
+    floats.insert(floats.end(), patch.floats.begin(), patch.floats.end());
+
+    replace_range<TokenType>(kinds, first, last, patch.kinds);
+    replace_range<uint32_t>(offsets, first, last, patch.offsets);
+    replace_range<uint16_t>(lengths, first, last, patch.lengths);
+    replace_range<uint32_t>(values, first, last, patch.values);
+
+    size_t tail = first + patch.size();
+    for (size_t idx = first; idx < tail; idx++) {
+        if (has_integer(kinds[idx])) {
+            values[idx] += integer_base;
+        } else if (kinds[idx] == TokenType::ValueFloatingPointNumber) {
+            values[idx] += float_base;
+        }
+    }
+    // Unsigned wrap-around applies a negative delta too
+    uint32_t shift = static_cast<uint32_t>(delta);
+    for (size_t idx = tail; idx < size(); idx++) offsets[idx] += shift;
+
+    auto by_index = [](const std::pair<uint32_t, uint32_t> &entry, size_t idx) {
+        return entry.first < idx;
+    };
+    auto lower = std::lower_bound(long_lengths.begin(), long_lengths.end(), first, by_index);
+    auto upper = std::lower_bound(lower, long_lengths.end(), last, by_index);
+    for (auto it = upper; it != long_lengths.end(); ++it) {
+        it->first = static_cast<uint32_t>(it->first - last + tail);
+    }
+    auto it = long_lengths.erase(lower, upper);
+    for (auto [idx, length] : patch.long_lengths) {
+        it = long_lengths.emplace(it, static_cast<uint32_t>(first + idx), length) + 1;
+    }
+
+    auto line_from = std::upper_bound(line_starts.begin(), line_starts.end(), from);
+    auto line_to = std::upper_bound(line_from, line_starts.end(), to);
+    for (auto line = line_to; line != line_starts.end(); ++line) *line += shift;
+    replace_range<uint32_t>(line_starts, line_from - line_starts.begin(),
+                            line_to - line_starts.begin(),
+                            std::span(patch.line_starts).subspan(1));
+
+    source = patch.source;
+    if (dead_literals > (integers.size() + floats.size()) / 2) {
+        compact_literals();
+    }
+}
+
+void TokenBuffer::compact_literals() {
+    std::vector<u128> live_integers;
+    std::vector<double> live_floats;
+    for (size_t idx = 0; idx < size(); idx++) {
+        if (has_integer(kinds[idx])) {
+            live_integers.push_back(integers[values[idx]]);
+            values[idx] = static_cast<uint32_t>(live_integers.size() - 1);
+        } else if (kinds[idx] == TokenType::ValueFloatingPointNumber) {
+            live_floats.push_back(floats[values[idx]]);
+            values[idx] = static_cast<uint32_t>(live_floats.size() - 1);
+        }
+    }
+    integers = std::move(live_integers);
+    floats = std::move(live_floats);
+    dead_literals = 0;
+}
+
+uint32_t TokenBuffer::length(size_t idx) const {
+    if (lengths[idx] != long_length) [[likely]] {
+        return lengths[idx];
+    }
+    auto it = std::lower_bound(
+        long_lengths.begin(), long_lengths.end(), static_cast<uint32_t>(idx),
+        [](const std::pair<uint32_t, uint32_t> &entry, uint32_t idx) { return entry.first < idx; });
+    return it->second;
+}
+
+uint32_t TokenBuffer::line_at(uint32_t offset) const {
+    return std::upper_bound(line_starts.begin(), line_starts.end(), offset) - line_starts.begin();
+}
+
+uint32_t TokenBuffer::column_at(uint32_t offset) const {
+    uint32_t start = line_starts[line_at(offset) - 1];
+    uint32_t column = offset - start + 1;
+    if (ascii) return column;
+    return column - Unicode::continuation_bytes(source.data() + start, source.data() + offset);
+}
+
+uint32_t TokenBuffer::line(size_t idx) const { return line_at(offsets[idx]); }
+
+uint32_t TokenBuffer::column(size_t idx) const {
+    return column_at(offsets[idx]) - delimiter_width(kinds[idx]);
+}
+
+Token TokenBuffer::token(size_t idx) const {
+    return Token{.type = kinds[idx],
+                 .value = values[idx],
+                 .str = str(idx),
+                 .line = line(idx),
+                 .column = column(idx)};
+}
+
+std::vector<Token> TokenBuffer::to_tokens() const {
+    std::vector<Token> out;
+    out.reserve(size());
+
+    // Tokens are in source order, so walk the line table alongside them, counting
+    // continuation bytes incrementally within each line
+    uint32_t line_no = 1;
+    uint32_t counted = 0;
+    uint32_t skew = 0;
+    for (size_t idx = 0; idx < size(); idx++) {
+        if (line_no < line_starts.size() && line_starts[line_no] <= offsets[idx]) {
+            while (line_no < line_starts.size() && line_starts[line_no] <= offsets[idx]) line_no++;
+            counted = line_starts[line_no - 1];
+            skew = 0;
+        }
+        if (!ascii) {
+            const char *data = source.data();
+            skew += Unicode::continuation_bytes(data + counted, data + offsets[idx]);
+            counted = offsets[idx];
+        }
+        out.push_back(Token{.type = kinds[idx],
+                            .value = values[idx],
+                            .str = str(idx),
+                            .line = line_no,
+                            .column = offsets[idx] - line_starts[line_no - 1] + 1 - skew -
+                                      delimiter_width(kinds[idx])});
+    }
+    return out;
+}
+
+size_t TokenBuffer::memory_usage() const {
+    return kinds.capacity() * sizeof(TokenType) + offsets.capacity() * sizeof(uint32_t) +
+           lengths.capacity() * sizeof(uint16_t) + values.capacity() * sizeof(uint32_t) +
+           integers.capacity() * sizeof(u128) + floats.capacity() * sizeof(double) +
+           long_lengths.capacity() * sizeof(std::pair<uint32_t, uint32_t>) +
+           line_starts.capacity() * sizeof(uint32_t);
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "dove/token_cache.h"
+#include "dove/utils/hash.h"
+#include "dove/utils/unicode.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Dove;
+
+namespace {
+
+constexpr char magic[8] = {'D', 'O', 'V', 'E', 'T', 'O', 'K', '\0'};
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+/**
+ * Entry layout
+ *
+ * A fixed header with the counts, then one section per column in this order, each starting
+ * on a 16-byte boundary: integers, floats, offsets, values, line starts, long lengths, name
+ * offsets, lengths, kinds, name bytes. Section offsets are derived from the counts, so the
+ * writer and the reader cannot disagree about them. The sections are indexed by each other
+ * (values into the literal tables, name offsets into the name bytes), so the header also
+ * holds the XXH64 of everything after it and a body that doesn't match it is a miss.
+ */
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t source_hash;
+    uint64_t source_size;
+    uint64_t body_hash;
+    uint32_t tokens;
+    uint32_t long_lengths;
+    uint32_t lines;
+    uint32_t integers;
+    uint32_t floats;
+    uint32_t symbols;
+    uint32_t name_bytes;
+    uint32_t ascii;
+};
+static_assert(sizeof(Header) == 72);
+
+struct Layout {
+    size_t integers, floats, offsets, values, line_starts, long_lengths, name_offsets, lengths,
+        kinds, names, size;
+};
+
+Layout layout_of(const Header &header) {
+    Layout layout;
+    size_t at = sizeof(Header);
+    auto section = [&](size_t count, size_t element) {
+        size_t start = (at + 15) / 16 * 16;
+        at = start + count * element;
+        return start;
+    };
+    layout.integers = section(header.integers, sizeof(u128));
+    layout.floats = section(header.floats, sizeof(double));
+    layout.offsets = section(header.tokens, sizeof(uint32_t));
+    layout.values = section(header.tokens, sizeof(uint32_t));
+    layout.line_starts = section(header.lines, sizeof(uint32_t));
+    layout.long_lengths = section(header.long_lengths, sizeof(std::pair<uint32_t, uint32_t>));
+    layout.name_offsets = section(header.symbols + 1, sizeof(uint32_t));
+    layout.lengths = section(header.tokens, sizeof(uint16_t));
+    layout.kinds = section(header.tokens, sizeof(TokenType));
+    layout.names = section(header.name_bytes, 1);
+    layout.size = at;
+    return layout;
+}
+
+// XXH64 of the sections, from the end of the header to the end of the entry
+uint64_t body_hash(const char *base, const Layout &layout) {
+    return Hash::xxh64(std::string_view(base + sizeof(Header), layout.size - sizeof(Header)));
+}
+
+template <typename T> std::span<const T> view(const char *base, size_t offset, size_t count) {
+    return std::span<const T>(reinterpret_cast<const T *>(base + offset), count);
+}
+
+template <typename T> void put(std::vector<char> &out, size_t offset, const T *data, size_t count) {
+    if (count) std::memcpy(out.data() + offset, data, count * sizeof(T));
+}
+
+bool write_all(int fd, const char *data, size_t size) {
+    while (size) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+CachedTokens::~CachedTokens() {
+    if (mapping) munmap(mapping, mapping_size);
+}
+
+CachedTokens::CachedTokens(CachedTokens &&other) noexcept { *this = std::move(other); }
+
+CachedTokens &CachedTokens::operator=(CachedTokens &&other) noexcept {
+    if (this != &other) {
+        if (mapping) munmap(mapping, mapping_size);
+        source = other.source;
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        kinds = other.kinds;
+        offsets = other.offsets;
+        lengths = other.lengths;
+        long_lengths = other.long_lengths;
+        values = other.values;
+        integers = other.integers;
+        floats = other.floats;
+        line_starts = other.line_starts;
+        name_offsets = other.name_offsets;
+        names = other.names;
+        ascii = other.ascii;
+    }
+    return *this;
+}
+
+uint32_t CachedTokens::length(size_t idx) const {
+    if (lengths[idx] != UINT16_MAX) [[likely]] {
+        return lengths[idx];
+    }
+    auto it = std::lower_bound(
+        long_lengths.begin(), long_lengths.end(), static_cast<uint32_t>(idx),
+        [](const std::pair<uint32_t, uint32_t> &entry, uint32_t idx) { return entry.first < idx; });
+    return it->second;
+}
+
+uint32_t CachedTokens::line_at(uint32_t offset) const {
+    return std::upper_bound(line_starts.begin(), line_starts.end(), offset) - line_starts.begin();
+}
+
+uint32_t CachedTokens::column_at(uint32_t offset) const {
+    uint32_t start = line_starts[line_at(offset) - 1];
+    uint32_t column = offset - start + 1;
+    if (ascii) return column;
+    return column - Unicode::continuation_bytes(source.data() + start, source.data() + offset);
+}
+
+uint32_t CachedTokens::line(size_t idx) const { return line_at(offsets[idx]); }
+
+uint32_t CachedTokens::column(size_t idx) const {
+    return column_at(offsets[idx]) - TokenBuffer::delimiter_width(kinds[idx]);
+}
+
+Token CachedTokens::token(size_t idx) const {
+    return Token{.type = kinds[idx],
+                 .value = values[idx],
+                 .str = str(idx),
+                 .line = line(idx),
+                 .column = column(idx)};
+}
+
+TokenCache::TokenCache(std::string directory) : directory(std::move(directory)) {}
+
+uint64_t TokenCache::key(std::string_view source) { return Hash::xxh64(source); }
+
+std::string TokenCache::path(uint64_t key) const {
+    return std::format("{}/{:016x}.dvt", directory, key);
+}
+
+std::optional<CachedTokens> TokenCache::load(std::string_view source) const {
+    uint64_t hash = key(source);
+    int fd = open(path(hash).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        return std::nullopt;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return std::nullopt;
+
+    CachedTokens entry;
+    entry.mapping = mapping;
+    entry.mapping_size = size;
+
+    const char *base = static_cast<const char *>(mapping);
+    const Header &header = *reinterpret_cast<const Header *>(base);
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+        header.byte_order != byte_order_mark || header.source_hash != hash ||
+        header.source_size != source.length()) {
+        return std::nullopt;
+    }
+    Layout layout = layout_of(header);
+    if (layout.size > size || body_hash(base, layout) != header.body_hash) return std::nullopt;
+
+    entry.source = source;
+    entry.kinds = view<TokenType>(base, layout.kinds, header.tokens);
+    entry.offsets = view<uint32_t>(base, layout.offsets, header.tokens);
+    entry.lengths = view<uint16_t>(base, layout.lengths, header.tokens);
+    entry.long_lengths =
+        view<std::pair<uint32_t, uint32_t>>(base, layout.long_lengths, header.long_lengths);
+    entry.values = view<uint32_t>(base, layout.values, header.tokens);
+    entry.integers = view<u128>(base, layout.integers, header.integers);
+    entry.floats = view<double>(base, layout.floats, header.floats);
+    entry.line_starts = view<uint32_t>(base, layout.line_starts, header.lines);
+    entry.name_offsets = view<uint32_t>(base, layout.name_offsets, header.symbols + 1);
+    entry.names = base + layout.names;
+    entry.ascii = header.ascii != 0;
+    return entry;
+}
+
+bool TokenCache::store(std::string_view source, const TokenBuffer &tokens,
+                       const Interner &interner) const {
+    std::vector<uint32_t> name_offsets{0};
+    name_offsets.reserve(interner.size() + 1);
+    for (SymbolId id = 0; id < interner.size(); id++) {
+        name_offsets.push_back(name_offsets.back() + interner.name(id).length());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byte_order = byte_order_mark;
+    header.source_hash = key(source);
+    header.source_size = source.length();
+    header.tokens = static_cast<uint32_t>(tokens.size());
+    header.long_lengths = static_cast<uint32_t>(tokens.long_lengths.size());
+    header.lines = static_cast<uint32_t>(tokens.line_starts.size());
+    header.integers = static_cast<uint32_t>(tokens.integers.size());
+    header.floats = static_cast<uint32_t>(tokens.floats.size());
+    header.symbols = static_cast<uint32_t>(interner.size());
+    header.name_bytes = name_offsets.back();
+    header.ascii = tokens.ascii;
+
+    Layout layout = layout_of(header);
+    std::vector<char> out(layout.size);
+    put(out, layout.integers, tokens.integers.data(), tokens.integers.size());
+    put(out, layout.floats, tokens.floats.data(), tokens.floats.size());
+    put(out, layout.offsets, tokens.offsets.data(), tokens.size());
+    put(out, layout.values, tokens.values.data(), tokens.size());
+    put(out, layout.line_starts, tokens.line_starts.data(), tokens.line_starts.size());
+    put(out, layout.long_lengths, tokens.long_lengths.data(), tokens.long_lengths.size());
+    put(out, layout.name_offsets, name_offsets.data(), name_offsets.size());
+    put(out, layout.lengths, tokens.lengths.data(), tokens.size());
+    put(out, layout.kinds, tokens.kinds.data(), tokens.size());
+    for (SymbolId id = 0; id < interner.size(); id++) {
+        std::string_view name = interner.name(id);
+        put(out, layout.names + name_offsets[id], name.data(), name.length());
+    }
+    header.body_hash = body_hash(out.data(), layout);
+    put(out, 0, &header, 1);
+
+    // Write to a name no other writer uses, then publish with an atomic rename
+    static std::atomic<uint32_t> counter{0};
+    std::string target = path(header.source_hash);
+    std::string temporary = std::format("{}.{}.{}.tmp", target, getpid(), counter++);
+
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) return false;
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool written = write_all(fd, out.data(), out.size());
+    written = close(fd) == 0 && written;
+    if (!written || rename(temporary.c_str(), target.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "dove/token_pipeline.h"
+#include "dove/utils/unicode.h"
+
+using namespace Dove;
+
+TokenPipeline::TokenPipeline(std::string_view source, size_t blocks)
+    : lexer(source, Lexer::Deferred{}), ring(blocks ? blocks : default_blocks),
+      worker([this] { produce(); }) {}
+
+TokenPipeline::~TokenPipeline() {
+    ring.close();
+    worker.join();
+}
+
+void TokenPipeline::produce() {
+    // Validating the source is part of lexing, so it happens on this thread too
+    if (!lexer.validate(0, static_cast<uint32_t>(lexer.source.length()))) {
+        error = lexer.diagnostics[0].to_error();
+        ring.close();
+        return;
+    }
+
+    // claim() waits while the consumer is a full ring behind, and gives up once it closed
+    // the ring early
+    while (TokenBlock *block = ring.claim()) {
+        bool more = fill(*block);
+        if (block->count) ring.publish();
+        if (!more) break;
+    }
+    ring.close();
+}
+
+bool TokenPipeline::fill(TokenBlock &block) {
+    // The lexer's buffer only ever holds one block; its line table then starts with a
+    // placeholder, followed by the lines begun since the last block
+    TokenBuffer &tokens = lexer.tokens;
+    tokens.clear();
+    while (tokens.size() < TokenBlock::capacity && !lexer.finished &&
+           lexer.cursor < lexer.source.length()) {
+        lexer.lex_next();
+    }
+
+    const std::vector<uint32_t> &starts = tokens.get_line_starts();
+    const char *data = lexer.source.data();
+    size_t next_line = 1;
+    auto enter_line = [&] {
+        line++;
+        line_begin = counted = starts[next_line++];
+        skew = 0;
+    };
+
+    block.count = block.integer_count = block.float_count = 0;
+    for (size_t idx = 0; idx < tokens.size(); idx++) {
+        uint32_t offset = tokens.offset(idx);
+        while (next_line < starts.size() && starts[next_line] <= offset) enter_line();
+        if (!lexer.ascii) {
+            skew += Unicode::continuation_bytes(data + counted, data + offset);
+            counted = offset;
+        }
+
+        TokenType type = tokens.kind(idx);
+        if (type == TokenType::Error) {
+            error = lexer.diagnostics[tokens.value(idx)].to_error();
+            return false;
+        }
+        Token token{.type = type,
+                    .value = tokens.value(idx),
+                    .str = tokens.str(idx),
+                    .line = line,
+                    .column = offset - line_begin + 1 - skew - TokenBuffer::delimiter_width(type)};
+        if (TokenBuffer::has_symbol(type)) {
+            block.names[block.count] = lexer.interner.name(token.value);
+        } else if (TokenBuffer::has_integer(type)) {
+            block.integers[block.integer_count] = tokens.integer(idx);
+            token.value = block.integer_count++;
+        } else if (type == TokenType::ValueFloatingPointNumber) {
+            block.floats[block.float_count] = tokens.floating(idx);
+            token.value = block.float_count++;
+        }
+        block.tokens[block.count++] = token;
+    }
+    while (next_line < starts.size()) enter_line();
+
+    return !lexer.finished && lexer.cursor < lexer.source.length();
+}
+
+const TokenBlock *TokenPipeline::next_block() {
+    if (holding) ring.pop();
+    const TokenBlock *block = ring.front();
+    holding = block != nullptr;
+    return block;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "dove/token_stream.h"
+#include "dove/utils/unicode.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+using namespace Dove;
+
+TokenStream::TokenStream(std::string_view source)
+    : lexer(source, Lexer::Deferred{}), chunk_size(0), validated(source.length()) {
+    const char *end = source.data() + source.length();
+    const char *invalid = Unicode::validate(source.data(), end, &lexer.ascii);
+    if (invalid != end) {
+        error = lexer.invalid_utf8(static_cast<uint32_t>(invalid - source.data())).to_error();
+    }
+}
+
+TokenStream::TokenStream(ChunkReader reader, size_t chunk_size)
+    : lexer({}, Lexer::Deferred{}), reader(std::move(reader)),
+      chunk_size(chunk_size ? chunk_size : default_chunk_size), validated(0) {
+    lexer.end_of_input = false;
+    window.resize(this->chunk_size + 1);
+}
+
+TokenStream::TokenStream(std::string_view source, CachedTokens tokens)
+    : lexer(source, Lexer::Deferred{}), chunk_size(0), validated(source.length()),
+      cached(std::move(tokens)) {
+    // Same names, same ids
+    for (SymbolId id = 0; id < cached->symbol_count(); id++) {
+        lexer.interner.intern(cached->name(id));
+    }
+}
+
+ChunkReader TokenStream::from_fd(int fd) {
+    return [fd](char *buffer, size_t capacity) -> size_t {
+        while (true) {
+            ssize_t n = ::read(fd, buffer, capacity);
+            if (n >= 0) return static_cast<size_t>(n);
+            if (errno != EINTR) return 0;
+        }
+    };
+}
+
+std::expected<std::optional<Token>, CompilerError> TokenStream::next_token() {
+    if (cached) {
+        if (replayed == cached->size()) return std::nullopt;
+        return cached->token(replayed++);
+    }
+
+    while (!lexer.finished) {
+        // Also set by refill() on invalid UTF-8
+        if (error) return std::unexpected<CompilerError>(error.value());
+
+        if (lexer.cursor >= lexer.source.length()) {
+            if (lexer.end_of_input) break;
+            refill();
+            continue;
+        }
+
+        uint32_t cursor = lexer.cursor;
+        uint32_t line = lexer.line;
+        uint32_t line_start = lexer.line_start;
+        uint32_t line_skew = lexer.line_skew;
+        Lexer::Mode mode = lexer.mode;
+        size_t symbols = lexer.interner.size();
+        size_t reported = lexer.diagnostics.size();
+
+        lexer.tokens.clear();
+        lexer.lex_next();
+
+        // A token (or error) this close to the end of the window may still change
+        bool settled =
+            lexer.end_of_input || lexer.cursor + Lexer::lookahead <= lexer.source.length();
+        if (!settled && !lexer.tokens.empty()) {
+            lexer.cursor = cursor;
+            lexer.line = line;
+            lexer.line_start = line_start;
+            lexer.line_skew = line_skew;
+            lexer.mode = mode;
+            lexer.interner.truncate(symbols);
+            lexer.diagnostics.truncate(reported);
+            refill();
+            continue;
+        }
+
+        if (!lexer.tokens.empty()) {
+            // Unlike the lexer, a stream stops at the first error
+            if (lexer.tokens.kind(0) == TokenType::Error) {
+                error = lexer.diagnostics[lexer.tokens.value(0)].to_error();
+                return std::unexpected<CompilerError>(error.value());
+            }
+
+            const TokenBuffer &tokens = lexer.tokens;
+            // Tokens never span lines, so the lexer is still on the token's line
+            return Token{.type = tokens.kind(0),
+                         .value = tokens.value(0),
+                         .str = tokens.str(0),
+                         .line = lexer.line,
+                         .column = lexer.column_at(tokens.offset(0)) -
+                                   TokenBuffer::delimiter_width(tokens.kind(0))};
+        }
+
+        // No progress: a comment is waiting for the bytes after the window
+        if (lexer.cursor == cursor && !lexer.end_of_input) {
+            refill();
+        }
+    }
+    return std::nullopt;
+}
+
+void TokenStream::refill() {
+    if (!reader) {
+        lexer.end_of_input = true;
+        return;
+    }
+
+    // Keep only what the lexer has not consumed yet, and the bytes not validated yet (the
+    // start of a UTF-8 sequence cut off by the end of the window)
+    size_t consumed = lexer.cursor < validated ? lexer.cursor : validated;
+    size_t live = lexer.source.length() - consumed;
+
+    // Offsets are window-relative and line_start may end up before the window; unsigned
+    // wrap-around keeps byte differences exact, and line_skew keeps the code point count
+    uint32_t from = lexer.line_start <= consumed ? lexer.line_start : 0;
+    lexer.line_skew += Unicode::continuation_bytes(lexer.source.data() + from,
+                                                   lexer.source.data() + consumed);
+    if (live) {
+        std::memmove(window.data(), window.data() + consumed, live);
+    }
+    lexer.cursor -= static_cast<uint32_t>(consumed);
+    lexer.line_start -= static_cast<uint32_t>(consumed);
+    validated -= consumed;
+
+    // A single token larger than the window grows it
+    if (window.size() - 1 - live < chunk_size) {
+        window.resize(live + chunk_size + 1);
+    }
+
+    size_t n = reader(window.data() + live, chunk_size);
+    if (n == 0) {
+        lexer.end_of_input = true;
+    }
+    window[live + n] = '\0';
+
+    lexer.source = std::string_view(window.data(), live + n);
+    lexer.tokens.reset(lexer.source);
+
+    // Validate the new bytes; a sequence cut off by the end waits for the next chunk
+    const char *end = window.data() + live + n;
+    const char *invalid = Unicode::validate(window.data() + validated, end, &lexer.ascii);
+    if (invalid != end && (lexer.end_of_input || !Unicode::truncated(invalid, end))) {
+        error = lexer.invalid_utf8(static_cast<uint32_t>(invalid - window.data())).to_error();
+    }
+    validated = invalid - window.data();
+}
\ No newline at end of file
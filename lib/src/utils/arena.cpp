@@ -0,0 +1,38 @@
+#include "dove/utils/arena.h"
+
+#include <cstring>
+
+using namespace Dove;
+
+void *Arena::allocate_slow(size_t size, size_t align) {
+    // Oversized requests get a block of their own
+    size_t block = size + align > block_size ? size + align : block_size;
+    blocks.push_back(Block{std::make_unique<char[]>(block), block});
+    head = blocks.back().data.get();
+    tail = head + block;
+    return allocate(size, align);
+}
+
+std::string_view Arena::copy(std::string_view str) {
+    if (str.empty()) return {};
+    char *out = static_cast<char *>(allocate(str.length(), 1));
+    std::memcpy(out, str.data(), str.length());
+    return std::string_view(out, str.length());
+}
+
+void Arena::reset() {
+    if (blocks.size() > 1) {
+        size_t total = bytes_reserved();
+        blocks.clear();
+        blocks.push_back(Block{std::make_unique<char[]>(total), total});
+    }
+    head = blocks.empty() ? nullptr : blocks.front().data.get();
+    tail = blocks.empty() ? nullptr : head + blocks.front().size;
+    used = 0;
+}
+
+size_t Arena::bytes_reserved() const {
+    size_t total = 0;
+    for (const auto &block : blocks) total += block.size;
+    return total;
+}
\ No newline at end of file
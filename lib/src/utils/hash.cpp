@@ -0,0 +1,81 @@
+#include "dove/utils/hash.h"
+
+#include <bit>
+#include <cstring>
+
+using namespace Dove;
+
+namespace {
+
+constexpr uint64_t prime1 = 0x9E3779B185EBCA87;
+constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4F;
+constexpr uint64_t prime3 = 0x165667B19E3779F9;
+constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63;
+constexpr uint64_t prime5 = 0x27D4EB2F165667C5;
+
+// Little-endian loads, so the hash is the same on every host
+uint64_t load64(const char *it) {
+    uint64_t word;
+    std::memcpy(&word, it, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+    return word;
+}
+
+uint32_t load32(const char *it) {
+    uint32_t word;
+    std::memcpy(&word, it, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+    return word;
+}
+
+uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * prime2;
+    return std::rotl(acc, 31) * prime1;
+}
+
+uint64_t merge_round(uint64_t acc, uint64_t lane) {
+    acc ^= round(0, lane);
+    return acc * prime1 + prime4;
+}
+
+} // namespace
+
+uint64_t Hash::xxh64(std::string_view data, uint64_t seed) {
+    const char *it = data.data();
+    const char *end = it + data.length();
+    uint64_t hash;
+
+    if (data.length() >= 32) {
+        uint64_t lanes[4] = {seed + prime1 + prime2, seed + prime2, seed, seed - prime1};
+        for (; end - it >= 32; it += 32) {
+            for (int i = 0; i < 4; i++) lanes[i] = round(lanes[i], load64(it + 8 * i));
+        }
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) +
+               std::rotl(lanes[3], 18);
+        for (uint64_t lane : lanes) hash = merge_round(hash, lane);
+    } else {
+        hash = seed + prime5;
+    }
+    hash += data.length();
+
+    for (; end - it >= 8; it += 8) {
+        hash ^= round(0, load64(it));
+        hash = std::rotl(hash, 27) * prime1 + prime4;
+    }
+    if (end - it >= 4) {
+        hash ^= load32(it) * prime1;
+        hash = std::rotl(hash, 23) * prime2 + prime3;
+        it += 4;
+    }
+    for (; it < end; it++) {
+        hash ^= static_cast<uint8_t>(*it) * prime5;
+        hash = std::rotl(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
\ No newline at end of file
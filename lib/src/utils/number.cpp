@@ -0,0 +1,105 @@
+#include "dove/utils/number.h"
+
+#include <bit>
+#include <charconv>
+#include <cstring>
+
+using namespace Dove;
+
+namespace {
+
+constexpr u128 u128_max = ~u128{0};
+
+// Digit i of a literal in byte i, whatever the host byte order
+uint64_t load_digits(const char *it) {
+    uint64_t word;
+    std::memcpy(&word, it, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+    return word;
+}
+
+// SWAR: 8 hex digits to a 32-bit value. Each step merges adjacent lanes, so three
+// multiply-add rounds replace eight dependent shift-or steps.
+uint32_t hex8(uint64_t word) {
+    // '0'-'9' keep their low nibble; 'A'-'F' and 'a'-'f' have bit 6 set and need +9
+    word = (word & 0x0F0F0F0F0F0F0F0F) + 9 * ((word >> 6) & 0x0101010101010101);
+    word = (word * 16 + (word >> 8)) & 0x00FF00FF00FF00FF;
+    word = (word * 256 + (word >> 16)) & 0x0000FFFF0000FFFF;
+    return static_cast<uint32_t>(word * 65536 + (word >> 32));
+}
+
+// SWAR: 8 binary digits to a byte. The multiplier sums digit i into bit 7 - i of the top
+// byte; no partial sum reaches the next byte, so there are no carries.
+uint8_t binary8(uint64_t word) {
+    return static_cast<uint8_t>(((word - 0x3030303030303030) * 0x8040201008040201) >> 56);
+}
+
+uint32_t digit_value(uint8_t ch) { return ch <= '9' ? ch - '0' : (ch | 0x20) - 'a' + 10; }
+
+std::string_view skip_leading_zeros(std::string_view digits) {
+    size_t idx = digits.find_first_not_of('0');
+    return idx == std::string_view::npos ? std::string_view{} : digits.substr(idx);
+}
+
+// Shared shape of the power-of-two radixes: scalar head, then whole 8-digit groups
+template <uint32_t bits, typename Group>
+bool power_of_two(std::string_view digits, u128 *out, Group group) {
+    digits = skip_leading_zeros(digits);
+    if (digits.length() > 128 / bits) return false;
+
+    u128 value = 0;
+    size_t head = digits.length() % 8;
+    for (size_t i = 0; i < head; i++) value = value << bits | digit_value(digits[i]);
+    for (size_t i = head; i < digits.length(); i += 8) {
+        value = value << (8 * bits) | group(load_digits(digits.data() + i));
+    }
+    *out = value;
+    return true;
+}
+
+} // namespace
+
+bool Number::decode_decimal(std::string_view digits, u128 *out) {
+    digits = skip_leading_zeros(digits);
+
+    // 19 digits always fit in 64 bits, so the accumulation is a few wide steps
+    u128 value = 0;
+    for (size_t i = 0; i < digits.length(); i += 19) {
+        size_t len = digits.length() - i < 19 ? digits.length() - i : 19;
+        uint64_t chunk = 0;
+        std::from_chars(digits.data() + i, digits.data() + i + len, chunk);
+
+        u128 scale = 1;
+        for (size_t k = 0; k < len; k++) scale *= 10;
+        if (value > (u128_max - chunk) / scale) return false;
+        value = value * scale + chunk;
+    }
+    *out = value;
+    return true;
+}
+
+bool Number::decode_hexadecimal(std::string_view digits, u128 *out) {
+    return power_of_two<4>(digits, out, hex8);
+}
+
+bool Number::decode_binary(std::string_view digits, u128 *out) {
+    return power_of_two<1>(digits, out, binary8);
+}
+
+bool Number::decode_octal(std::string_view digits, u128 *out) {
+    // 3 bits per digit do not divide 128, so check the top bits before every shift
+    digits = skip_leading_zeros(digits);
+    u128 value = 0;
+    for (char ch : digits) {
+        if (value >> 125) return false;
+        value = value << 3 | static_cast<uint32_t>(ch - '0');
+    }
+    *out = value;
+    return true;
+}
+
+bool Number::decode_floating(std::string_view str, double *out) {
+    auto res = std::from_chars(str.data(), str.data() + str.length(), *out,
+                               std::chars_format::fixed);
+    return res.ec == std::errc{};
+}
\ No newline at end of file
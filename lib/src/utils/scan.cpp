@@ -0,0 +1,291 @@
+#include "dove/utils/scan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DOVE_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace Dove;
+
+namespace {
+
+// Scalar
+
+inline bool is_whitespace(uint8_t ch) { return ch == ' ' || ch == '\t' || ch == '\r'; }
+
+inline bool is_digit(uint8_t ch) { return static_cast<uint8_t>(ch - '0') < 10u; }
+
+inline bool is_identifier(uint8_t ch) {
+    return static_cast<uint8_t>((ch | 0x20) - 'a') < 26u || is_digit(ch) || ch == '_';
+}
+
+const char *whitespace_scalar(const char *it, const char *end) {
+    while (it < end && is_whitespace(static_cast<uint8_t>(*it))) it++;
+    return it;
+}
+
+const char *identifier_scalar(const char *it, const char *end) {
+    while (it < end && is_identifier(static_cast<uint8_t>(*it))) it++;
+    return it;
+}
+
+const char *digits_scalar(const char *it, const char *end) {
+    while (it < end && is_digit(static_cast<uint8_t>(*it))) it++;
+    return it;
+}
+
+const char *quoted_scalar(const char *it, const char *end, char quote) {
+    while (it < end && *it != quote && *it != '\\' && *it != '\n' && *it != '\0') it++;
+    return it;
+}
+
+#ifdef DOVE_SCAN_X86
+
+// SSE4.2
+//
+// PCMPISTRI with negative polarity returns the index of the first byte that is *not* in
+// the set/ranges. A NUL byte terminates the implicit-length string, which is also a byte
+// outside of every run, so the result is still correct.
+
+constexpr int sse_any = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY |
+                        _SIDD_LEAST_SIGNIFICANT;
+constexpr int sse_ranges = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY |
+                           _SIDD_LEAST_SIGNIFICANT;
+
+__attribute__((target("sse4.2"))) const char *whitespace_sse42(const char *it, const char *end) {
+    const __m128i set = _mm_setr_epi8(' ', '\t', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        int idx = _mm_cmpistri(set, data, sse_any);
+        if (idx != 16) return it + idx;
+        it += 16;
+    }
+    return whitespace_scalar(it, end);
+}
+
+__attribute__((target("sse4.2"))) const char *identifier_sse42(const char *it, const char *end) {
+    const __m128i ranges =
+        _mm_setr_epi8('a', 'z', 'A', 'Z', '0', '9', '_', '_', 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        int idx = _mm_cmpistri(ranges, data, sse_ranges);
+        if (idx != 16) return it + idx;
+        it += 16;
+    }
+    return identifier_scalar(it, end);
+}
+
+__attribute__((target("sse4.2"))) const char *digits_sse42(const char *it, const char *end) {
+    const __m128i ranges = _mm_setr_epi8('0', '9', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        int idx = _mm_cmpistri(ranges, data, sse_ranges);
+        if (idx != 16) return it + idx;
+        it += 16;
+    }
+    return digits_scalar(it, end);
+}
+
+// NUL is one of the stop bytes here, so PCMPISTRI's implicit length does not fit; plain
+// compares against the four stop bytes do.
+__attribute__((target("sse4.2"))) const char *quoted_sse42(const char *it, const char *end,
+                                                           char quote) {
+    while (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(quote)),
+                         _mm_cmpeq_epi8(data, _mm_set1_epi8('\\'))),
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n')),
+                         _mm_cmpeq_epi8(data, _mm_setzero_si128())));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (mask) return it + __builtin_ctz(mask);
+        it += 16;
+    }
+    return quoted_scalar(it, end, quote);
+}
+
+// AVX2
+//
+// Classify 32 bytes per iteration. Unsigned range checks are done as
+// `min_epu8(x - lo, hi - lo) == x - lo`. Most runs in source code are shorter than 16 bytes
+// and a 32-byte block costs more than it saves on those, so every kernel classifies one
+// 16-byte block first and only enters the 32-byte loop when the run goes on past it.
+
+__attribute__((target("avx2"))) inline __m256i in_range(__m256i data, char lo, char hi) {
+    __m256i off = _mm256_sub_epi8(data, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(off, _mm256_set1_epi8(static_cast<char>(hi - lo))),
+                             off);
+}
+
+__attribute__((target("avx2"))) inline __m128i in_range(__m128i data, char lo, char hi) {
+    __m128i off = _mm_sub_epi8(data, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(off, _mm_set1_epi8(static_cast<char>(hi - lo))), off);
+}
+
+__attribute__((target("avx2"))) const char *whitespace_avx2(const char *it, const char *end) {
+    if (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(' ')),
+                                                _mm_cmpeq_epi8(data, _mm_set1_epi8('\t'))),
+                                   _mm_cmpeq_epi8(data, _mm_set1_epi8('\r')));
+        uint32_t miss = ~static_cast<uint32_t>(_mm_movemask_epi8(hit)) & 0xFFFF;
+        if (miss) return it + __builtin_ctz(miss);
+        it += 16;
+    }
+    while (end - it >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(' ')),
+                            _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\t'))),
+            _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\r')));
+        uint32_t miss = ~static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if (miss) return it + __builtin_ctz(miss);
+        it += 32;
+    }
+    return whitespace_scalar(it, end);
+}
+
+__attribute__((target("avx2"))) const char *identifier_avx2(const char *it, const char *end) {
+    if (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i lower = _mm_or_si128(data, _mm_set1_epi8(0x20));
+        __m128i hit =
+            _mm_or_si128(_mm_or_si128(in_range(lower, 'a', 'z'), in_range(data, '0', '9')),
+                         _mm_cmpeq_epi8(data, _mm_set1_epi8('_')));
+        uint32_t miss = ~static_cast<uint32_t>(_mm_movemask_epi8(hit)) & 0xFFFF;
+        if (miss) return it + __builtin_ctz(miss);
+        it += 16;
+    }
+    while (end - it >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        __m256i lower = _mm256_or_si256(data, _mm256_set1_epi8(0x20));
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(in_range(lower, 'a', 'z'), in_range(data, '0', '9')),
+            _mm256_cmpeq_epi8(data, _mm256_set1_epi8('_')));
+        uint32_t miss = ~static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if (miss) return it + __builtin_ctz(miss);
+        it += 32;
+    }
+    return identifier_scalar(it, end);
+}
+
+__attribute__((target("avx2"))) const char *digits_avx2(const char *it, const char *end) {
+    if (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i hit = in_range(data, '0', '9');
+        uint32_t miss = ~static_cast<uint32_t>(_mm_movemask_epi8(hit)) & 0xFFFF;
+        if (miss) return it + __builtin_ctz(miss);
+        it += 16;
+    }
+    while (end - it >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        uint32_t miss = ~static_cast<uint32_t>(_mm256_movemask_epi8(in_range(data, '0', '9')));
+        if (miss) return it + __builtin_ctz(miss);
+        it += 32;
+    }
+    return digits_scalar(it, end);
+}
+
+__attribute__((target("avx2"))) const char *quoted_avx2(const char *it, const char *end,
+                                                        char quote) {
+    if (end - it >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(quote)),
+                         _mm_cmpeq_epi8(data, _mm_set1_epi8('\\'))),
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n')),
+                         _mm_cmpeq_epi8(data, _mm_setzero_si128())));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (mask) return it + __builtin_ctz(mask);
+        it += 16;
+    }
+    while (end - it >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(quote)),
+                            _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n')),
+                            _mm256_cmpeq_epi8(data, _mm256_setzero_si256())));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if (mask) return it + __builtin_ctz(mask);
+        it += 32;
+    }
+    return quoted_scalar(it, end, quote);
+}
+
+#endif
+
+// Dispatch
+
+struct Kernels {
+    Scan::Isa isa;
+    const char *(*whitespace)(const char *, const char *);
+    const char *(*identifier)(const char *, const char *);
+    const char *(*digits)(const char *, const char *);
+    const char *(*quoted)(const char *, const char *, char);
+};
+
+constexpr Kernels kernels_scalar = {
+    Scan::Isa::Scalar, whitespace_scalar, identifier_scalar, digits_scalar, quoted_scalar};
+
+#ifdef DOVE_SCAN_X86
+constexpr Kernels kernels_sse42 = {
+    Scan::Isa::SSE42, whitespace_sse42, identifier_sse42, digits_sse42, quoted_sse42};
+constexpr Kernels kernels_avx2 = {
+    Scan::Isa::AVX2, whitespace_avx2, identifier_avx2, digits_avx2, quoted_avx2};
+#endif
+
+bool supported(Scan::Isa isa) {
+    switch (isa) {
+        case Scan::Isa::Scalar: return true;
+#ifdef DOVE_SCAN_X86
+        case Scan::Isa::SSE42: return __builtin_cpu_supports("sse4.2");
+        case Scan::Isa::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+const Kernels *kernels_for(Scan::Isa isa) {
+    switch (isa) {
+#ifdef DOVE_SCAN_X86
+        case Scan::Isa::AVX2: return &kernels_avx2;
+        case Scan::Isa::SSE42: return &kernels_sse42;
+#endif
+        default: return &kernels_scalar;
+    }
+}
+
+// SSE4.2 is the default even where AVX2 is available: runs in source code are short, and
+// one PCMPISTRI per 16 bytes beats the AVX2 kernels' compare chains on them (see Scan).
+const Kernels *&active() {
+    static const Kernels *kernels = [] {
+        if (supported(Scan::Isa::SSE42)) return kernels_for(Scan::Isa::SSE42);
+        return &kernels_scalar;
+    }();
+    return kernels;
+}
+
+} // namespace
+
+const char *Scan::whitespace(const char *it, const char *end) {
+    return active()->whitespace(it, end);
+}
+
+const char *Scan::identifier(const char *it, const char *end) {
+    return active()->identifier(it, end);
+}
+
+const char *Scan::digits(const char *it, const char *end) { return active()->digits(it, end); }
+
+const char *Scan::quoted(const char *it, const char *end, char quote) {
+    return active()->quoted(it, end, quote);
+}
+
+Scan::Isa Scan::isa() { return active()->isa; }
+
+bool Scan::select(Isa isa) {
+    if (!supported(isa)) return false;
+    active() = kernels_for(isa);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "dove/utils/unicode.h"
+#include "dove/utils/scan.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DOVE_UNICODE_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace Dove;
+
+namespace {
+
+bool is_continuation(uint8_t ch) { return (ch & 0xC0) == 0x80; }
+
+const char *validate_scalar(const char *it, const char *end, bool *ascii) {
+    while (it < end) {
+        // ASCII 8 bytes at a time
+        if (end - it >= 8) {
+            uint64_t word;
+            std::memcpy(&word, it, sizeof(word));
+            if (!(word & 0x8080808080808080)) {
+                it += 8;
+                continue;
+            }
+        }
+        if (static_cast<uint8_t>(*it) < 0x80) {
+            it++;
+            continue;
+        }
+
+        if (ascii) *ascii = false;
+        uint32_t codepoint;
+        uint8_t len = Unicode::read_unicode(std::string_view(it, end - it), 0, &codepoint);
+        if (len == 0) return it;
+        it += len;
+    }
+    return end;
+}
+
+// The vector kernels only say whether a block is valid. The exact position of an error is
+// then found by the scalar validator, restarting at the first code point boundary at most 3
+// bytes before the failing block (the longest sequence a block check looks back into).
+const char *locate_error(const char *begin, const char *block, const char *end, bool *ascii) {
+    const char *it = block - begin >= 3 ? block - 3 : begin;
+    while (it < block && is_continuation(static_cast<uint8_t>(*it))) it++;
+    return validate_scalar(it, end, ascii);
+}
+
+#ifdef DOVE_UNICODE_X86
+
+// Vector validation (Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per
+// Byte"). Every error in a pair of adjacent bytes is identified by three 16-entry lookups:
+// on the high nibble of the first byte, its low nibble and the high nibble of the second
+// byte. A bit survives the AND of the three only if that error is present. 3- and 4-byte
+// sequences are then checked by comparing where continuation bytes must appear with where
+// they do.
+
+constexpr uint8_t too_short = 1 << 0;      // 11______ 0_______ or 11______ 11______
+constexpr uint8_t too_long = 1 << 1;       // 0_______ 10______
+constexpr uint8_t overlong_3 = 1 << 2;     // 11100000 100_____
+constexpr uint8_t too_large = 1 << 3;      // 11110100 1001____ and above
+constexpr uint8_t surrogate = 1 << 4;      // 11101101 101_____
+constexpr uint8_t overlong_2 = 1 << 5;     // 1100000_ 10______
+constexpr uint8_t too_large_1000 = 1 << 6; // 11110101+ 1000____
+constexpr uint8_t overlong_4 = 1 << 6;     // 11110000 1000____
+constexpr uint8_t two_conts = 1 << 7;      // 10______ 10______ (fine inside 3/4-byte sequences)
+constexpr uint8_t carry = too_short | too_long | two_conts;
+
+#define DOVE_UTF8_TABLES(set)                                                                     \
+    const auto byte_1_high = set(                                                                 \
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,          \
+        two_conts, two_conts, two_conts, two_conts, too_short | overlong_2, too_short,            \
+        too_short | overlong_3 | surrogate, too_short | too_large | too_large_1000 | overlong_4); \
+    const auto byte_1_low = set(                                                                  \
+        carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,           \
+        carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000, \
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,                   \
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,                   \
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000,                   \
+        carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000,        \
+        carry | too_large | too_large_1000);                                                      \
+    const auto byte_2_high = set(                                                                 \
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,  \
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,             \
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,                               \
+        too_long | overlong_2 | two_conts | surrogate | too_large,                                \
+        too_long | overlong_2 | two_conts | surrogate | too_large, too_short, too_short,          \
+        too_short, too_short)
+
+__attribute__((target("sse4.2"))) inline __m128i set_table_sse(uint8_t b0, uint8_t b1, uint8_t b2,
+                                                               uint8_t b3, uint8_t b4, uint8_t b5,
+                                                               uint8_t b6, uint8_t b7, uint8_t b8,
+                                                               uint8_t b9, uint8_t b10, uint8_t b11,
+                                                               uint8_t b12, uint8_t b13,
+                                                               uint8_t b14, uint8_t b15) {
+    return _mm_setr_epi8(b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15);
+}
+
+__attribute__((target("avx2"))) inline __m256i set_table_avx2(uint8_t b0, uint8_t b1, uint8_t b2,
+                                                               uint8_t b3, uint8_t b4, uint8_t b5,
+                                                               uint8_t b6, uint8_t b7, uint8_t b8,
+                                                               uint8_t b9, uint8_t b10, uint8_t b11,
+                                                               uint8_t b12, uint8_t b13,
+                                                               uint8_t b14, uint8_t b15) {
+    // PSHUFB looks up within each 128-bit lane, so both lanes hold the table
+    return _mm256_setr_epi8(b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15,
+                            b0, b1, b2, b3, b4, b5, b6, b7, b8, b9, b10, b11, b12, b13, b14, b15);
+}
+
+__attribute__((target("sse4.2"))) const char *validate_sse42(const char *it, const char *end,
+                                                             bool *ascii) {
+    DOVE_UTF8_TABLES(set_table_sse);
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    // Non-zero where a lead byte in the last 3 positions still needs continuation bytes
+    const __m128i max_complete = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                               -1, 0xEF - 0x100, 0xDF - 0x100, 0xBF - 0x100);
+
+    const char *begin = it;
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    alignas(16) char tail[16];
+
+    while (it < end) {
+        __m128i input;
+        if (end - it >= 16) {
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        } else {
+            // Zero padding is ASCII, so a sequence cut off by the end shows up as too short
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, it, end - it);
+            input = _mm_load_si128(reinterpret_cast<const __m128i *>(tail));
+        }
+
+        __m128i error = prev_incomplete;
+        if (_mm_movemask_epi8(input) == 0) {
+            prev_incomplete = _mm_setzero_si128();
+        } else {
+            if (ascii) *ascii = false;
+            __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+            __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+            __m128i special = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte_1_high,
+                                     _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)),
+                    _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, low_nibble))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)));
+
+            // Only 111_____ two back and 1111____ three back require a continuation here
+            __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+                                          _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80)));
+            __m128i must23_80 = _mm_and_si128(must23, _mm_set1_epi8(static_cast<char>(0x80)));
+            error = _mm_or_si128(error, _mm_xor_si128(must23_80, special));
+            prev_incomplete = _mm_subs_epu8(input, max_complete);
+        }
+        prev_input = input;
+
+        if (!_mm_testz_si128(error, error)) return locate_error(begin, it, end, ascii);
+        it += 16;
+    }
+    // A full last block may end inside a sequence
+    if (!_mm_testz_si128(prev_incomplete, prev_incomplete)) {
+        return locate_error(begin, end, end, ascii);
+    }
+    return end;
+}
+
+__attribute__((target("avx2"))) const char *validate_avx2(const char *it, const char *end,
+                                                          bool *ascii) {
+    DOVE_UTF8_TABLES(set_table_avx2);
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    const __m256i max_complete = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, 0xEF - 0x100, 0xDF - 0x100, 0xBF - 0x100);
+
+    const char *begin = it;
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    alignas(32) char tail[32];
+
+    while (it < end) {
+        __m256i input;
+        if (end - it >= 32) {
+            input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        } else {
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, it, end - it);
+            input = _mm256_load_si256(reinterpret_cast<const __m256i *>(tail));
+        }
+
+        __m256i error = prev_incomplete;
+        if (_mm256_movemask_epi8(input) == 0) {
+            prev_incomplete = _mm256_setzero_si256();
+        } else {
+            if (ascii) *ascii = false;
+            // Bytes 1-3 back, crossing from the previous block and between the two lanes
+            __m256i carried = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+            __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+            __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+            __m256i special = _mm256_and_si256(
+                _mm256_and_si256(
+                    _mm256_shuffle_epi8(byte_1_high,
+                                        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                    _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble))),
+                _mm256_shuffle_epi8(byte_2_high,
+                                    _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+
+            __m256i must23 =
+                _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                                _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80)));
+            __m256i must23_80 =
+                _mm256_and_si256(must23, _mm256_set1_epi8(static_cast<char>(0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special));
+            prev_incomplete = _mm256_subs_epu8(input, max_complete);
+        }
+        prev_input = input;
+
+        if (!_mm256_testz_si256(error, error)) return locate_error(begin, it, end, ascii);
+        it += 32;
+    }
+    if (!_mm256_testz_si256(prev_incomplete, prev_incomplete)) {
+        return locate_error(begin, end, end, ascii);
+    }
+    return end;
+}
+
+#undef DOVE_UTF8_TABLES
+
+#endif
+
+} // namespace
+
+const char *Unicode::validate(const char *it, const char *end, bool *ascii) {
+    switch (Scan::isa()) {
+#ifdef DOVE_UNICODE_X86
+        case Scan::Isa::AVX2: return validate_avx2(it, end, ascii);
+        case Scan::Isa::SSE42: return validate_sse42(it, end, ascii);
+#endif
+        default: return validate_scalar(it, end, ascii);
+    }
+}
+
+bool Unicode::truncated(const char *it, const char *end) {
+    if (it == end) return false;
+    uint8_t lead = static_cast<uint8_t>(*it);
+    size_t len = (lead & 0xE0) == 0xC0   ? 2
+                 : (lead & 0xF0) == 0xE0 ? 3
+                 : (lead & 0xF8) == 0xF0 ? 4
+                                         : 0;
+    if (static_cast<size_t>(end - it) >= len) return false;
+
+    // Pad with the smallest continuation bytes that keep the sequence valid, if any do
+    char padded[4];
+    std::memcpy(padded, it, end - it);
+    for (size_t i = end - it; i < len; i++) padded[i] = static_cast<char>(0x80);
+    uint32_t codepoint;
+    if (read_unicode(std::string_view(padded, len), 0, &codepoint) == len) return true;
+    // The largest ones, for leads whose smallest completion is overlong (E0, F0)
+    for (size_t i = end - it; i < len; i++) padded[i] = static_cast<char>(0xBF);
+    return read_unicode(std::string_view(padded, len), 0, &codepoint) == len;
+}
+
+uint32_t Unicode::continuation_bytes(const char *it, const char *end) {
+    uint32_t count = 0;
+    for (; it < end; it++) count += is_continuation(static_cast<uint8_t>(*it));
+    return count;
+}
\ No newline at end of file
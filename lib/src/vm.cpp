@@ -0,0 +1,518 @@
+#include "dove/vm.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <type_traits>
+
+using namespace Dove;
+
+namespace {
+
+// The types of the typed families: X(suffix, C type)
+#define DOVE_VM_INTEGER_TYPES(X)                                                               \
+    X(I8, int8_t) X(I16, int16_t) X(I32, int32_t) X(I64, int64_t) X(I128, i128) X(U8, uint8_t) \
+    X(U16, uint16_t) X(U32, uint32_t) X(U64, uint64_t) X(U128, u128)
+#define DOVE_VM_SIGNED_TYPES(X)                                                                \
+    X(I8, int8_t) X(I16, int16_t) X(I32, int32_t) X(I64, int64_t) X(I128, i128)
+#define DOVE_VM_ORDER_TYPES(X)                                                                 \
+    X(I64, int64_t) X(U64, uint64_t) X(I128, i128) X(U128, u128) X(F64, double)
+#define DOVE_VM_EQUALITY_TYPES(X) X(W64, uint64_t) X(W128, u128) X(F64, double)
+
+// `std::is_signed` knows nothing of __int128 outside of GNU modes
+template <typename T> constexpr bool is_signed = T(-1) < T(0);
+
+// The unsigned type T's arithmetic wraps around in: wide enough that nothing is promoted to
+// (signed) int on the way
+template <typename T>
+using Bits = std::conditional_t<sizeof(T) == 16, u128,
+                                std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>>;
+
+template <typename T> T get(const Value &value) {
+    if constexpr (std::is_same_v<T, double>) {
+        return value.f;
+    } else if constexpr (sizeof(T) == 16) {
+        return static_cast<T>(value.wide);
+    } else {
+        return static_cast<T>(value.u);
+    }
+}
+
+// Types of up to 64 bits are sign- or zero-extended to 64 (see Value)
+template <typename T> void set(Value &value, T x) {
+    if constexpr (std::is_same_v<T, double>) {
+        value.f = x;
+    } else if constexpr (sizeof(T) == 16) {
+        value.wide = static_cast<u128>(x);
+    } else if constexpr (is_signed<T>) {
+        value.i = x;
+    } else {
+        value.u = x;
+    }
+}
+
+template <typename T> T add(T a, T b) {
+    if constexpr (std::is_same_v<T, double>) return a + b;
+    else return static_cast<T>(static_cast<Bits<T>>(a) + static_cast<Bits<T>>(b));
+}
+template <typename T> T sub(T a, T b) {
+    if constexpr (std::is_same_v<T, double>) return a - b;
+    else return static_cast<T>(static_cast<Bits<T>>(a) - static_cast<Bits<T>>(b));
+}
+template <typename T> T mul(T a, T b) {
+    if constexpr (std::is_same_v<T, double>) return a * b;
+    else return static_cast<T>(static_cast<Bits<T>>(a) * static_cast<Bits<T>>(b));
+}
+// `b` is not 0; MIN / -1 wraps around to MIN, and MIN % -1 is 0
+template <typename T> T div(T a, T b) {
+    if constexpr (is_signed<T>) {
+        if (b == -1) return static_cast<T>(Bits<T>{0} - static_cast<Bits<T>>(a));
+    }
+    return static_cast<T>(a / b);
+}
+template <typename T> T mod(T a, T b) {
+    if constexpr (is_signed<T>) {
+        if (b == -1) return 0;
+    }
+    return static_cast<T>(a % b);
+}
+template <typename T> T neg(T a) {
+    if constexpr (std::is_same_v<T, double>) return -a;
+    else return static_cast<T>(Bits<T>{0} - static_cast<Bits<T>>(a));
+}
+// The count is taken modulo the width
+template <typename T> T shl(T a, T b) {
+    unsigned count = static_cast<unsigned>(b) & (sizeof(T) * 8 - 1);
+    return static_cast<T>(static_cast<Bits<T>>(a) << count);
+}
+template <typename T> T shr(T a, T b) {
+    unsigned count = static_cast<unsigned>(b) & (sizeof(T) * 8 - 1);
+    return static_cast<T>(a >> count);
+}
+
+/**
+ * Iterators
+ *
+ * An iterator is a function that writes the next value and returns true, or returns false
+ * once there is none, next to its state.
+ */
+struct Iterator {
+    bool (*next)(Iterator *self, Value *out);
+};
+
+template <typename T> struct RangeIterator : Iterator {
+    T at;
+    T end;
+
+    static bool advance(Iterator *self, Value *out) {
+        auto *range = static_cast<RangeIterator *>(self);
+        if (range->at >= range->end) return false;
+        set<T>(*out, range->at);
+        range->at = add<T>(range->at, 1);
+        return true;
+    }
+};
+
+std::string format_wide(u128 magnitude, bool negative) {
+    char digits[40];
+    char *at = digits + sizeof(digits);
+    do {
+        *--at = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude);
+    if (negative) *--at = '-';
+    return {at, digits + sizeof(digits)};
+}
+
+} // namespace
+
+Vm::Vm(size_t stack_size, size_t max_frames) : stack(stack_size), max_frames(max_frames) {
+    frames.reserve(max_frames);
+}
+
+// An object is its fields, after a header holding its layout
+Value *Vm::new_object(uint32_t layout) {
+    size_t count = program->layouts[layout].size();
+    Value *object = heap.allocate_array<Value>(count + 1) + 1;
+    object[-1].u = layout;
+    std::memset(object, 0, count * sizeof(Value));
+    return object;
+}
+
+Value *Vm::copy_object(const Value *object) {
+    const std::vector<int32_t> &fields = program->layouts[object[-1].u];
+    Value *copy = heap.allocate_array<Value>(fields.size() + 1) + 1;
+    std::memcpy(copy - 1, object - 1, (fields.size() + 1) * sizeof(Value));
+    for (size_t idx = 0; idx < fields.size(); idx++) {
+        if (fields[idx] >= 0) copy[idx].ptr = copy_object(static_cast<Value *>(object[idx].ptr));
+    }
+    return copy;
+}
+
+void Vm::print(const PrintFormat &format, const Value *args) {
+    std::string &out = output ? *output : buffer;
+    for (size_t idx = 0; idx < format.types.size(); idx++) {
+        out += format.pieces[idx];
+        const Value &arg = args[idx];
+        switch (format.types[idx]) {
+            case TypeKind::I8:
+            case TypeKind::I16:
+            case TypeKind::I32:
+            case TypeKind::I64:
+                out += std::format("{}", arg.i);
+                break;
+            case TypeKind::U8:
+            case TypeKind::U16:
+            case TypeKind::U32:
+            case TypeKind::U64:
+                out += std::format("{}", arg.u);
+                break;
+            case TypeKind::I128: {
+                bool negative = static_cast<i128>(arg.wide) < 0;
+                out += format_wide(negative ? 0 - arg.wide : arg.wide, negative);
+                break;
+            }
+            case TypeKind::U128:
+                out += format_wide(arg.wide, false);
+                break;
+            case TypeKind::F64:
+                out += std::format("{}", arg.f);
+                break;
+            case TypeKind::Bool:
+                out += arg.u ? "true" : "false";
+                break;
+            case TypeKind::Ch:
+                out += static_cast<char>(arg.u);
+                break;
+            default:
+                break;
+        }
+    }
+    out += format.pieces.back();
+    if (format.newline) out += '\n';
+    if (!output && buffer.size() >= 1 << 16) flush();
+}
+
+void Vm::flush() {
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    buffer.clear();
+}
+
+// xorshift64*
+uint64_t Vm::random() {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return random_state * 0x2545F4914F6CDD1D;
+}
+
+std::unexpected<CompilerError> Vm::error(Message message, const Function &function,
+                                         const Instruction *pc) const {
+    const TokenBuffer &tokens = *program->tokens;
+    uint32_t token = function.tokens[pc - function.code.data()];
+    uint32_t offset = tokens.empty() ? 0 : tokens.start(token);
+    return Diagnostic{offset, tokens.line_at(offset), tokens.column_at(offset), {0, 0}, message}
+        .to_error()
+        .unexpected();
+}
+
+std::expected<Value, CompilerError> Vm::run(const Program &program) {
+    this->program = &program;
+    heap.reset();
+    globals.assign(program.globals, Value{});
+    frames.clear();
+    auto result = execute();
+    if (!output) flush();
+    return result;
+}
+
+std::expected<Value, CompilerError> Vm::execute() {
+    const Program &program = *this->program;
+    const Function *function = &program.functions[program.entry];
+    const Instruction *pc = function->code.data();
+    const Value *constants = function->constants.data();
+    Value *base = stack.data();
+    Value *const stack_end = stack.data() + stack.size();
+    if (function->registers > stack.size()) return error(Message::StackOverflow, *function, pc);
+
+#define DOVE_VM_LABEL(name, format) &&op_##name,
+    static const void *const labels[] = {DOVE_OPCODES(DOVE_VM_LABEL)};
+#undef DOVE_VM_LABEL
+
+#define DISPATCH() goto *labels[static_cast<uint8_t>(pc->op)]
+#define NEXT()                                                                                 \
+    do {                                                                                       \
+        pc++;                                                                                  \
+        DISPATCH();                                                                            \
+    } while (0)
+#define JUMP()                                                                                 \
+    do {                                                                                       \
+        pc += pc->x + 1;                                                                       \
+        DISPATCH();                                                                            \
+    } while (0)
+#define A base[pc->a]
+#define B base[pc->b]
+#define C base[pc->c]
+
+    DISPATCH();
+
+    // Registers and globals
+op_Move:
+    A = B;
+    NEXT();
+op_LoadInt:
+    A.wide = static_cast<u128>(static_cast<i128>(pc->x));
+    NEXT();
+op_LoadConst:
+    A = constants[pc->x];
+    NEXT();
+op_GetGlobal:
+    A = globals[pc->x];
+    NEXT();
+op_SetGlobal:
+    globals[pc->x] = A;
+    NEXT();
+
+    // Arithmetic
+#define DOVE_VM_ARITHMETIC(name, T)                                                            \
+    op_Add##name : set<T>(A, add<T>(get<T>(B), get<T>(C)));                                    \
+    NEXT();                                                                                    \
+    op_Sub##name : set<T>(A, sub<T>(get<T>(B), get<T>(C)));                                    \
+    NEXT();                                                                                    \
+    op_Mul##name : set<T>(A, mul<T>(get<T>(B), get<T>(C)));                                    \
+    NEXT();                                                                                    \
+    op_Div##name : if (get<T>(C) == 0) [[unlikely]] goto division_by_zero;                     \
+    set<T>(A, div<T>(get<T>(B), get<T>(C)));                                                   \
+    NEXT();                                                                                    \
+    op_Mod##name : if (get<T>(C) == 0) [[unlikely]] goto division_by_zero;                     \
+    set<T>(A, mod<T>(get<T>(B), get<T>(C)));                                                   \
+    NEXT();                                                                                    \
+    op_Shl##name : set<T>(A, shl<T>(get<T>(B), get<T>(C)));                                    \
+    NEXT();                                                                                    \
+    op_Shr##name : set<T>(A, shr<T>(get<T>(B), get<T>(C)));                                    \
+    NEXT();                                                                                    \
+    op_AddImm##name : set<T>(A, add<T>(get<T>(B), static_cast<T>(pc->x)));                     \
+    NEXT();
+    DOVE_VM_INTEGER_TYPES(DOVE_VM_ARITHMETIC)
+#undef DOVE_VM_ARITHMETIC
+op_AddF64:
+    A.f = B.f + C.f;
+    NEXT();
+op_SubF64:
+    A.f = B.f - C.f;
+    NEXT();
+op_MulF64:
+    A.f = B.f * C.f;
+    NEXT();
+op_DivF64:
+    A.f = B.f / C.f;
+    NEXT();
+op_ModF64:
+    A.f = std::fmod(B.f, C.f);
+    NEXT();
+op_BitAnd64:
+    A.u = B.u & C.u;
+    NEXT();
+op_BitAnd128:
+    A.wide = B.wide & C.wide;
+    NEXT();
+op_BitOr64:
+    A.u = B.u | C.u;
+    NEXT();
+op_BitOr128:
+    A.wide = B.wide | C.wide;
+    NEXT();
+
+    // Unary
+#define DOVE_VM_NEG(name, T)                                                                   \
+    op_Neg##name : set<T>(A, neg<T>(get<T>(B)));                                               \
+    NEXT();
+    DOVE_VM_SIGNED_TYPES(DOVE_VM_NEG)
+#undef DOVE_VM_NEG
+op_NegF64:
+    A.f = -B.f;
+    NEXT();
+op_Not:
+    A.u = B.u ^ 1;
+    NEXT();
+
+    // Comparisons and compare-and-branch
+#define DOVE_VM_ORDER(name, T)                                                                 \
+    op_Lt##name : A.u = get<T>(B) < get<T>(C);                                                 \
+    NEXT();                                                                                    \
+    op_Le##name : A.u = get<T>(B) <= get<T>(C);                                                \
+    NEXT();                                                                                    \
+    op_JumpLt##name : if (get<T>(A) < get<T>(B)) JUMP();                                       \
+    NEXT();                                                                                    \
+    op_JumpLe##name : if (get<T>(A) <= get<T>(B)) JUMP();                                      \
+    NEXT();
+    DOVE_VM_ORDER_TYPES(DOVE_VM_ORDER)
+#undef DOVE_VM_ORDER
+#define DOVE_VM_EQUALITY(name, T)                                                              \
+    op_Eq##name : A.u = get<T>(B) == get<T>(C);                                                \
+    NEXT();                                                                                    \
+    op_Ne##name : A.u = get<T>(B) != get<T>(C);                                                \
+    NEXT();                                                                                    \
+    op_JumpEq##name : if (get<T>(A) == get<T>(B)) JUMP();                                      \
+    NEXT();                                                                                    \
+    op_JumpNe##name : if (get<T>(A) != get<T>(B)) JUMP();                                      \
+    NEXT();
+    DOVE_VM_EQUALITY_TYPES(DOVE_VM_EQUALITY)
+#undef DOVE_VM_EQUALITY
+op_JumpNotLtF64:
+    if (!(A.f < B.f)) JUMP();
+    NEXT();
+op_JumpNotLeF64:
+    if (!(A.f <= B.f)) JUMP();
+    NEXT();
+op_JumpLtImmI64:
+    if (A.i < pc->immediate()) JUMP();
+    NEXT();
+op_JumpLtImmU64:
+    if (A.u < static_cast<uint64_t>(pc->immediate())) JUMP();
+    NEXT();
+op_JumpLeImmI64:
+    if (A.i <= pc->immediate()) JUMP();
+    NEXT();
+op_JumpLeImmU64:
+    if (A.u <= static_cast<uint64_t>(pc->immediate())) JUMP();
+    NEXT();
+op_JumpGtImmI64:
+    if (A.i > pc->immediate()) JUMP();
+    NEXT();
+op_JumpGtImmU64:
+    if (A.u > static_cast<uint64_t>(pc->immediate())) JUMP();
+    NEXT();
+op_JumpGeImmI64:
+    if (A.i >= pc->immediate()) JUMP();
+    NEXT();
+op_JumpGeImmU64:
+    if (A.u >= static_cast<uint64_t>(pc->immediate())) JUMP();
+    NEXT();
+op_JumpEqImm:
+    if (A.i == pc->immediate()) JUMP();
+    NEXT();
+op_JumpNeImm:
+    if (A.i != pc->immediate()) JUMP();
+    NEXT();
+op_Jump:
+    JUMP();
+op_JumpTable: {
+    const JumpTable &table = function->tables[pc->x];
+    uint64_t index = A.u - static_cast<uint64_t>(table.low);
+    pc = function->code.data() +
+         (index < table.targets.size() ? table.targets[index] : table.fallback);
+    DISPATCH();
+}
+op_JumpIf:
+    if (A.u) JUMP();
+    NEXT();
+op_JumpIfNot:
+    if (!A.u) JUMP();
+    NEXT();
+
+    // Calls
+op_Call: {
+    const Function *callee = &program.functions[pc->x];
+    Value *callee_base = base + pc->a;
+    if (frames.size() == max_frames || callee->registers > stack_end - callee_base)
+        [[unlikely]] {
+        return error(Message::StackOverflow, *function, pc);
+    }
+    frames.push_back({function, pc, base});
+    function = callee;
+    constants = callee->constants.data();
+    base = callee_base;
+    pc = callee->code.data();
+    DISPATCH();
+}
+op_Return:
+    base[0] = A;
+    if (frames.empty()) return base[0];
+    goto pop_frame;
+op_ReturnUnit:
+    if (frames.empty()) return Value{};
+pop_frame: {
+    const Frame &frame = frames.back();
+    function = frame.function;
+    constants = function->constants.data();
+    base = frame.base;
+    pc = frame.pc;
+    frames.pop_back();
+    NEXT();
+}
+op_Native:
+    switch (static_cast<Native>(pc->x)) {
+        case Native::RandBool:
+            A.u = random() >> 63;
+            break;
+    }
+    NEXT();
+op_Print:
+    print(program.formats[pc->x], &A);
+    NEXT();
+
+    // Objects
+op_New:
+    A.ptr = new_object(static_cast<uint32_t>(pc->x));
+    NEXT();
+op_Copy:
+    A.ptr = copy_object(static_cast<Value *>(B.ptr));
+    NEXT();
+op_GetField:
+    A = static_cast<Value *>(B.ptr)[pc->c];
+    NEXT();
+op_SetField:
+    static_cast<Value *>(A.ptr)[pc->b] = C;
+    NEXT();
+
+    // Iterators
+#define DOVE_VM_RANGE(name, T)                                                                 \
+    op_Range##name : {                                                                         \
+        auto *range = heap.allocate_array<RangeIterator<T>>(1);                                \
+        range->next = RangeIterator<T>::advance;                                               \
+        range->at = get<T>(B);                                                                 \
+        range->end = get<T>(C);                                                                \
+        A.ptr = range;                                                                         \
+        NEXT();                                                                                \
+    }
+    DOVE_VM_RANGE(I64, int64_t)
+    DOVE_VM_RANGE(U64, uint64_t)
+    DOVE_VM_RANGE(I128, i128)
+    DOVE_VM_RANGE(U128, u128)
+#undef DOVE_VM_RANGE
+op_IterNext: {
+    auto *iterator = static_cast<Iterator *>(A.ptr);
+    if (!iterator->next(iterator, &B)) JUMP();
+    NEXT();
+}
+
+    // Counted loops; the counter is below the end, so it cannot overflow
+op_ForLoopI64:
+    A.u++;
+    if (A.i < B.i) JUMP();
+    NEXT();
+op_ForLoopU64:
+    A.u++;
+    if (A.u < B.u) JUMP();
+    NEXT();
+op_ForLoopI128:
+    A.wide++;
+    if (static_cast<i128>(A.wide) < static_cast<i128>(B.wide)) JUMP();
+    NEXT();
+op_ForLoopU128:
+    A.wide++;
+    if (A.wide < B.wide) JUMP();
+    NEXT();
+
+division_by_zero:
+    return error(Message::DivisionByZero, *function, pc);
+
+#undef C
+#undef B
+#undef A
+#undef JUMP
+#undef NEXT
+#undef DISPATCH
+}
\ No newline at end of file
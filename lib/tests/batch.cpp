@@ -0,0 +1,141 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <print>
+#include <string>
+#include <vector>
+
+// Counts every allocation of the process, to check that reuse stops allocating
+std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size) {
+    allocations++;
+    if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+bool same_token(const Dove::TokenBuffer &a, const Dove::Interner &a_names, size_t a_idx,
+                const Dove::TokenBuffer &b, const Dove::Interner &b_names, size_t b_idx);
+
+// Reused lexers and batches must match a fresh Lexer per source, without allocating once warm
+int main() {
+    Dove::SourceManager files;
+    auto example = Test::load_example(files);
+    if (!example) return 1;
+    std::string unit(*example);
+
+    std::vector<std::string> texts = {
+        "let x: i32 = 42;\n",
+        "",
+        "func größe() -> f64 { rtn 2.5e3; } // é\n",
+        "let s = \"oops\n",
+        unit,
+        "/* unterminated",
+        "let bad = \xC3;\n",
+        "match c {\n    is 'x': 0b1010;\n    fallback: 0xFF;\n}",
+        "a\0 hidden after the NUL",
+    };
+    texts[8].assign("a\0 hidden after the NUL", 23);
+    std::vector<std::string_view> sources(texts.begin(), texts.end());
+    int failures = 0;
+
+    Dove::Lexer lexer;
+    Dove::TokenBatch batch;
+    lexer.lex_batch(sources, batch);
+    if (batch.size() != sources.size()) {
+        std::println("FAIL batch of {} sources has {}", sources.size(), batch.size());
+        return 1;
+    }
+
+    for (size_t idx = 0; idx < sources.size(); idx++) {
+        Dove::Lexer fresh(sources[idx]);
+        auto expected = fresh.get_token_buffer();
+        auto [first, last] = batch.range(idx);
+        auto [first_diagnostic, last_diagnostic] = batch.diagnostic_range(idx);
+
+        // A failed source has the same diagnostics as when lexed alone
+        const Dove::Diagnostics &diagnostics = fresh.get_diagnostics();
+        bool ok = batch.source(idx) == sources[idx] && expected.has_value() == !batch.failed(idx) &&
+                  last_diagnostic - first_diagnostic == diagnostics.size();
+        for (size_t i = 0; ok && i < diagnostics.size(); i++) {
+            ok = diagnostics[i].format() ==
+                 batch.get_diagnostics()[first_diagnostic + i].format();
+        }
+        if (ok && expected) {
+            ok = expected.value()->size() == last - first;
+            for (size_t i = 0; ok && i < last - first; i++) {
+                ok = same_token(*expected.value(), fresh.get_interner(), i, batch.get_tokens(),
+                                batch.get_interner(), first + i) &&
+                     expected.value()->line(i) == batch.line(first + i);
+            }
+        }
+        if (!ok) {
+            std::println("FAIL batch source {}", idx);
+            failures++;
+        }
+
+        // reset() and lex_into() give what a fresh lexer gives
+        Dove::TokenBuffer out;
+        for (auto res : {lexer.reset(sources[idx]), lexer.lex_into(sources[idx], out)}) {
+            if (res.has_value() != expected.has_value() ||
+                (!res && res.error().format() != expected.error().format())) {
+                std::println("FAIL reuse result of source {}", idx);
+                failures++;
+            }
+        }
+        bool same = expected && out.size() == expected.value()->size();
+        for (size_t i = 0; same && i < out.size(); i++) {
+            same = same_token(*expected.value(), fresh.get_interner(), i, out,
+                              lexer.get_interner(), i) &&
+                   expected.value()->line(i) == out.line(i);
+        }
+        if (expected && !same) {
+            std::println("FAIL lex_into source {}", idx);
+            failures++;
+        }
+    }
+
+    // Warm up, then refilling with sources that lex cleanly must not allocate
+    std::vector<std::string_view> clean = {sources[0], sources[2], sources[4], sources[7]};
+    Dove::TokenBuffer out;
+    for (int run = 0; run < 3; run++) {
+        lexer.lex_batch(clean, batch);
+        for (std::string_view src : clean) (void)lexer.lex_into(src, out);
+        for (std::string_view src : clean) (void)lexer.reset(src);
+    }
+    uint64_t before = allocations.load();
+    for (int run = 0; run < 10; run++) {
+        lexer.lex_batch(clean, batch);
+        for (std::string_view src : clean) (void)lexer.lex_into(src, out);
+        for (std::string_view src : clean) (void)lexer.reset(src);
+    }
+    // Instrumented builds log a trace event per run
+    bool instrumented = false;
+    DOVE_METRIC(instrumented = true;)
+    if (allocations.load() != before && !instrumented) {
+        std::println("FAIL {} allocations at steady state", allocations.load() - before);
+        failures++;
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_token(const Dove::TokenBuffer &a, const Dove::Interner &a_names, size_t a_idx,
+                const Dove::TokenBuffer &b, const Dove::Interner &b_names, size_t b_idx) {
+    // Symbol ids and literal indices differ between buffers; compare what they refer to
+    Dove::TokenType type = a.kind(a_idx);
+    bool value = Dove::TokenBuffer::has_symbol(type)
+                     ? a_names.name(a.value(a_idx)) == b_names.name(b.value(b_idx))
+                 : Dove::TokenBuffer::has_integer(type) ? a.integer(a_idx) == b.integer(b_idx)
+                 : type == Dove::TokenType::ValueFloatingPointNumber
+                     ? a.floating(a_idx) == b.floating(b_idx)
+                     : a.value(a_idx) == b.value(b_idx);
+    return value && type == b.kind(b_idx) && a.str(a_idx) == b.str(b_idx) &&
+           a.column(a_idx) == b.column(b_idx);
+}
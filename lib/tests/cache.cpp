@@ -0,0 +1,114 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+bool same_tokens(Dove::Lexer &lexer, Dove::TokenStream &stream);
+
+// A stream replayed from the token cache must match the Lexer, and stale entries must miss
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string src(*example);
+    src += "let größe = \"日本\" + 'é'; " + std::string(70000, 'x') + " 0x" +
+           std::string(32, 'f') + " 2.5 \"a\\tb\"\n";
+
+    char directory[] = "/tmp/dove-cache-XXXXXX";
+    if (!mkdtemp(directory)) {
+        std::println("Error creating cache directory");
+        return 1;
+    }
+    Dove::TokenCache cache(std::string(directory) + "/tokens");
+    int failures = 0;
+
+    if (cache.load(src)) {
+        std::println("FAIL hit in an empty cache");
+        failures++;
+    }
+
+    // Cold: lexes and stores; warm: replays the mapped entry
+    Dove::Lexer lexer(src);
+    for (std::string_view run : {"cold", "warm"}) {
+        Dove::TokenStream stream = Dove::Lexer::stream(src, cache);
+        if (!same_tokens(lexer, stream)) {
+            std::println("FAIL {} stream", run);
+            failures++;
+        }
+    }
+
+    auto entry = cache.load(src);
+    if (!entry || entry->size() != lexer.get_token_buffer().value()->size() ||
+        entry->integer(entry->size() - 3) != ~Dove::u128{0} ||
+        entry->floating(entry->size() - 2) != 2.5) {
+        std::println("FAIL mapped entry");
+        failures++;
+    }
+
+    // Different contents are a different key
+    std::string changed = src;
+    changed[0] = ' ';
+    if (cache.load(changed)) {
+        std::println("FAIL hit for changed contents");
+        failures++;
+    }
+
+    // A truncated or corrupted entry is a miss, not a crash
+    std::string path = cache.path(Dove::TokenCache::key(src));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last = static_cast<char>(file.get());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(~last));
+    }
+    if (cache.load(src)) {
+        std::println("FAIL damaged body");
+        failures++;
+    }
+    if (truncate(path.c_str(), 100) != 0 || cache.load(src)) {
+        std::println("FAIL truncated entry");
+        failures++;
+    }
+    std::ofstream(path, std::ios::binary) << "DOVETOK";
+    if (cache.load(src)) {
+        std::println("FAIL corrupted entry");
+        failures++;
+    }
+
+    // Sources with errors are lexed every time and report their error
+    std::string bad = src + "\"oops\n";
+    Dove::TokenStream stream = Dove::Lexer::stream(bad, cache);
+    for ([[maybe_unused]] const Dove::Token &t : stream) {
+    }
+    if (!stream.get_error() || cache.load(bad)) {
+        std::println("FAIL source with an error");
+        failures++;
+    }
+
+    std::system(std::format("rm -rf {}", directory).c_str());
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_tokens(Dove::Lexer &lexer, Dove::TokenStream &stream) {
+    const std::vector<Dove::Token> &expected = *lexer.get_tokens().value();
+    size_t idx = 0;
+    for (const Dove::Token &t : stream) {
+        if (idx >= expected.size()) return false;
+        const Dove::Token &e = expected[idx++];
+        if (t.type != e.type || t.value != e.value || t.str != e.str || t.line != e.line ||
+            t.column != e.column ||
+            (Dove::TokenBuffer::has_symbol(t.type) &&
+             stream.get_interner().name(t.value) != lexer.get_interner().name(e.value))) {
+            return false;
+        }
+    }
+    return idx == expected.size() && !stream.get_error();
+}
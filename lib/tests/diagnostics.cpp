@@ -0,0 +1,101 @@
+#include "dove/dove.h"
+
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One pass reports every lexer error, and lexing goes on after each of them
+int main() {
+    const std::string src = "let a = #;\n"
+                            "let s = \"a\\q\" + 'xy' + '';\n"
+                            "let n = 0xZ + 0b12 + 99999999999999999999999999999999999999999;\n"
+                            "let t = \"open\n"
+                            "let m = 1.5;\n";
+    const std::string_view expected[] = {
+        "[E1000] 1:9: Unexpected character (0x23).",
+        "[E1008] 2:11: Unknown escape sequence (\\q).",
+        "[E1003] 2:17: A single character should be written between single-quotes.",
+        "[E1002] 2:24: Character value is empty.",
+        "[E1005] 3:11: Invalid digit 'Z' in hexadecimal literal.",
+        "[E1005] 3:18: Invalid digit '2' in binary literal.",
+        "[E1006] 3:22: Integer literal does not fit in 128 bits.",
+        "[E1001] 4:9: Strings should end with a double quote. Multi-line strings are not yet "
+        "supported.",
+    };
+    const std::string_view lexemes[] = {
+        "#", "\"a\\q\"", "'xy'", "''", "0xZ", "0b12", "99999999999999999999999999999999999999999",
+        "\"open"};
+    int failures = 0;
+
+    Dove::Lexer lexer(src);
+    const Dove::Diagnostics &diagnostics = lexer.get_diagnostics();
+    bool ok = diagnostics.size() == std::size(expected);
+    for (size_t i = 0; ok && i < diagnostics.size(); i++) {
+        ok = diagnostics[i].format() == expected[i];
+    }
+    if (!ok) {
+        std::println("FAIL diagnostics:\n{}", diagnostics.format());
+        failures++;
+    }
+
+    // The std::expected API gives the first one
+    auto res = lexer.get_token_buffer();
+    if (res || res.error().format() != expected[0]) {
+        std::println("FAIL first error");
+        failures++;
+    }
+
+    // Each rejected lexeme is one Error token pointing at its diagnostic, and the tokens
+    // around it are the ones a clean source would give
+    Dove::Lexer reusable;
+    Dove::TokenBatch batch;
+    std::string_view sources[] = {src};
+    reusable.lex_batch(sources, batch);
+    const Dove::TokenBuffer &tokens = batch.get_tokens();
+    std::vector<size_t> errors;
+    for (size_t idx = 0; idx < tokens.size(); idx++) {
+        if (tokens.kind(idx) == Dove::TokenType::Error) errors.push_back(idx);
+    }
+    ok = errors.size() == std::size(lexemes) && batch.failed(0);
+    for (size_t i = 0; ok && i < errors.size(); i++) {
+        ok = tokens.str(errors[i]) == lexemes[i] && tokens.value(errors[i]) == i;
+    }
+    ok = ok && tokens.size() == 32 && tokens.kind(31) == Dove::TokenType::SymbolSemicolon &&
+         tokens.kind(30) == Dove::TokenType::ValueFloatingPointNumber &&
+         tokens.kind(errors[0] + 1) == Dove::TokenType::SymbolSemicolon;
+    if (!ok) {
+        std::println("FAIL error tokens");
+        failures++;
+    }
+
+    // A stream still stops at the first error
+    Dove::TokenStream stream = Dove::Lexer::stream(src);
+    size_t count = 0;
+    for ([[maybe_unused]] const Dove::Token &token : stream) count++;
+    if (count != 3 || !stream.get_error() || stream.get_error()->format() != expected[0]) {
+        std::println("FAIL stream stopped after {} tokens", count);
+        failures++;
+    }
+
+    // Invalid UTF-8 reports every bad sequence, and nothing is lexed
+    Dove::Lexer invalid("a \xC3 b \xFF\x80\x80 c \xE2\x82");
+    if (invalid.get_diagnostics().size() != 3 ||
+        invalid.get_diagnostics()[0].type() != Dove::ErrorType(Dove::LexerError::InvalidUtf8)) {
+        std::println("FAIL invalid UTF-8:\n{}", invalid.get_diagnostics().format());
+        failures++;
+    }
+
+    // Fixing the errors one by one leaves the others in place
+    std::string text = src;
+    Dove::Lexer editor(text);
+    editor.edit(text, 8, 1, "0");
+    if (editor.get_diagnostics().size() != std::size(expected) - 1 ||
+        editor.get_diagnostics()[0].format() != expected[1]) {
+        std::println("FAIL edit:\n{}", editor.get_diagnostics().format());
+        failures++;
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+
+using Dove::TokenType;
+
+// Lexed while this file compiles: a lexer error in it would fail the build
+constexpr auto script = Dove::EmbeddedLexer::lex<"func größe(x: i32) -> i32 {\n"
+                                                 "    let s = \"a\\tb\"; // comment\n"
+                                                 "    rtn x * 0x1F + 'é' + s;\n"
+                                                 "} /* π */ 2.5 x\n">();
+
+static_assert(script.size() == 27);
+static_assert(script[0].type == TokenType::KeywordFunc);
+static_assert(script[1].type == TokenType::ValueIdentifier && script.name(0) == "größe");
+static_assert(script[1].line == 1 && script[1].column == 6);
+static_assert(script[13].type == TokenType::ValueString && script[13].str == "a\\tb" &&
+              script.name(script[13].value) == "a\tb" && script[13].column == 13);
+static_assert(script[16].line == 3 && script[18].type == TokenType::PrefixHexadecimal &&
+              script.integer(script[18]) == 31);
+static_assert(script[20].type == TokenType::ValueCharacter && script[20].value == U'é');
+static_assert(script[24].type == TokenType::SymbolRightCurlyBracket &&
+              script[24].line == 4);
+static_assert(script.floating(script[25]) == 2.5 && script[25].column == 11);
+static_assert(script[26].value == script[3].value && script.symbol_count() == 4);
+
+// A decoded string that is already a name gets its id
+constexpr auto escaped = Dove::EmbeddedLexer::lex<"\"a\\tb\" x \"a\\tb\" \"\\n\"">();
+static_assert(escaped[2].value == escaped[0].value && escaped.symbol_count() == 3 &&
+              escaped.name(escaped[3].value) == "\n");
+
+// Bad scripts only fail at compile time through lex<>(); counted here instead
+constexpr size_t error_count(std::string_view source) {
+    return Dove::EmbeddedLexer(source).get_diagnostics().size();
+}
+static_assert(error_count("let a = 1;") == 0);
+static_assert(error_count("let a = #; 'xy' 0b12 \"\\q\"") == 4);
+static_assert(error_count("\"open\nlet x = 99999999999999999999999999999999999999999;") == 2);
+
+bool same_as_lexer(const std::string &src);
+
+// At run time the EmbeddedLexer must agree with the Lexer on everything, errors included
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string unit(*example);
+
+    int failures = 0;
+    failures += !same_as_lexer("");
+    failures += !same_as_lexer(unit);
+    failures += !same_as_lexer("a \xC3 b \xFF\x80\x80 c \xE2\x82");
+
+    // Random runs of valid and invalid lexemes
+    const std::string_view pieces[] = {
+        "let", " ", "\n", "x", "größe", "_a1", "=", "==", "->", "::", "<<=", ".", ";", "#",
+        "\"str\"", "\"e\\n\\\"\"", "\"bad\\q\"", "\"open", "'c'", "'é'", "'\\n'", "''", "'ab'",
+        "'", "0", "42", "1.5", "0.125", "0x1f", "0b102", "0o7", "0x", "1.",
+        "99999999999999999999999999999999999999999", "// line", "/* block\n */", "/* open",
+        "€", "\t", "\r\n", "/"};
+    std::mt19937 rng(19);
+    for (int round = 0; round < 500; round++) {
+        std::string src;
+        size_t count = rng() % 40;
+        for (size_t i = 0; i < count; i++) src += pieces[rng() % std::size(pieces)];
+        if (!same_as_lexer(src)) {
+            failures++;
+            break;
+        }
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_as_lexer(const std::string &src) {
+    Dove::Lexer lexer;
+    Dove::TokenBatch batch;
+    std::string_view sources[] = {src};
+    lexer.lex_batch(sources, batch);
+    const Dove::TokenBuffer &tokens = batch.get_tokens();
+
+    Dove::EmbeddedLexer embedded(src);
+    const std::vector<Dove::Token> &views = embedded.get_tokens();
+    bool ok = views.size() == tokens.size() &&
+              embedded.get_diagnostics().size() == batch.get_diagnostics().size() &&
+              embedded.symbol_count() == batch.get_interner().size();
+    for (size_t idx = 0; ok && idx < tokens.size(); idx++) {
+        const Dove::Token &token = views[idx];
+        ok = token.type == tokens.kind(idx) && token.str == tokens.str(idx) &&
+             token.line == batch.line(idx) && token.column == batch.column(idx);
+        if (ok && Dove::TokenBuffer::has_integer(token.type)) {
+            ok = embedded.get_integers()[token.value] == tokens.integer(idx);
+        } else if (ok && token.type == TokenType::ValueFloatingPointNumber) {
+            ok = embedded.get_floats()[token.value] == tokens.floating(idx);
+        } else if (ok) {
+            ok = token.value == tokens.value(idx);
+        }
+        if (ok && Dove::TokenBuffer::has_symbol(token.type)) {
+            ok = embedded.name(token.value) == batch.get_interner().name(tokens.value(idx));
+        }
+    }
+    for (size_t i = 0; ok && i < embedded.get_diagnostics().size(); i++) {
+        ok = embedded.get_diagnostics()[i].format() == batch.get_diagnostics()[i].format();
+    }
+    if (!ok) std::println("FAIL {}", src);
+    return ok;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "dove/dove.h"
+
+#include <optional>
+#include <print>
+#include <string_view>
+
+namespace Test {
+
+// examples/exp1.dv, which most tests build their sources from. The text lives in `sources`;
+// on failure the error has been printed and the test should return 1.
+inline std::optional<std::string_view> load_example(Dove::SourceManager &sources) {
+    auto id = sources.load("examples/exp1.dv");
+    if (!id) {
+        std::println("Error reading file");
+        return std::nullopt;
+    }
+    return sources.get_text(*id);
+}
+
+} // namespace Test
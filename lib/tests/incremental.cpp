@@ -0,0 +1,124 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+bool same_result(Dove::Lexer &incremental, const std::string &text);
+
+// After any sequence of edits, the incremental lexer must agree with a fresh Lexer
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string unit(*example);
+    unit += "let größe = \"日本\" + 'é'; /* ü */ 0x1F 2.5\n";
+
+    int failures = 0;
+
+    // Edits that open and close strings and comments far from where they happen
+    struct Case {
+        std::string_view name;
+        std::string_view replacement;
+        uint32_t length;
+    };
+    const Case cases[] = {
+        {"open block comment", "/*", 0}, {"open line comment", "//", 0},
+        {"open string", "\"", 0},        {"insert newline", "\n", 0},
+        {"insert NUL", {"\0", 1}, 0},    {"invalid UTF-8", "\xC3", 0},
+        {"delete", "", 7},               {"replace", "let x = 0b101;", 3},
+    };
+    for (const Case &c : cases) {
+        std::string text = unit + unit + unit;
+        Dove::Lexer lexer(text);
+        uint32_t offset = static_cast<uint32_t>(unit.size() + 10);
+        lexer.edit(text, offset, c.length, c.replacement);
+        bool ok = same_result(lexer, text);
+        // ... and undoing the edit restores the original tokens
+        lexer.edit(text, offset, static_cast<uint32_t>(c.replacement.size()),
+                   std::string(unit + unit + unit).substr(offset, c.length));
+        ok = ok && same_result(lexer, text);
+        if (!ok) {
+            std::println("FAIL {}", c.name);
+            failures++;
+        }
+    }
+
+    // Random edits, including ones that split UTF-8 sequences or leave errors behind
+    const std::string_view fragments[] = {"",  "a",  "_b1", "7",  ".",  "..", "\"", "'",
+                                          "\\", "/", "*",   "/*", "*/", "//", "\n", " ",
+                                          "é", "π", "=",   "==", "0x", "3.14", "#", "{}"};
+    std::mt19937 rng(7);
+    std::string text = unit + unit + unit + unit;
+    Dove::Lexer lexer(text);
+    for (int i = 0; i < 3000; i++) {
+        uint32_t offset = rng() % (text.size() + 1);
+        uint32_t length = std::min<uint32_t>(rng() % 4, text.size() - offset);
+        lexer.edit(text, offset, length, fragments[rng() % std::size(fragments)]);
+        if (!same_result(lexer, text)) {
+            std::println("FAIL random edit {} ({} bytes at {})", i, length, offset);
+            failures++;
+            break;
+        }
+    }
+
+    // One-character edits in the middle of a 50k-line file should not touch the rest
+    std::string large;
+    while (static_cast<size_t>(std::count(large.begin(), large.end(), '\n')) < 50000) {
+        large += unit;
+    }
+    Dove::Lexer editor(large);
+    uint32_t middle = static_cast<uint32_t>(large.find("let", large.size() / 2));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        editor.edit(large, middle, 0, "x");
+        editor.edit(large, middle, 1, "");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (!same_result(editor, large)) {
+        std::println("FAIL large file");
+        failures++;
+    }
+    std::println("one-character edit: {:.1f} us",
+                 std::chrono::duration<double, std::micro>(elapsed).count() / 2000);
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_result(Dove::Lexer &incremental, const std::string &text) {
+    Dove::Lexer fresh(text);
+    auto expected = fresh.get_token_buffer();
+    auto actual = incremental.get_token_buffer();
+    if (expected.has_value() != actual.has_value()) return false;
+    if (!expected) {
+        return fresh.get_diagnostics().format() == incremental.get_diagnostics().format();
+    }
+
+    const Dove::TokenBuffer &a = *expected.value();
+    const Dove::TokenBuffer &b = *actual.value();
+    if (a.size() != b.size() || a.get_line_starts() != b.get_line_starts()) return false;
+
+    std::vector<Dove::Token> views = a.to_tokens();
+    const std::vector<Dove::Token> &edited = *incremental.get_tokens().value();
+    for (size_t i = 0; i < a.size(); i++) {
+        // Symbol ids are only stable within one lexer, so compare what they name
+        bool same_value = Dove::TokenBuffer::has_symbol(a.kind(i))
+                              ? fresh.get_interner().name(a.value(i)) ==
+                                    incremental.get_interner().name(b.value(i))
+                          : Dove::TokenBuffer::has_integer(a.kind(i)) ? a.integer(i) == b.integer(i)
+                          : a.kind(i) == Dove::TokenType::ValueFloatingPointNumber
+                              ? a.floating(i) == b.floating(i)
+                              : a.value(i) == b.value(i);
+        if (!same_value || a.kind(i) != b.kind(i) || a.offset(i) != b.offset(i) ||
+            a.str(i).data() != b.str(i).data() || a.length(i) != b.length(i) ||
+            views[i].line != edited[i].line || views[i].column != edited[i].column) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,280 @@
+#include "dove/dove.h"
+
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Case {
+    std::string_view source;
+    std::vector<std::string_view> expected; // token spellings, in order
+};
+
+static const Case cases[] = {
+    // Operators (maximal munch)
+    {"a == b", {"a", "==", "b"}},
+    {"===", {"==", "="}},
+    {"<<=", {"<<", "="}},
+    {"a->b", {"a", "->", "b"}},
+    {"x+=-1;", {"x", "+=", "-", "1", ";"}},
+    {"dove::{std!,}", {"dove", "::", "{", "std", "!", ",", "}"}},
+    {"a&&&b", {"a", "&&", "&", "b"}},
+    {"a / b /= c", {"a", "/", "b", "/=", "c"}},
+    {"a // comment\nb", {"a", "b"}},
+    {"a /* x\n */ b", {"a", "b"}},
+    // Quotes and backslashes inside literals (`str` is the raw contents)
+    {"\"a\\\\\" b", {"a\\\\", "b"}},
+    {"\"\\\"\" '\\'' '\"'", {"\\\"", "\\'", "\""}},
+};
+
+int main() {
+    int failures = 0;
+
+    for (const auto &c : cases) {
+        Dove::Lexer lexer(c.source);
+        auto res = lexer.get_tokens();
+        if (!res) {
+            std::println("FAIL \"{}\": {}", c.source, res.error().format());
+            failures++;
+            continue;
+        }
+
+        const std::vector<Dove::Token> &tokens = *res.value();
+        bool ok = tokens.size() == c.expected.size();
+        for (size_t i = 0; ok && i < tokens.size(); i++) {
+            ok = tokens[i].str == c.expected[i];
+        }
+
+        if (!ok) {
+            std::println("FAIL \"{}\"", c.source);
+            for (auto t : tokens) std::println("  [T{:03d}] {}", static_cast<uint8_t>(t.type), t.str);
+            failures++;
+        }
+    }
+
+    // Keywords: every spelling in the table, at the end of the buffer and mid-buffer
+    struct Keyword {
+        Dove::TokenType type;
+        std::string_view spelling;
+    };
+    static const Keyword keywords[] = {
+#define KEYWORD(name, spelling) {Dove::TokenType::name, spelling},
+        DOVE_KEYWORDS(KEYWORD)
+#undef KEYWORD
+    };
+    for (const auto &kw : keywords) {
+        std::string bare(kw.spelling);
+        for (const std::string &src : {bare, bare + " padding"}) {
+            Dove::Lexer lexer(src);
+            auto res = lexer.get_tokens();
+            if (!res || res.value()->empty() || res.value()->front().type != kw.type) {
+                std::println("FAIL keyword \"{}\"", src);
+                failures++;
+            }
+        }
+    }
+
+    // Near misses stay identifiers
+    for (std::string_view src : {"lets", "Let", "i1", "i1288", "fallbac", "fallbacks", "u", "rtn_",
+                                 "_if", "f128x", "whiles", "brk2 padding"}) {
+        Dove::Lexer lexer(src);
+        auto res = lexer.get_tokens();
+        if (!res || res.value()->front().type != Dove::TokenType::ValueIdentifier) {
+            std::println("FAIL identifier \"{}\"", src);
+            failures++;
+        }
+    }
+
+    // Line/column come from the line table, including lines inside block comments
+    {
+        std::string_view src = "a\n  /* x\n y */ b\n\t\"s\" 'c'";
+        const uint32_t expected[][2] = {{1, 1}, {3, 7}, {4, 2}, {4, 6}};
+
+        Dove::Lexer lexer(src);
+        auto buffer = lexer.get_token_buffer();
+        auto tokens = lexer.get_tokens();
+        bool ok = buffer && tokens && buffer.value()->size() == 4 && tokens.value()->size() == 4;
+        for (size_t i = 0; ok && i < 4; i++) {
+            const Dove::Token &t = (*tokens.value())[i];
+            ok = t.line == expected[i][0] && t.column == expected[i][1] &&
+                 buffer.value()->line(i) == t.line && buffer.value()->column(i) == t.column;
+        }
+        if (!ok) {
+            std::println("FAIL line/column");
+            failures++;
+        }
+    }
+
+    // Identifiers and strings share one symbol id per spelling; keywords have none
+    {
+        Dove::Lexer lexer("let count = count + total; \"count\" \"\" \"\" while");
+        auto res = lexer.get_tokens();
+        const Dove::Interner &names = lexer.get_interner();
+        bool ok = res && res.value()->size() == 11 && names.size() == 3;
+        if (ok) {
+            const std::vector<Dove::Token> &t = *res.value();
+            ok = t[1].value == t[3].value && t[3].value == t[7].value &&
+                 t[1].value != t[5].value && t[8].value == t[9].value &&
+                 names.name(t[5].value) == "total" && names.name(t[8].value).empty() &&
+                 names.find("count") == t[1].value && names.find("while") == Dove::Interner::none;
+        }
+        if (!ok) {
+            std::println("FAIL interning");
+            failures++;
+        }
+    }
+
+    // Growing and rolling back the table keeps every remaining name reachable
+    {
+        Dove::Interner names;
+        std::vector<std::string> spellings;
+        for (int i = 0; i < 5000; i++) spellings.push_back("name_" + std::to_string(i * 7919));
+        for (const auto &s : spellings) names.intern(s);
+        names.truncate(1000);
+
+        bool ok = names.size() == 1000;
+        for (size_t i = 0; ok && i < spellings.size(); i++) {
+            Dove::SymbolId id = names.find(spellings[i]);
+            ok = i < 1000 ? id == i && names.name(id) == spellings[i] : id == Dove::Interner::none;
+        }
+        ok = ok && names.intern(spellings[4000]) == 1000;
+        if (!ok) {
+            std::println("FAIL interner");
+            failures++;
+        }
+    }
+
+    // Numeric literals are decoded once, with the full 128-bit range
+    {
+        struct Literal {
+            std::string_view source;
+            Dove::TokenType type;
+            Dove::u128 value;
+        };
+        const Dove::u128 max = ~Dove::u128{0};
+        const Literal literals[] = {
+            {"0", Dove::TokenType::ValueInteger, 0},
+            {"0042", Dove::TokenType::ValueInteger, 42},
+            {"18446744073709551616", Dove::TokenType::ValueInteger, Dove::u128{1} << 64},
+            {"340282366920938463463374607431768211455", Dove::TokenType::ValueInteger, max},
+            {"170141183460469231731687303715884105728", Dove::TokenType::ValueInteger,
+             Dove::u128{1} << 127},
+            {"0b1010", Dove::TokenType::PrefixBinary, 10},
+            {"0b11111111000000001", Dove::TokenType::PrefixBinary, 0x1FE01},
+            {"0o12", Dove::TokenType::PrefixOctal, 10},
+            {"0o3777777777777777777777777777777777777777777", Dove::TokenType::PrefixOctal, max},
+            {"0xA", Dove::TokenType::PrefixHexadecimal, 10},
+            {"0xdeadBEEF01", Dove::TokenType::PrefixHexadecimal, 0xdeadbeef01},
+            {"0x00ffffffffffffffffffffffffffffffff", Dove::TokenType::PrefixHexadecimal, max},
+        };
+        for (const auto &lit : literals) {
+            Dove::Lexer lexer(lit.source);
+            auto res = lexer.get_token_buffer();
+            if (!res || res.value()->size() != 1 || res.value()->kind(0) != lit.type ||
+                res.value()->integer(0) != lit.value || res.value()->str(0) != lit.source) {
+                std::println("FAIL literal \"{}\"", lit.source);
+                failures++;
+            }
+        }
+
+        Dove::Lexer floats("20.5 0.1 3.14159265358979323846 007.25");
+        auto res = floats.get_token_buffer();
+        if (!res || res.value()->size() != 4 || res.value()->floating(0) != 20.5 ||
+            res.value()->floating(1) != 0.1 || res.value()->floating(2) != 3.14159265358979323846 ||
+            res.value()->floating(3) != 7.25) {
+            std::println("FAIL floating point literals");
+            failures++;
+        }
+
+        // One past u128 max in every radix, then malformed digits
+        for (const std::string &src : {std::string("340282366920938463463374607431768211456"),
+                                       "0x1" + std::string(32, '0'), "0o4" + std::string(42, '0'),
+                                       "0b1" + std::string(128, '0'), std::string("0b102"),
+                                       std::string("0xG"), std::string("0x"), std::string("0o8"),
+                                       std::string("0b;"), std::string("0x1_0")}) {
+            Dove::Lexer lexer(src);
+            if (lexer.get_tokens()) {
+                std::println("FAIL literal \"{}\": expected an error", src);
+                failures++;
+            }
+        }
+    }
+
+    // Escapes are decoded once: strings through their symbol, characters into the value
+    {
+        Dove::Lexer lexer("\"tab\\there\\\\\" \"plain\" '\\n' 'x' \"\\e\\?\"");
+        auto res = lexer.get_tokens();
+        const Dove::Interner &names = lexer.get_interner();
+        bool ok = res && res.value()->size() == 5;
+        if (ok) {
+            const std::vector<Dove::Token> &t = *res.value();
+            ok = names.name(t[0].value) == "tab\there\\" && t[0].str == "tab\\there\\\\" &&
+                 names.name(t[1].value) == "plain" && t[2].value == '\n' && t[3].value == 'x' &&
+                 names.name(t[4].value) == "\x1B?";
+        }
+        if (!ok) {
+            std::println("FAIL escapes");
+            failures++;
+        }
+
+        for (std::string_view src : {"\"bad \\q\"", "'\\q'", "'ab'", "'a", "\"a\\\n\"", "''"}) {
+            Dove::Lexer broken(src);
+            if (broken.get_tokens()) {
+                std::println("FAIL literal \"{}\": expected an error", src);
+                failures++;
+            }
+        }
+    }
+
+    // UTF-8: XID identifiers, code point columns, and validation before anything is lexed
+    {
+        std::string_view src = "let größe = \"日本\"; // ü\nlet π = 'é' + naïve;";
+        Dove::Lexer lexer(src);
+        auto res = lexer.get_tokens();
+        const std::vector<std::string_view> spellings = {"let", "größe", "=", "日本", ";", "let",
+                                                         "π",   "=",     "é", "+",  "naïve", ";"};
+        const uint32_t columns[] = {1, 5, 11, 13, 17, 1, 5, 7, 9, 13, 15, 20};
+        bool ok = res && res.value()->size() == spellings.size();
+        for (size_t i = 0; ok && i < spellings.size(); i++) {
+            const Dove::Token &t = (*res.value())[i];
+            ok = t.str == spellings[i] && t.column == columns[i] &&
+                 lexer.get_token_buffer().value()->column(i) == columns[i];
+        }
+        ok = ok && (*res.value())[1].type == Dove::TokenType::ValueIdentifier &&
+             (*res.value())[8].value == 0xE9;
+        if (!ok) {
+            std::println("FAIL unicode");
+            failures++;
+        }
+
+        const std::string_view invalid[] = {"let a\xFF = 1;", "\"\xC3\x28\"", "a\xED\xA0\x80",
+                                            "\xF0\x9F\x98", "#\xC0\xAF", "let € = 1;"};
+        const char *messages[] = {
+            "[E1009] 1:6: Invalid UTF-8 byte (0xFF).",
+            "[E1009] 1:2: Invalid UTF-8 byte (0xC3).",
+            "[E1009] 1:2: Invalid UTF-8 byte (0xED).",
+            "[E1009] 1:1: Invalid UTF-8 byte (0xF0).",
+            "[E1009] 1:2: Invalid UTF-8 byte (0xC0).",
+            "[E1000] 1:5: Unexpected character (U+20AC).",
+        };
+        for (size_t i = 0; i < std::size(invalid); i++) {
+            Dove::Lexer broken(invalid[i]);
+            auto tokens = broken.get_tokens();
+            if (tokens || tokens.error().format() != messages[i]) {
+                std::println("FAIL invalid UTF-8 {}: {}", i,
+                             tokens ? "no error" : tokens.error().format());
+                failures++;
+            }
+        }
+    }
+
+    // Unknown bytes are reported instead of stalling the lexer
+    Dove::Lexer lexer("let a = #;");
+    if (lexer.get_tokens()) {
+        std::println("FAIL \"let a = #;\": expected an error");
+        failures++;
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
\ No newline at end of file
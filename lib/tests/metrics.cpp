@@ -0,0 +1,106 @@
+#include "dove/dove.h"
+#include "dove/utils/thread_pool.h"
+
+#include <print>
+#include <string>
+#include <utility>
+
+// Lexer metrics must account for every token and byte, and export well-formed summaries
+int main() {
+#ifndef DOVE_METRICS
+    std::println("Skipped: built without METRICS=1");
+    return 0;
+#else
+    std::string src = "func größe(a: i32) -> bool {\n"
+                      "    // hello\n"
+                      "    let s = \"x\\ty\" + 'c';\n"
+                      "    /* multi\n"
+                      "       line */ rtn a >= 0x1F && maybe;\n"
+                      "}\n";
+    int failures = 0;
+
+    Dove::Lexer lexer(src);
+    const Dove::TokenBuffer &tokens = *lexer.get_token_buffer().value();
+    const Dove::Metrics &metrics = lexer.get_metrics();
+
+    uint64_t counted = 0;
+    for (size_t kind = 0; kind < Dove::token_type_count; kind++) counted += metrics.counter(kind);
+    if (counted != tokens.size()) {
+        std::println("FAIL {} tokens counted, {} lexed", counted, tokens.size());
+        failures++;
+    }
+
+    // Every byte goes through exactly one handler (validation is a separate pass)
+    uint64_t bytes = 0;
+    for (auto name : {"identifier", "string", "character", "number", "symbol", "comment",
+                      "whitespace"}) {
+        bytes += metrics.find_section(name).value().bytes;
+    }
+    if (bytes != src.length() || metrics.find_section("validate")->bytes != src.length()) {
+        std::println("FAIL {} bytes handled of {}", bytes, src.length());
+        failures++;
+    }
+
+    // Five keywords; `maybe` is hashed and misses, the other identifiers are filtered out early
+    const std::pair<const char *, uint64_t> expected[] = {
+        {"tokens.KeywordFunc", 1},
+        {"tokens.ValueIdentifier", 5},
+        {"tokens.ValueString", 1},
+        {"tokens.ValueCharacter", 1},
+        {"tokens.PrefixHexadecimal", 1},
+        {"keyword_hits", 5},
+        {"keyword_misses", 1},
+        {"keyword_filtered", 4},
+    };
+    for (auto [name, value] : expected) {
+        if (metrics.find_counter(name) != value) {
+            std::println("FAIL {} is {}, expected {}", name, metrics.find_counter(name).value_or(0),
+                         value);
+            failures++;
+        }
+    }
+    if (metrics.find_section("comment")->calls != 2 || metrics.find_section("number")->calls != 1 ||
+        metrics.find_counter("no such counter")) {
+        std::println("FAIL section calls");
+        failures++;
+    }
+    if (metrics.find_gauge("buffer_peak_bytes").value() < tokens.memory_usage()) {
+        std::println("FAIL peak {} below {}", *metrics.find_gauge("buffer_peak_bytes"),
+                     tokens.memory_usage());
+        failures++;
+    }
+
+    std::string json = metrics.to_json();
+    if (!json.starts_with("{\"phase\": \"lexer\"") || !json.contains("\"tokens.KeywordFunc\": 1") ||
+        !json.contains("\"name\": \"lex\"")) {
+        std::println("FAIL json: {}", json);
+        failures++;
+    }
+
+    // Parallel: chunk metrics are merged, one trace event per chunk plus the whole run
+    std::string big;
+    while (big.size() < 600 * 1024) big += src;
+    Dove::ThreadPool pool(4);
+    Dove::Lexer serial(big);
+    Dove::Lexer parallel = Dove::Lexer::parallel(big, pool, 64 * 1024);
+    for (size_t kind = 0; kind < Dove::token_type_count; kind++) {
+        if (serial.get_metrics().counter(kind) != parallel.get_metrics().counter(kind)) {
+            std::println("FAIL parallel count of token kind {}", kind);
+            failures++;
+            break;
+        }
+    }
+    const Dove::Metrics *phases[] = {&parallel.get_metrics()};
+    std::string trace = Dove::Metrics::to_chrome_trace(phases);
+    size_t events = 0;
+    for (size_t at = 0; (at = trace.find("\"ph\": \"X\"", at)) != std::string::npos; at++) events++;
+    if (events != parallel.get_metrics().get_events().size() || events < 3 ||
+        !trace.starts_with("{\"traceEvents\": [") || !trace.contains("\"name\": \"lex chunk\"")) {
+        std::println("FAIL trace: {}", trace);
+        failures++;
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures != 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "dove/dove.h"
+#include "dove/utils/thread_pool.h"
+#include "example.h"
+
+#include <print>
+#include <string>
+#include <vector>
+
+bool same_result(std::string_view name, std::string_view src, Dove::ThreadPool &pool);
+
+// Parallel lexing must be indistinguishable from the serial Lexer
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string unit(*example);
+
+    std::string big;
+    while (big.size() < (1 << 20)) big += unit;
+
+    // Block comments that swallow several chunks, with code-like text inside
+    std::string commented = unit + "/*\n" + unit + "\" /* // \n" + unit + "*/\n" + unit;
+
+    Dove::ThreadPool pool(4);
+    int failures = 0;
+
+    failures += !same_result("repeated example", big, pool);
+    failures += !same_result("block comments", commented, pool);
+    failures += !same_result("unterminated comment", unit + "/*\n" + unit, pool);
+    failures += !same_result("NUL byte", unit + std::string(1, '\0') + unit, pool);
+    failures += !same_result("late error", big + "let s = \"oops\n" + unit, pool);
+    failures += !same_result("error in comment", unit + "/*\n#\n*/\n#\n" + unit, pool);
+    std::string unicode = unit + "let größe = \"日本\" + 'é'; // ü\n";
+    failures += !same_result("unicode", unicode + unit + unicode, pool);
+    failures += !same_result("invalid UTF-8", unit + "#\n" + unit + "\xC3\n" + unit, pool);
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_result(std::string_view name, std::string_view src, Dove::ThreadPool &pool) {
+    Dove::Lexer serial(src);
+    auto expected = serial.get_tokens();
+
+    // Small chunks so every case spans many of them
+    for (size_t chunk_size : {64, 1000, 4096}) {
+        Dove::Lexer parallel = Dove::Lexer::parallel(src, pool, chunk_size);
+        auto actual = parallel.get_tokens();
+
+        bool ok = expected.has_value() == actual.has_value() &&
+                  serial.get_diagnostics().format() == parallel.get_diagnostics().format();
+        if (ok && !expected) {
+            ok = expected.error().format() == actual.error().format();
+        } else if (ok) {
+            const std::vector<Dove::Token> &a = *expected.value();
+            const std::vector<Dove::Token> &b = *actual.value();
+            ok = a.size() == b.size();
+            for (size_t i = 0; ok && i < a.size(); i++) {
+                ok = a[i].type == b[i].type && a[i].value == b[i].value &&
+                     a[i].str.data() == b[i].str.data() &&
+                     a[i].str.size() == b[i].str.size() && a[i].line == b[i].line &&
+                     a[i].column == b[i].column;
+            }
+        }
+
+        if (!ok) {
+            std::println("FAIL {} (chunk size {})", name, chunk_size);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,186 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <print>
+#include <string>
+#include <string_view>
+
+bool parses_to(std::string_view src, std::string_view expected);
+
+int main() {
+    int failures = 0;
+
+    // The examples parse without errors, into at most one node per token
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    const std::string readme = "use dove::{std!, rand, rng, fmt};\n"
+                               "obj Counter {\n"
+                               "  let value: u8;\n"
+                               "  const max: u8 = 100;\n"
+                               "  func increment() -> bool {\n"
+                               "    if value < max {\n"
+                               "      value += 1;\n"
+                               "      true\n"
+                               "    } else { false }\n"
+                               "  }\n"
+                               "}\n"
+                               "func main() {\n"
+                               "  let counter: Counter = { value = 0 };\n"
+                               "  for _ in rng::range(0, 100) {\n"
+                               "    const action: bool = rand::rand_bool();\n"
+                               "    match action {\n"
+                               "      is true: counter.increment();\n"
+                               "      is false: counter.decrement();\n"
+                               "    }\n"
+                               "    println(\"Counter is {}\", counter.value);\n"
+                               "  }\n"
+                               "}\n"
+                               "func create_msg(name: const &[ch, ~]) -> [ch, ~] {\n"
+                               "  fmt::format(\"Hello! This is the {} Programming Language\",\n"
+                               "              name)\n"
+                               "}\n";
+    for (std::string_view src : {*example, std::string_view(readme)}) {
+        Dove::Lexer lexer(src);
+        const Dove::TokenBuffer &tokens = *lexer.get_token_buffer().value();
+        Dove::Parser parser(tokens);
+        auto ast = parser.get_ast();
+        if (!ast || ast.value()->size() > tokens.size() + 1 ||
+            ast.value()->list((*ast.value())[Dove::Ast::root].lhs).size() < 4) {
+            std::println("FAIL example:\n{}", parser.get_diagnostics().format());
+            failures++;
+        }
+    }
+
+    // Precedence and associativity
+    failures += !parses_to("let x = a = b += -c.d(e)[f] * 2 + 3 << 1 < 4 == true || g && h;",
+                           "Module\n"
+                           "  Let x\n"
+                           "    Assign =\n"
+                           "      Identifier a\n"
+                           "      Assign +=\n"
+                           "        Identifier b\n"
+                           "        Binary ||\n"
+                           "          Binary ==\n"
+                           "            Binary <\n"
+                           "              Binary <<\n"
+                           "                Binary +\n"
+                           "                  Binary *\n"
+                           "                    Unary -\n"
+                           "                      Index\n"
+                           "                        Call\n"
+                           "                          Member d\n"
+                           "                            Identifier c\n"
+                           "                          Identifier e\n"
+                           "                        Identifier f\n"
+                           "                    Integer 2\n"
+                           "                  Integer 3\n"
+                           "                Integer 1\n"
+                           "              Integer 4\n"
+                           "            Bool true\n"
+                           "          Binary &&\n"
+                           "            Identifier g\n"
+                           "            Identifier h\n");
+    failures += !parses_to("const y = (1 - 2) - 3 | 4 & 5 / *p % 6;",
+                           "Module\n"
+                           "  Const y\n"
+                           "    Binary |\n"
+                           "      Binary -\n"
+                           "        Binary -\n"
+                           "          Integer 1\n"
+                           "          Integer 2\n"
+                           "        Integer 3\n"
+                           "      Binary &\n"
+                           "        Integer 4\n"
+                           "        Binary %\n"
+                           "          Binary /\n"
+                           "            Integer 5\n"
+                           "            Unary *\n"
+                           "              Identifier p\n"
+                           "          Integer 6\n");
+    // Block-like statements need no `;`, and the last expression is the block's value
+    failures += !parses_to("func f() { if a { b } elif c { d } else { e } loop l { brk l; } "
+                           "while x {} -1 }",
+                           "Module\n"
+                           "  Func f\n"
+                           "    Block\n"
+                           "      If\n"
+                           "        Identifier a\n"
+                           "        Block\n"
+                           "          Identifier b\n"
+                           "        If\n"
+                           "          Identifier c\n"
+                           "          Block\n"
+                           "            Identifier d\n"
+                           "          Block\n"
+                           "            Identifier e\n"
+                           "      Loop l\n"
+                           "        Block\n"
+                           "          Brk\n"
+                           "            Identifier l\n"
+                           "      While\n"
+                           "        Identifier x\n"
+                           "        Block\n"
+                           "      Unary -\n"
+                           "        Integer 1\n");
+
+    // Every error in one pass; the parser resumes at the next statement or item
+    const std::string broken = "func a() {\n"
+                               "    let x = ;\n"
+                               "    let y: = 1;\n"
+                               "    x + 1 = 2;\n"
+                               "    foo(1 2);\n"
+                               "    rtn x\n"
+                               "}\n"
+                               "obj B { rtn; let z: u8; }\n"
+                               "}\n"
+                               "func c() -> i32 { 0 }\n"
+                               "func d(";
+    const std::string_view expected[] = {
+        "[E2001] 2:13: Expected an expression but found ';'.",
+        "[E2002] 3:12: Expected a type but found '='.",
+        "[E2004] 4:11: Only variables, members, elements and dereferences can be assigned to.",
+        "[E2000] 5:11: Expected ')' but found an integer.",
+        "[E2003] 8:9: Expected a field or method but found 'rtn'.",
+        "[E2003] 9:1: Expected 'use', 'obj', 'func', 'let' or 'const' but found '}'.",
+        "[E2000] 11:8: Expected an identifier but found the end of the file.",
+    };
+    Dove::Lexer lexer(broken);
+    Dove::Parser parser(*lexer.get_token_buffer().value());
+    const Dove::Diagnostics &diagnostics = parser.get_diagnostics();
+    bool ok = diagnostics.size() == std::size(expected) && !parser.get_ast();
+    for (size_t i = 0; ok && i < diagnostics.size(); i++) {
+        ok = diagnostics[i].format() == expected[i];
+    }
+    Dove::Ast ast = parser.take_ast();
+    ok = ok && ast.dump() == "Module\n"
+                             "  Func a\n"
+                             "    Block\n"
+                             "      Rtn\n"
+                             "        Identifier x\n"
+                             "  Obj B\n"
+                             "    Let z\n"
+                             "      TypeName u8\n"
+                             "  Func c\n"
+                             "    TypeName i32\n"
+                             "    Block\n"
+                             "      Integer 0\n";
+    if (!ok) {
+        std::println("FAIL errors:\n{}{}", diagnostics.format(), ast.dump());
+        failures++;
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool parses_to(std::string_view src, std::string_view expected) {
+    Dove::Lexer lexer(src);
+    Dove::Parser parser(*lexer.get_token_buffer().value());
+    Dove::Ast ast = parser.take_ast();
+    if (!parser.get_diagnostics().empty() || ast.dump() != expected) {
+        std::println("FAIL {}:\n{}{}", src, parser.get_diagnostics().format(), ast.dump());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#include "dove/dove.h"
+#include "dove/utils/thread_pool.h"
+#include "example.h"
+
+#include <print>
+#include <string>
+
+bool same_result(std::string_view name, std::string_view src, Dove::ThreadPool &pool);
+
+// Parsing items in parallel must give the serial Parser's tree and errors
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string unit(*example);
+
+    std::string big;
+    while (big.size() < (1 << 18)) big += unit;
+
+    const std::string broken = "func a() {\n"
+                               "    let x = ;\n"
+                               "    foo(1 2);\n"
+                               "}\n"
+                               "obj B { rtn; let z: u8; }\n"
+                               "}\n";
+    // `const` only starts an item after a `;` or `}`
+    const std::string qualified = "let a: const &u8 = b;\n"
+                                  "const c: [const u8, 4] = d;\n"
+                                  "func e(f: const &u8) -> const u8 { *f }\n";
+
+    Dove::ThreadPool pool(4);
+    int failures = 0;
+
+    failures += !same_result("repeated example", big, pool);
+    failures += !same_result("type qualifiers", qualified + unit + qualified + qualified, pool);
+    failures += !same_result("errors", unit + broken + unit + broken + unit, pool);
+    failures += !same_result("stray braces", unit + "}}\n" + unit + ") ]\n" + unit, pool);
+    failures += !same_result("unclosed item", unit + "func x( {\n" + unit, pool);
+    failures += !same_result("no items", "1 + 2; 3;", pool);
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_result(std::string_view name, std::string_view src, Dove::ThreadPool &pool) {
+    Dove::Lexer lexer(src);
+    const Dove::TokenBuffer &tokens = *lexer.get_token_buffer().value();
+    Dove::Parser serial(tokens);
+    Dove::Ast expected = serial.take_ast();
+
+    // Small pieces so every case is split many times
+    for (size_t chunk_tokens : {1, 100, 5000}) {
+        Dove::Parser parallel = Dove::Parser::parallel(tokens, pool, chunk_tokens);
+        Dove::Ast actual = parallel.take_ast();
+
+        bool ok = serial.get_diagnostics().format() == parallel.get_diagnostics().format() &&
+                  expected.size() == actual.size() && expected.dump() == actual.dump();
+        for (Dove::NodeId id = 0; ok && id < expected.size(); id++) {
+            const Dove::Node &a = expected[id];
+            const Dove::Node &b = actual[id];
+            ok = a.kind == b.kind && a.flags == b.flags && a.op == b.op && a.token == b.token &&
+                 a.lhs == b.lhs && a.rhs == b.rhs;
+        }
+
+        if (!ok) {
+            std::println("FAIL {} (chunk tokens {}):\n{}{}", name, chunk_tokens,
+                         parallel.get_diagnostics().format(), serial.get_diagnostics().format());
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,106 @@
+#include "dove/dove.h"
+#include "dove/utils/spsc_ring.h"
+#include "example.h"
+
+#include <chrono>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+bool same_tokens(const std::string &src, size_t blocks, bool slow);
+
+// The pipelined lexer must hand over exactly what the Lexer produces, in order
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string unit(*example);
+    unit += "let größe = \"日本\\n\" + 'é'; /* ü */ 0x1F 2.5 0b101 1e3\n";
+    std::string big;
+    while (big.size() < (1 << 20)) big += unit;
+
+    int failures = 0;
+
+    // The ring itself: every value arrives once and in order, through a tiny ring
+    Dove::SpscRing<uint64_t> ring(4);
+    constexpr uint64_t values = 1 << 20;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < values; i++) {
+            *ring.claim() = i;
+            ring.publish();
+        }
+        ring.close();
+    });
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (const uint64_t *value = ring.front()) {
+        in_order = in_order && *value == expected++;
+        ring.pop();
+    }
+    producer.join();
+    if (!in_order || expected != values || ring.capacity() != 4) {
+        std::println("FAIL ring ({} of {} values)", expected, values);
+        failures++;
+    }
+
+    failures += !same_tokens("", 16, false);
+    failures += !same_tokens(unit, 16, false);
+    failures += !same_tokens(big, 16, false);
+    // A one-block ring and a consumer slower than the lexer: backpressure on every block
+    failures += !same_tokens(unit + unit + unit, 1, true);
+
+    // Errors stop the pipeline after the tokens before them
+    Dove::TokenPipeline broken("let s = \"unterminated\nlet x");
+    size_t count = 0;
+    while (const Dove::TokenBlock *block = broken.next_block()) count += block->size();
+    if (count != 3 || !broken.get_error()) {
+        std::println("FAIL error propagation");
+        failures++;
+    }
+
+    // A consumer that stops early does not leave the lexer waiting forever
+    {
+        Dove::TokenPipeline abandoned(big, 2);
+        abandoned.next_block();
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_tokens(const std::string &src, size_t blocks, bool slow) {
+    Dove::Lexer lexer(src);
+    const Dove::TokenBuffer &expected = *lexer.get_token_buffer().value();
+    std::vector<Dove::Token> views = expected.to_tokens();
+
+    Dove::TokenPipeline pipeline(src, blocks);
+    size_t idx = 0;
+    bool ok = true;
+    while (const Dove::TokenBlock *block = pipeline.next_block()) {
+        if (slow) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        for (size_t i = 0; ok && i < block->size(); i++, idx++) {
+            const Dove::Token &token = (*block)[i];
+            ok = idx < views.size() && token.type == views[idx].type &&
+                 token.str.data() == views[idx].str.data() &&
+                 token.str.size() == views[idx].str.size() && token.line == views[idx].line &&
+                 token.column == views[idx].column;
+            if (ok && Dove::TokenBuffer::has_symbol(token.type)) {
+                ok = token.value == views[idx].value &&
+                     block->name(i) == lexer.get_interner().name(views[idx].value);
+            } else if (ok && Dove::TokenBuffer::has_integer(token.type)) {
+                ok = block->integer(token) == expected.integer(idx);
+            } else if (ok && token.type == Dove::TokenType::ValueFloatingPointNumber) {
+                ok = block->floating(token) == expected.floating(idx);
+            } else if (ok) {
+                ok = token.value == views[idx].value;
+            }
+        }
+    }
+    ok = ok && idx == views.size() && !pipeline.get_error() &&
+         pipeline.get_interner().size() == lexer.get_interner().size();
+    if (!ok) {
+        std::println("FAIL {} bytes through {} block(s), token {}", src.size(), blocks, idx);
+    }
+    return ok;
+}
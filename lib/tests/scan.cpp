@@ -0,0 +1,48 @@
+#include "dove/dove.h"
+#include "dove/utils/scan.h"
+
+#include <print>
+#include <random>
+#include <string>
+
+using Dove::Scan;
+
+// Every kernel must stop at exactly the same byte as the scalar fallback.
+int main() {
+    const Scan::Isa kernels[] = {Scan::Isa::Scalar, Scan::Isa::SSE42, Scan::Isa::AVX2};
+    const char alphabet[] = " \t\r\n_azAZ09!.\"'\\/*\0\x80\xff";
+
+    std::mt19937 rng(42);
+    std::string src;
+    for (int i = 0; i < 20000; i++) {
+        // Long runs of a single class with the odd break so every block size is crossed
+        char ch = alphabet[rng() % (sizeof(alphabet) - 1)];
+        src.append(rng() % 70, rng() % 8 == 0 ? alphabet[rng() % (sizeof(alphabet) - 1)] : ch);
+    }
+
+    const char *begin = src.data();
+    const char *end = src.data() + src.size();
+
+    for (auto isa : kernels) {
+        if (!Scan::select(isa)) {
+            std::println("kernel {} not supported, skipping", static_cast<int>(isa));
+            continue;
+        }
+        for (const char *it = begin; it < end; it++) {
+            const char *ws = Scan::whitespace(it, end);
+            const char *id = Scan::identifier(it, end);
+            const char *dg = Scan::digits(it, end);
+            const char *qt = Scan::quoted(it, end, '"');
+
+            Scan::select(Scan::Isa::Scalar);
+            if (ws != Scan::whitespace(it, end) || id != Scan::identifier(it, end) ||
+                dg != Scan::digits(it, end) || qt != Scan::quoted(it, end, '"')) {
+                std::println("kernel {} mismatch at offset {}", static_cast<int>(isa), it - begin);
+                return 1;
+            }
+            Scan::select(isa);
+        }
+        std::println("kernel {} ok", static_cast<int>(isa));
+    }
+    return 0;
+}
\ No newline at end of file
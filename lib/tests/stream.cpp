@@ -0,0 +1,126 @@
+#include "dove/dove.h"
+#include "example.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <print>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+bool same_tokens(const Dove::TokenBuffer &expected, Dove::TokenStream &stream);
+
+// Streams must produce exactly what the batch Lexer produces, whatever the chunking
+int main() {
+    Dove::SourceManager sources;
+    auto example = Test::load_example(sources);
+    if (!example) return 1;
+    std::string src(*example);
+    // Long comments, strings and identifiers that straddle many chunks
+    src += "\n/* " + std::string(3000, '*') + " multi\nline **/ " + std::string(5000, 'x') +
+           " \"" + std::string(2000, 's') + "\" 0x" + std::string(32, 'f') + " 0b" +
+           std::string(100, '1') + " 3.25 \"q\\\"\\\\\" '\\n'\n" +
+           "let größe = \"日本\" + 'é'; // ü 😀\nlet 𝑥 = naïve; // tail";
+
+    Dove::Lexer lexer(src);
+    auto res = lexer.get_token_buffer();
+    if (!res) {
+        std::println("{}", res.error().format());
+        return 1;
+    }
+    const Dove::TokenBuffer &expected = *res.value();
+    int failures = 0;
+
+    // In-memory
+    Dove::TokenStream memory = Dove::Lexer::stream(src);
+    if (!same_tokens(expected, memory)) {
+        std::println("FAIL in-memory stream");
+        failures++;
+    }
+
+    // Callback reader, including pathological 1-byte chunks
+    for (size_t chunk : {1, 2, 3, 7, 64, 4096}) {
+        size_t pos = 0;
+        Dove::TokenStream chunked(
+            [&](char *buffer, size_t capacity) {
+                size_t n = std::min({capacity, chunk, src.size() - pos});
+                std::memcpy(buffer, src.data() + pos, n);
+                pos += n;
+                return n;
+            },
+            chunk);
+        if (!same_tokens(expected, chunked)) {
+            std::println("FAIL chunk size {}", chunk);
+            failures++;
+        }
+    }
+
+    // File descriptor
+    int fd = open(sources.get_path(0).c_str(), O_RDONLY);
+    Dove::Lexer file_lexer(*example);
+    Dove::TokenStream from_fd(Dove::TokenStream::from_fd(fd), 256);
+    if (fd < 0 || !same_tokens(*file_lexer.get_token_buffer().value(), from_fd)) {
+        std::println("FAIL file descriptor");
+        failures++;
+    }
+    close(fd);
+
+    // Errors surface through next_token() and stop iteration
+    Dove::TokenStream broken = Dove::Lexer::stream("let s = \"unterminated\nlet x");
+    size_t count = 0;
+    for ([[maybe_unused]] const Dove::Token &t : broken) count++;
+    if (count != 3 || !broken.get_error()) {
+        std::println("FAIL error propagation");
+        failures++;
+    }
+
+    // Invalid UTF-8 is reported even when it arrives in pieces
+    for (size_t chunk : {1, 3, 64}) {
+        std::string bad = "let a = 1;\nlet \xE2\x82 = 2;";
+        size_t pos = 0;
+        Dove::TokenStream chunked(
+            [&](char *buffer, size_t capacity) {
+                size_t n = std::min({capacity, chunk, bad.size() - pos});
+                std::memcpy(buffer, bad.data() + pos, n);
+                pos += n;
+                return n;
+            },
+            chunk);
+        for ([[maybe_unused]] const Dove::Token &t : chunked) {
+        }
+        if (!chunked.get_error() ||
+            chunked.get_error()->format() != "[E1009] 2:5: Invalid UTF-8 byte (0xE2).") {
+            std::println("FAIL invalid UTF-8 (chunk size {})", chunk);
+            failures++;
+        }
+    }
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+bool same_tokens(const Dove::TokenBuffer &expected, Dove::TokenStream &stream) {
+    size_t i = 0;
+    for (const Dove::Token &t : stream) {
+        bool ok = i < expected.size();
+        if (ok) {
+            Dove::Token e = expected.token(i);
+            ok = t.type == e.type && t.str == e.str && t.line == e.line && t.column == e.column;
+            // Literal indices are per stream token; every other value matches the Lexer's
+            if (ok && Dove::TokenBuffer::has_integer(t.type)) {
+                ok = stream.get_integer(t) == expected.integer(i);
+            } else if (ok && t.type == Dove::TokenType::ValueFloatingPointNumber) {
+                ok = stream.get_float(t) == expected.floating(i);
+            } else if (ok) {
+                ok = t.value == e.value;
+            }
+        }
+        if (!ok) {
+            std::println("  mismatch at token {}: {} {}:{}", i, t.str, t.line, t.column);
+            return false;
+        }
+        i++;
+    }
+    return i == expected.size() && !stream.get_error();
+}
@@ -0,0 +1,294 @@
+#include "dove/dove.h"
+
+#include <print>
+#include <string>
+#include <string_view>
+
+std::string run(std::string_view src);
+std::string dump(std::string_view src);
+bool check(std::string_view name, std::string_view src, std::string_view expected);
+
+// Programs compiled to bytecode and run: what they print and return, or their first error
+int main() {
+    int failures = 0;
+
+    // The README example, with `fmt` left out
+    failures += !check("counter",
+                       "obj Counter {\n"
+                       "  let value: u8;\n"
+                       "  const max: u8 = 3;\n"
+                       "  func increment() -> bool {\n"
+                       "    if value < max { value += 1; true } else { false }\n"
+                       "  }\n"
+                       "}\n"
+                       "func main() -> u8 {\n"
+                       "  let counter: Counter = { value = 0 };\n"
+                       "  for _ in rng::range(0, 5) {\n"
+                       "    match counter.increment() {\n"
+                       "      is true: println(\"Counter is {}\", counter.value);\n"
+                       "      is false: println(\"Counter is at its max\");\n"
+                       "    }\n"
+                       "  }\n"
+                       "  counter.value\n"
+                       "}\n",
+                       "Counter is 1\nCounter is 2\nCounter is 3\nCounter is at its max\n"
+                       "Counter is at its max\n=> 3");
+    failures += !check("recursion",
+                       "func fib(n: i64) -> i64 { if n < 2 { rtn n; } fib(n - 1) + fib(n - 2) }\n"
+                       "func main() -> i64 { fib(20) }",
+                       "=> 6765");
+    failures += !check("loops",
+                       "func main() -> i32 {\n"
+                       "  let i: i32 = 0;\n"
+                       "  let j = loop { i += 1; if i == 5 { brk i * 2; } };\n"
+                       "  loop outer { loop { brk outer; } }\n"
+                       "  while i < 100 { i += 7; if i > 40 { brk; } }\n"
+                       "  i + j\n"
+                       "}",
+                       "=> 57");
+    failures += !check("wrapping",
+                       "func main() -> i64 {\n"
+                       "  let w: u8 = 250; w += 10;\n"
+                       "  let s: i8 = -128;\n"
+                       "  let n: i64 = -9223372036854775808;\n"
+                       "  println(\"{} {} {} {}\", w, -s, s / -1, n % -1);\n"
+                       "  n / -1\n"
+                       "}",
+                       "4 -128 -128 0\n=> -9223372036854775808");
+    failures += !check("128 bits",
+                       "const min: i128 = -170141183460469231731687303715884105728;\n"
+                       "func main() {\n"
+                       "  let u: u128 = 340282366920938463463374607431768211455;\n"
+                       "  println(\"{} {} {}\", min, min + 1, u);\n"
+                       "  if u > 18446744073709551616 { println(\"wide\"); }\n"
+                       "}",
+                       "-170141183460469231731687303715884105728 "
+                       "-170141183460469231731687303715884105727 "
+                       "340282366920938463463374607431768211455\nwide\n=> 0");
+    failures += !check("floats",
+                       "func main() {\n"
+                       "  let nan: f64 = 0.0 / 0.0;\n"
+                       "  if nan < 1.0 { println(\"lt\"); }\n"
+                       "  if !(nan < 1.0) { println(\"not lt\"); }\n"
+                       "  if nan >= 1.0 { println(\"ge\"); }\n"
+                       "  println(\"{}\", 0.5 + 0.25);\n"
+                       "}",
+                       "not lt\n0.75\n=> 0");
+    failures += !check("objects are values",
+                       "obj Inner { let x: i32 = 7; }\n"
+                       "obj Outer { let inner: Inner; let y: f64 = 1.5; }\n"
+                       "func main() {\n"
+                       "  let a: Outer = { y = 2.5 };\n"
+                       "  let b: Outer = a;\n"
+                       "  b.inner.x = 9;\n"
+                       "  println(\"{} {} {} {}\", a.inner.x, b.inner.x, a.y, b.y);\n"
+                       "}",
+                       "7 9 2.5 2.5\n=> 0");
+    failures += !check("match",
+                       "func name(n: u8) -> ch {\n"
+                       "  match n { is 1: 'a'; is < 5: 'b'; fallback: 'c'; }\n"
+                       "}\n"
+                       "func main() { println(\"{}{}{}\", name(1), name(3), name(9)); }",
+                       "abc\n=> 0");
+    failures += !check("globals and shadowing",
+                       "let total = 0;\n"
+                       "func main() -> i32 {\n"
+                       "  let x = 5; let x = x + 1;\n"
+                       "  for i in rng::range(x, 9) { total += i; }\n"
+                       "  total\n"
+                       "}",
+                       "=> 21");
+
+    failures += !check("counted loops",
+                       "func main() {\n"
+                       "  for i in rng::range(5, 3) { println(\"never\"); }\n"
+                       "  let n: u8 = 255;\n"
+                       "  for i in rng::range(253, n) { print(\"{} \", i); }\n"
+                       "  let m: i128 = 3;\n"
+                       "  for j in rng::range(-1, m) { if j == 1 { brk; } print(\"{} \", j); }\n"
+                       "  let r = rng::range(0, 2);\n"
+                       "  for k in r { print(\"{} \", k); }\n"
+                       "}",
+                       "253 254 -1 0 0 1 => 0");
+    // Only an iterator that is not a `for`'s own range is allocated
+    std::string counted = dump("func main() { for _ in rng::range(0, 100) { println(\"\"); } }");
+    if (counted.find("ForLoopI64") == std::string::npos ||
+        counted.find("Range") != std::string::npos) {
+        std::println("FAIL counted loop dump:\n{}", counted);
+        failures++;
+    }
+
+    failures += !check("match lowering",
+                       "func dense(n: u8) -> i32 {\n"
+                       "  match n {\n"
+                       "    is 1: 10; is 2: 20; is 3: 30; is 2: 99; is 5: 50; fallback: -1;\n"
+                       "  }\n"
+                       "}\n"
+                       "func sparse(n: i64) -> i32 {\n"
+                       "  match n {\n"
+                       "    is -1000: 1; is 7: 2; is 300: 3; is 9000: 4; is 123456: 5;\n"
+                       "    fallback: 0;\n"
+                       "  }\n"
+                       "}\n"
+                       "func letter(c: ch) -> ch {\n"
+                       "  match c {\n"
+                       "    is 'a': 'A'; is 'b': 'B'; is 'c': 'C'; is 'e': 'E'; fallback: '?';\n"
+                       "  }\n"
+                       "}\n"
+                       "func main() {\n"
+                       "  print(\"{} {} {} {} \", dense(0), dense(2), dense(4), dense(5));\n"
+                       "  print(\"{} {} {} \", sparse(-1000), sparse(123456), sparse(8));\n"
+                       "  println(\"{}{}{}\", letter('a'), letter('d'), letter('e'));\n"
+                       "}",
+                       "-1 20 -1 50 1 5 0 A?E\n=> 0");
+    // A jump table over u64 cases past 2^63, and one over i64 cases around zero
+    failures += !check("match large cases",
+                       "func high(n: u64) -> i32 {\n"
+                       "  match n {\n"
+                       "    is 18446744073709551610: 0; is 18446744073709551611: 1;\n"
+                       "    is 18446744073709551612: 2; is 18446744073709551613: 3;\n"
+                       "    fallback: -1;\n"
+                       "  }\n"
+                       "}\n"
+                       "func around(n: i64) -> i32 {\n"
+                       "  match n { is -2: 0; is -1: 1; is 0: 2; is 1: 3; fallback: -1; }\n"
+                       "}\n"
+                       "func main() {\n"
+                       "  let top: u64 = 18446744073709551615;\n"
+                       "  let low: u64 = 18446744073709551610;\n"
+                       "  print(\"{} {} {} \", high(low), high(low + 3), high(low + 2));\n"
+                       "  print(\"{} {} {} \", high(top), high(low - 1), high(0));\n"
+                       "  println(\"{} {} {}\", around(-2), around(1), around(-3));\n"
+                       "}",
+                       "0 3 2 -1 -1 -1 0 3 -1\n=> 0");
+    // The strategy of each match is noted in the dump
+    std::string lowered =
+        dump("func f(n: u8) -> u8 {\n"
+             "  match n { is 1: 1; is 2: 2; is 3: 3; is 4: 4; fallback: 0; }\n"
+             "}\n"
+             "func g(n: u64) -> u8 {\n"
+             "  match n { is 1: 1; is 90: 2; is 800: 3; is 7000: 4; fallback: 0; }\n"
+             "}\n"
+             "func main() { match f(1) == g(2) { is true: f(3); is false: g(4); } }");
+    for (std::string_view note : {"jump table", "decision tree", "bool branch"}) {
+        if (lowered.find(note) == std::string::npos) {
+            std::println("FAIL match dump has no {}:\n{}", note, lowered);
+            failures++;
+        }
+    }
+
+    failures += !check("constants",
+                       "const a = 10;\n"
+                       "const b = a * a + 1;\n"
+                       "const min: i128 = -170141183460469231731687303715884105727 - 1;\n"
+                       "const half = 1.0 / 4.0 * 2.0;\n"
+                       "obj O { const x: u8 = 3; const y: u8 = x << 1 | 1; }\n"
+                       "func main() -> i32 {\n"
+                       "  const c: i64 = 7 * 3;\n"
+                       "  const c = c + 1;\n"
+                       "  if b > 100 && !(half < 0.5) {\n"
+                       "    println(\"{} {} {} {} {}\", b, min, half, O::y, c);\n"
+                       "  }\n"
+                       "  match O::y { is 7: b - a; fallback: 0; }\n"
+                       "}",
+                       "101 -170141183460469231731687303715884105728 0.5 7 22\n=> 91");
+    failures += !check("forward constants",
+                       "const a = b + 1;\n"
+                       "const b = 2;\n"
+                       "obj O { const x = O::y * 2; const y = a; }\n"
+                       "func main() -> i32 { a * 10 + O::x }",
+                       "=> 36");
+    // Each constant is folded once, when it is first named, however long the chain
+    std::string reversed = "func main() -> i32 { c0 }\n";
+    for (int idx = 0; idx < 1000; idx++) {
+        reversed += std::format("const c{} = c{} + 1;\n", idx, idx + 1);
+    }
+    failures += !check("reversed constants", reversed + "const c1000 = 0;", "=> 1000");
+    // Expressions that do not fold, however long, compile in linear time
+    std::string chain = "func main() -> i32 {\n  let x = 1;\n  println(\"{}\", x";
+    for (int idx = 0; idx < 1000; idx++) chain += " + 1";
+    chain += ");\n  1";
+    for (int idx = 0; idx < 1000; idx++) chain += " + 1";
+    failures += !check("long chains", chain + " + x\n}", "1001\n=> 1002");
+    // A constant is an immediate where it is used, and neither stored nor loaded
+    std::string folded = dump("obj Counter {\n"
+                              "  let value: u8;\n"
+                              "  const max: u8 = 100;\n"
+                              "  func increment() { if value < max { value += 1; } }\n"
+                              "}\n"
+                              "func main() { let counter: Counter; counter.increment(); }");
+    if (folded.find("JumpGeImmU64") == std::string::npos ||
+        folded.find("Global") != std::string::npos) {
+        std::println("FAIL constant dump:\n{}", folded);
+        failures++;
+    }
+
+    // Errors
+    failures += !check("division by zero", "func main() -> i32 { let a: i32 = 0; 10 / a }",
+                       "[E4000] 1:41: Division by zero.");
+    failures += !check("stack overflow",
+                       "func f(n: i64) -> i64 { f(n + 1) }\nfunc main() -> i64 { f(0) }",
+                       "[E4001] 1:26: Stack overflow.");
+    failures += !check("out of range", "func main() { let x: i8 = -129; }",
+                       "[E3004] 1:28: The value does not fit in 'i8'.");
+    failures += !check("constant overflow", "const x: u8 = 200;\nconst y: u8 = x + x;",
+                       "[E3004] 2:17: The value does not fit in 'u8'.");
+    failures += !check("constant overflow 128",
+                       "const x: u128 = 340282366920938463463374607431768211455;\n"
+                       "func main() { println(\"{}\", x * 2 - x); }",
+                       "[E3004] 2:31: The value does not fit in 'u128'.");
+    failures += !check("constant cycle",
+                       "const a = b + 1;\nobj O { const x = a; }\nconst b = O::x;\nfunc main() {}",
+                       "[E3000] 2:19: Nothing with this name is in scope.");
+    failures += !check("forward global", "let a: i32 = b;\nlet b: i32 = 2;\nfunc main() {}",
+                       "[E3000] 1:14: Nothing with this name is in scope.");
+    failures += !check("mismatch", "func main() { let x: i32 = 1; x = 1.5; }",
+                       "[E3001] 1:35: Expected 'i32' but found 'f64'.");
+    failures += !check("no main", "func foo() {}",
+                       "[E3006] 1:1: There is no 'main' function without parameters.");
+    failures += !check("no fallback", "func main() -> i32 { let x = 1; match x { is 1: 2; } }",
+                       "[E3005] 1:33: A match whose value is used needs a 'fallback' arm.");
+    failures += !check("constant", "func main() { const x = 1; x = 2; }",
+                       "[E3002] 1:28: Constants cannot be assigned to.");
+    failures += !check("recursive objects",
+                       "obj A { let b: B; }\nobj B { let a: A; }\nfunc main() { let a: A; }",
+                       "[E3007] 2:16: This is not supported by the bytecode compiler yet.");
+
+    std::println("{} failure(s)", failures);
+    return failures ? 1 : 0;
+}
+
+std::string run(std::string_view src) {
+    Dove::Lexer lexer(src);
+    Dove::Parser parser(*lexer.get_token_buffer().value());
+    if (!parser.get_diagnostics().empty()) return parser.get_diagnostics().format();
+    Dove::Ast ast = parser.take_ast();
+
+    Dove::Compiler compiler(ast, lexer.get_interner());
+    auto program = compiler.get_program();
+    if (!program) return program.error().format();
+
+    std::string output;
+    Dove::Vm vm;
+    vm.set_output(&output);
+    auto result = vm.run(**program);
+    if (!result) return result.error().format();
+    return output + std::format("=> {}", result->i);
+}
+
+std::string dump(std::string_view src) {
+    Dove::Lexer lexer(src);
+    Dove::Parser parser(*lexer.get_token_buffer().value());
+    Dove::Ast ast = parser.take_ast();
+    Dove::Compiler compiler(ast, lexer.get_interner());
+    return compiler.get_program().value()->dump();
+}
+
+bool check(std::string_view name, std::string_view src, std::string_view expected) {
+    std::string actual = run(src);
+    if (actual != expected) {
+        std::println("FAIL {}:\n{}\nexpected:\n{}", name, actual, expected);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
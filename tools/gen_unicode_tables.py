@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Generate lib/include/dove/utils/unicode_tables.h (XID_Start / XID_Continue lookup tables).
+
+The properties come from Python's unicodedata: str.isidentifier() is defined in terms of
+XID_Start and XID_Continue. Run from the repository root:
+
+    python3 tools/gen_unicode_tables.py > lib/include/dove/utils/unicode_tables.h
+"""
+
+import unicodedata
+
+BLOCK_BITS = 8
+BLOCK = 1 << BLOCK_BITS
+
+
+def main():
+    start = []
+    cont = []
+    limit = 0
+    for cp in range(0x110000):
+        ch = chr(cp)
+        is_start = ch != "_" and ch.isidentifier()
+        is_cont = ("a" + ch).isidentifier()
+        start.append(is_start)
+        cont.append(is_cont)
+        if is_start or is_cont:
+            limit = cp + 1
+
+    # Two-level table: code point >> BLOCK_BITS picks a block, blocks are deduplicated
+    limit = (limit + BLOCK - 1) // BLOCK * BLOCK
+    index = []
+    blocks = {}
+    for base in range(0, limit, BLOCK):
+        words = []
+        for prop in (start, cont):
+            for w in range(BLOCK // 64):
+                word = 0
+                for bit in range(64):
+                    if prop[base + w * 64 + bit]:
+                        word |= 1 << bit
+                words.append(word)
+        index.append(blocks.setdefault(tuple(words), len(blocks)))
+    assert len(blocks) <= 256
+
+    out = []
+    out.append("#pragma once")
+    out.append("")
+    out.append(f"// Generated by tools/gen_unicode_tables.py (Unicode {unicodedata.unidata_version}). "
+               "Do not edit.")
+    out.append("")
+    out.append("#include <cstdint>")
+    out.append("")
+    out.append("namespace Dove {")
+    out.append("")
+    out.append(f"inline constexpr uint32_t xid_block_bits = {BLOCK_BITS};")
+    out.append(f"inline constexpr uint32_t xid_limit = 0x{limit:X};")
+    out.append("")
+    out.append("// Block of every 256 code points below xid_limit")
+    out.append(f"inline constexpr uint8_t xid_index[{len(index)}] = {{")
+    for i in range(0, len(index), 24):
+        out.append("    " + ", ".join(str(v) for v in index[i:i + 24]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("// Per block: 4 words of XID_Start bits, then 4 words of XID_Continue bits")
+    out.append(f"inline constexpr uint64_t xid_blocks[{len(blocks)}][8] = {{")
+    for words in blocks:
+        out.append("    {" + ", ".join(f"0x{w:X}" for w in words[:4]) + ",")
+        out.append("     " + ", ".join(f"0x{w:X}" for w in words[4:]) + "},")
+    out.append("};")
+    out.append("")
+    out.append("} // namespace Dove")
+    print("\n".join(out), end="")
+
+
+if __name__ == "__main__":
+    main()